@@ -129,6 +129,28 @@
 // 20260515 Added support for Heltec WiFi LoRa 32(V4) and Heltec Wireless Stick Lite V3:
 //          custom SPI (FSPI) for WSL3, FEM control (GPIO7/GPIO2) for V4,
 //          DIO2-as-RF-switch and TCXO (1.8V) for both boards
+// 20261016 Added wake cycle timing trace
+//          Added energy accounting
+//          Added alignment of wake-up time to sensor transmit schedule
+//          Replaced truncation of sensor data uplink by appLayer.fitPayload()
+//          Added fragmentation of sensor data uplink (PAYLOAD_FRAGMENTATION)
+//          Added batched multi-sample uplinks (SAMPLE_BATCH)
+//          Added store-and-forward queue for failed uplinks (PAYLOAD_QUEUE)
+//          Added coalescing of response and status uplinks (UPLINK_COALESCE)
+//          Added deep sleep between uplinks of a wake cycle (UPLINK_DEEP_SLEEP)
+//          Replaced Preferences access to nonces by SessionStore, added flash copy of session
+//          Added join backoff and join history (JoinBackoff)
+//          Pass DeviceTime fraction to setTime()
+//          Wake trace and energy account are committed in sysCtx.gotoSleep() (all sleep paths),
+//          added charge of join requests
+//          Request keyframe after lost sensor data uplink also without PAYLOAD_QUEUE
+//          Moved radio initialization to radioBegin(), put radio to sleep if no batch uplink is due
+//          Resumed uplink is accounted for as part of the interrupted wake cycle
+//          Session flash copy is updated after each uplink based on the frame counter
+//          No GPS light sleep while BLE scan task is running
+//          Join history is sent in the first uplink after a new join
+//          Session restored with sessionStore.restoreSession(), DevNonce advanced after power loss
+//          Uplink payload buffer sized for MAX_SENSOR_PAYLOAD_SIZE
 //
 // ToDo:
 // -
@@ -146,10 +168,11 @@
 // - If joining the network or transmitting uplink data fails,
 //   the controller will go into deep sleep
 // - For LoRaWAN Specification 1.1.0, a small set of data (the "nonces") have to be stored persistently -
-//   this implementation uses Flash (via Preferences library)
+//   this implementation uses Flash (via Preferences library, see SessionStore)
 // - Storing LoRaWAN network session information speeds up the connection (join) after a restart -
 //   this implementation uses the ESP32's RTC RAM or a variable located in the RP2040's RAM, respectively.
 //   In the latter case, an uninitialized linker section is used for this purpose.
+//   Additionally, a copy of the session is written to Flash from time to time (see SessionStore).
 // - The ESP32's Bluetooth LE interface is used to access sensor data (option)
 // - settimeofday()/gettimeofday() must be used to access the ESP32's RTC time
 // - Arduino ESP32 package has built-in time zone handling, see
@@ -165,10 +188,6 @@
 // LoRa_Serialization
 #include <LoraMessage.h>
 
-// ESP32/RP2040 Preferences
-#include <Preferences.h>
-static Preferences store;
-
 // Logging macros for RP2040
 #include "src/logging.h"
 
@@ -187,6 +206,19 @@ static Preferences store;
 #include "src/LoadSecrets.h"
 #include "src/AppLayer.h"
 #include "src/SystemContext.h"
+#include "src/WakeTrace.h"
+#include "src/EnergyAccount.h"
+#if defined(PAYLOAD_FRAGMENTATION)
+#include "src/PayloadFragmenter.h"
+#endif
+#if defined(SAMPLE_BATCH)
+#include "src/SampleBatch.h"
+#endif
+#if defined(PAYLOAD_QUEUE)
+#include "src/PayloadQueue.h"
+#endif
+#include "src/SessionStore.h"
+#include "src/JoinBackoff.h"
 
 #if defined(RADIO_CHIP)
 // Use radio object from WeatherSensorReceiver namespace
@@ -260,6 +292,41 @@ SystemContext sysCtx;
 /// Application layer
 AppLayer appLayer(&sysCtx);
 
+/// Wake cycle timing trace
+WakeTrace wakeTrace;
+
+/// Energy accounting
+EnergyAccount energyAccount;
+
+/// LoRaWAN nonces and session persistence
+SessionStore sessionStore;
+
+/// Join backoff and join history
+JoinBackoff joinBackoff;
+
+#if defined(PAYLOAD_FRAGMENTATION)
+/// Sensor data uplink fragmentation
+PayloadFragmenter payloadFragmenter;
+#endif
+
+#if defined(SAMPLE_BATCH)
+/// Batched multi-sample uplinks
+SampleBatch sampleBatch;
+#endif
+
+#if defined(PAYLOAD_QUEUE)
+/// Store-and-forward queue for failed uplinks
+PayloadQueue payloadQueue;
+
+/// Sensor data of current wake cycle - queued if join fails
+static struct
+{
+  uint8_t port;           //!< LoRaWAN port
+  uint8_t size;           //!< payload size in bytes
+  const uint8_t *payload; //!< payload
+} unsentUplink = {0, 0, nullptr};
+#endif
+
 // LoRaWAN specific variables which must retain their values after deep sleep
 #if defined(ESP32)
 // Stored in RTC RAM
@@ -278,6 +345,144 @@ bool appStatusUplinkPending __attribute__((section(".uninitialized_data")));
 bool lwStatusUplinkPending __attribute__((section(".uninitialized_data")));
 #endif
 
+#if defined(UPLINK_DEEP_SLEEP)
+/// Marker for valid uplink to be resumed after deep sleep
+#define UPLINK_RESUME_MAGIC 0x52534D55UL
+
+/// Uplink to be sent after deep sleep between uplinks of a wake cycle
+struct sUplinkResume
+{
+  uint32_t magic;                   //!< UPLINK_RESUME_MAGIC if valid
+  uint8_t port;                     //!< LoRaWAN port
+  uint8_t size;                     //!< payload size in bytes
+  uint8_t payload[MAX_UPLINK_SIZE]; //!< payload
+};
+
+#if defined(ESP32)
+RTC_DATA_ATTR struct sUplinkResume uplinkResume = {0}; //!< uplink to be resumed
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sUplinkResume uplinkResume __attribute__((section(".uninitialized_data"))); //!< uplink to be resumed
+#endif
+#endif
+
+/*!
+ * \brief Reset and initialize radio transceiver
+ *
+ * Includes board specific configuration (SPI, FEM, RF switch, TCXO).
+ *
+ * \return RADIOLIB_ERR_NONE if successful, otherwise RadioLib error code of radio.begin()
+ */
+static int16_t radioBegin(void)
+{
+#if !defined(RADIO_CHIP)
+#if defined(ARDUINO_LILYGO_T3S3_SX1262) || defined(ARDUINO_LILYGO_T3S3_SX1276) || defined(ARDUINO_LILYGO_T3S3_LR1121) || \
+    defined(HELTEC_WIRELESS_STICK_LITE_V3)
+  // Use local radio object with custom SPI configuration
+  spi.begin(LORA_SCK, LORA_MISO, LORA_MOSI, LORA_CS);
+#endif
+#endif
+
+#if defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
+  femEnable();
+#endif
+
+  radio.reset();
+
+  log_v("Initialise radio");
+  int16_t state = radio.begin();
+  if (state != RADIOLIB_ERR_NONE)
+  {
+    return state;
+  }
+
+// Using local radio object
+#if defined(ARDUINO_LILYGO_T3S3_LR1121)
+  radio.setRfSwitchTable(rfswitch_dio_pins, rfswitch_table);
+
+  // LR1121 TCXO Voltage 2.85~3.15V
+  radio.setTCXO(3.0);
+#endif
+
+#if defined(ARDUINO_XIAO_ESP32S3)
+  // set RF switch control configuration
+  radio.setRfSwitchPins(38, RADIOLIB_NC);
+
+  // TCXO Voltage according to
+  // https://files.seeedstudio.com/products/SenseCAP/Wio_SX1262/Wio-SX1262_Module_Datasheet.pdf
+  // 1.7~3.3V
+  //
+  // Set to 1.7V as recommended by Seeed Studio's Support
+  radio.setTCXO(1.7);
+#endif
+
+#if defined(HELTEC_WIRELESS_STICK_LITE_V3) || defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
+  // RF switch is controlled internally by SX1262 DIO2
+  // (SX126X_DIO2_AS_RF_SWITCH in Meshtastic heltec_wsl_v3/variant.h and heltec_v4/variant.h)
+  radio.setDio2AsRfSwitch(true);
+
+  // TCXO voltage according to
+  // https://github.com/meshtastic/firmware/blob/master/variants/esp32s3/heltec_wsl_v3/variant.h
+  radio.setTCXO(1.8);
+#endif
+
+  return RADIOLIB_ERR_NONE;
+}
+
+/*!
+ * \brief Wait until the next uplink of the current wake cycle can be sent
+ *
+ * With UPLINK_DEEP_SLEEP, if this is the last uplink of the wake cycle
+ * (except backfill uplinks) and the delay is at least UPLINK_DEEP_SLEEP_MIN
+ * seconds, the uplink and the LoRaWAN session are saved to memory which is
+ * retained during deep sleep and the MCU enters deep sleep. The uplink is
+ * sent after wake-up without sensor data reception.
+ * Otherwise, the MCU waits using sysCtx.uplinkDelay().
+ *
+ * \param node    LoRaWAN node
+ * \param port    uplink port
+ * \param payload uplink payload
+ * \param size    uplink payload size in bytes
+ */
+static void waitForUplink(LoRaWANNode &node, uint8_t port, const uint8_t *payload, uint8_t size)
+{
+  wakeTrace.start(E_WAKE_STAGE::E_UPLINK_DELAY);
+#if defined(UPLINK_DEEP_SLEEP)
+  uint32_t delayMs = max(static_cast<uint32_t>(node.timeUntilUplink()), static_cast<uint32_t>(uplinkIntervalSeconds * 1000UL));
+  bool lastUplink = !cfgUplinkPending() && !lwStatusUplinkPending && !appStatusUplinkPending;
+#if defined(PAYLOAD_FRAGMENTATION)
+  lastUplink = lastUplink && !payloadFragmenter.pending();
+#endif
+  if (lastUplink && (delayMs >= UPLINK_DEEP_SLEEP_MIN * 1000UL) && (size <= MAX_UPLINK_SIZE))
+  {
+    log_d("Resuming uplink after deep sleep");
+    uplinkResume.magic = UPLINK_RESUME_MAGIC;
+    uplinkResume.port = port;
+    uplinkResume.size = size;
+    memcpy(uplinkResume.payload, payload, size);
+
+    uint8_t *persist = node.getBufferSession();
+    memcpy(LWsession, persist, RADIOLIB_LORAWAN_SESSION_BUF_SIZE);
+    sessionStore.saveSession(LWsession, node.getFCntUp());
+
+    uint32_t sleepSeconds = (delayMs + 999UL) / 1000UL;
+    wakeTrace.stop(E_WAKE_STAGE::E_UPLINK_DELAY);
+
+    // The wake cycle is continued after wake-up
+    wakeTrace.suspend();
+    energyAccount.suspend(sleepSeconds);
+
+    sysCtx.gotoSleep(sleepSeconds);
+  }
+#else
+  (void)port;
+  (void)payload;
+  (void)size;
+#endif
+  sysCtx.uplinkDelay(node.timeUntilUplink(), uplinkIntervalSeconds);
+  wakeTrace.stop(E_WAKE_STAGE::E_UPLINK_DELAY);
+}
+
 /*!
  * \brief Activate node by restoring session or otherwise joining the network
  *
@@ -297,19 +502,22 @@ int16_t lwActivate(LoRaWANNode &node)
   debug(state != RADIOLIB_ERR_NONE, "Initialise node failed", state, true);
 
   log_d("Recalling LoRaWAN nonces & session");
-  // ##### setup the flash storage
-  store.begin("radiolib");
+  uint8_t nonces[RADIOLIB_LORAWAN_NONCES_BUF_SIZE]; // create somewhere to store nonces
   // ##### if we have previously saved nonces, restore them and try to restore session as well
-  if (store.isKey("nonces"))
+  if (sessionStore.loadNonces(nonces))
   {
-    uint8_t buffer[RADIOLIB_LORAWAN_NONCES_BUF_SIZE];                   // create somewhere to store nonces
-    store.getBytes("nonces", buffer, RADIOLIB_LORAWAN_NONCES_BUF_SIZE); // get them from the store
-    state = node.setBufferNonces(buffer);                               // send them to LoRaWAN
+    state = node.setBufferNonces(nonces); // send them to LoRaWAN
     debug(state != RADIOLIB_ERR_NONE, "Restoring nonces buffer failed", state, false);
 
     // recall session from RTC deep-sleep preserved variable
     state = node.setBufferSession(LWsession); // send them to LoRaWAN stack
 
+    // if the session was lost (power-on/reset), try the copy in flash
+    if (state != RADIOLIB_ERR_NONE)
+    {
+      state = sessionStore.restoreSession(node);
+    }
+
     // if we have booted more than once we should have a session to restore, so report any failure
     // otherwise no point saying there's been a failure when it was bound to fail with an empty LWsession var.
     debug((state != RADIOLIB_ERR_NONE) && !sysCtx.isFirstBoot(), "Restoring session buffer failed", state, false);
@@ -322,36 +530,44 @@ int16_t lwActivate(LoRaWANNode &node)
       state = node.activateOTAA();
       debug((state != RADIOLIB_LORAWAN_SESSION_RESTORED), "Failed to activate restored session", state, true);
 
-      // ##### close the store before returning
-      store.end();
       return (state);
     }
   }
   else
-  { // store has no key "nonces"
+  { // no nonces saved
     log_d("No Nonces saved - starting fresh.");
   }
 
   // if we got here, there was no session to restore, so start trying to join
+  // (skip DevNonces which may have been used before a power loss)
+  sessionStore.restoreNonces(node);
   state = RADIOLIB_ERR_NETWORK_NOT_JOINED;
   while (state != RADIOLIB_LORAWAN_NEW_SESSION)
   {
     log_i("Join ('login') to the LoRaWAN Network");
-    state = node.activateOTAA();
+    state = node.activateOTAA(joinBackoff.dataRate());
+    joinBackoff.attempt(node.getLastToA(), state == RADIOLIB_LORAWAN_NEW_SESSION);
 
-    // ##### save the join counters (nonces) to permanent store
-    log_d("Saving nonces to flash");
-    uint8_t buffer[RADIOLIB_LORAWAN_NONCES_BUF_SIZE];                   // create somewhere to store nonces
-    uint8_t *persist = node.getBufferNonces();                          // get pointer to nonces
-    memcpy(buffer, persist, RADIOLIB_LORAWAN_NONCES_BUF_SIZE);          // copy in to buffer
-    store.putBytes("nonces", buffer, RADIOLIB_LORAWAN_NONCES_BUF_SIZE); // send them to the store
+    // join requests are sent with max. output power
+    energyAccount.addUplink(node.getLastToA(), Region.powerMax);
+
+    // ##### save the join counters (nonces) - written to flash if required
+    sessionStore.saveNonces(node.getBufferNonces(), state == RADIOLIB_LORAWAN_NEW_SESSION);
 
     // we'll save the session after an uplink
 
     if (state != RADIOLIB_LORAWAN_NEW_SESSION)
     {
       log_i("Join failed: %d", state);
-      sysCtx.sleepAfterFailedJoin();
+#if defined(PAYLOAD_QUEUE)
+      if (unsentUplink.size)
+      {
+        payloadQueue.push(unsentUplink.port, unsentUplink.payload, unsentUplink.size, time(nullptr));
+        unsentUplink.size = 0;
+      }
+#endif
+      wakeTrace.stop(E_WAKE_STAGE::E_ACTIVATE);
+      sysCtx.sleepAfterFailedJoin(joinBackoff.delay());
 
     } // if activateOTAA state
   } // while join
@@ -363,14 +579,16 @@ int16_t lwActivate(LoRaWANNode &node)
 
   delay(1000); // hold off off hitting the airwaves again too soon - an issue in the US
 
-  // ##### close the store
-  store.end();
   return (state);
 }
 
 // setup & execute all device functions ...
 void setup()
 {
+  wakeTrace.begin();
+  energyAccount.begin();
+  sysCtx.setAccounting(&wakeTrace, &energyAccount);
+
 #if defined(ARDUINO_M5STACK_CORE2)
   sysCtx.setupM5StackCore2();
 #endif
@@ -389,7 +607,9 @@ void setup()
 
   log_i("Setup");
 
+  wakeTrace.start(E_WAKE_STAGE::E_SYSCTX);
   sysCtx.begin();
+  wakeTrace.stop(E_WAKE_STAGE::E_SYSCTX);
 
   if (sysCtx.isFirstBoot())
   {
@@ -397,13 +617,30 @@ void setup()
     lwStatusUplinkPending = false;
   }
 
+#if defined(UPLINK_DEEP_SLEEP)
+  // Uplink saved before deep sleep between uplinks of the previous wake cycle
+  bool resumeUplink = !sysCtx.isFirstBoot() && (uplinkResume.magic == UPLINK_RESUME_MAGIC) &&
+                      (uplinkResume.size <= MAX_UPLINK_SIZE);
+  uplinkResume.magic = 0;
+  if (resumeUplink)
+  {
+    // Account for this wake-up as part of the interrupted wake cycle
+    wakeTrace.resume();
+    energyAccount.resume();
+  }
+#else
+  bool resumeUplink = false;
+#endif
+
 // Try to load LoRaWAN secrets from LittleFS file, if available
 #ifdef LORAWAN_VERSION_1_1
   bool requireNwkKey = true;
 #else
   bool requireNwkKey = false;
 #endif
+  wakeTrace.start(E_WAKE_STAGE::E_SECRETS);
   loadSecrets(requireNwkKey, joinEUI, devEUI, nwkKey, appKey);
+  wakeTrace.stop(E_WAKE_STAGE::E_SECRETS);
 
   sysCtx.getVoltages();
   sysCtx.sleepIfSupplyLow();
@@ -412,7 +649,7 @@ void setup()
   // Check if clock was never synchronized or sync interval has expired
   // and start GPS reception to get time from GPS if required.
   // Start GPS before initializing the application layer to save time, as GPS startup can be slow.
-  if (sysCtx.rtcNeedsSync())
+  if (!resumeUplink && sysCtx.rtcNeedsSync())
   {
     log_i("RTC sync required, starting GPS");
     sysCtx.gpsPower(true);
@@ -420,13 +657,25 @@ void setup()
 #endif
 
   // Initialize Application Layer - starts sensor reception
-  appLayer.begin();
+  // (not required if only the saved uplink has to be sent)
+  if (!resumeUplink)
+  {
+    wakeTrace.start(E_WAKE_STAGE::E_APPLAYER);
+    appLayer.begin();
+    wakeTrace.stop(E_WAKE_STAGE::E_APPLAYER);
+  }
 
 #if defined(GPS_EN)
-  if (sysCtx.rtcNeedsSync())
+  if (!resumeUplink && sysCtx.rtcNeedsSync())
   {
+    wakeTrace.start(E_WAKE_STAGE::E_GPS);
     time_t gpsTime;
+#if defined(BLE_SCAN_TASK)
+    // No light sleep while the BLE scan task is running on the other core
+    if (sysCtx.getGPSData(gpsTime, []() { return !appLayer.bleScanRunning(); }))
+#else
     if (sysCtx.getGPSData(gpsTime))
+#endif
     {
       sysCtx.setTime(gpsTime, E_TIME_SOURCE::E_GPS);
       log_d("RTC sync to GPS completed");
@@ -437,77 +686,93 @@ void setup()
       log_w("Failed to get GPS data");
     }
     sysCtx.gpsPower(false);
+    wakeTrace.stop(E_WAKE_STAGE::E_GPS);
   }
 #endif // GPS_EN
 
   // build payload byte array (+ reserve to prevent overflow with configuration at run-time)
-  uint8_t uplinkPayload[MAX_UPLINK_SIZE + 8];
+#if defined(SAMPLE_BATCH)
+  uint8_t uplinkPayload[max(MAX_SENSOR_PAYLOAD_SIZE + 8, SAMPLE_BATCH_MAX_UPLINK_SIZE)];
+#else
+  uint8_t uplinkPayload[MAX_SENSOR_PAYLOAD_SIZE + 8];
+#endif
 
   LoraEncoder encoder(uplinkPayload);
 
   uint8_t fPort = 1;
-  appLayer.getPayloadStage1(fPort, encoder);
-
-  int16_t state = 0; // return value for calls to RadioLib
-
-#if !defined(RADIO_CHIP)
-#if defined(ARDUINO_LILYGO_T3S3_SX1262) || defined(ARDUINO_LILYGO_T3S3_SX1276) || defined(ARDUINO_LILYGO_T3S3_LR1121) || \
-    defined(HELTEC_WIRELESS_STICK_LITE_V3)
-  // Use local radio object with custom SPI configuration
-  spi.begin(LORA_SCK, LORA_MISO, LORA_MOSI, LORA_CS);
-#endif
+#if defined(UPLINK_DEEP_SLEEP)
+  if (resumeUplink)
+  {
+    fPort = uplinkResume.port;
+    for (uint8_t i = 0; i < uplinkResume.size; i++)
+    {
+      encoder.writeUint8(uplinkResume.payload[i]);
+    }
+  }
+  else
 #endif
+  {
+    wakeTrace.start(E_WAKE_STAGE::E_PAYLOAD);
+    appLayer.getPayloadStage1(fPort, encoder);
+    wakeTrace.stop(E_WAKE_STAGE::E_PAYLOAD);
+  }
 
+#if defined(SAMPLE_BATCH)
+  // Store sensor data; skip LoRaWAN activation until a batch uplink is due
+  bool batchUplinkDue = (fPort != 1) || sampleBatch.add(uplinkPayload, encoder.getLength(), time(nullptr));
+  if (!batchUplinkDue && !sysCtx.rtcNeedsSync())
+  {
+    // No LoRaWAN transaction in this cycle - the transceiver would otherwise
+    // remain in receive mode (868 MHz sensor data reception) during sleep
+    wakeTrace.start(E_WAKE_STAGE::E_RADIO);
+    int16_t state = radioBegin();
+    if (state == RADIOLIB_ERR_NONE)
+    {
+      state = radio.sleep();
+    }
+    debug(state != RADIOLIB_ERR_NONE, "Radio sleep failed", state, false);
 #if defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
-  femEnable();
+    femDisable();
 #endif
+    wakeTrace.stop(E_WAKE_STAGE::E_RADIO);
 
-  radio.reset();
-  LoRaWANNode node(&radio, &Region, subBand);
-
-  // setup the radio based on the pinmap (connections) in config.h
-  log_v("Initialise radio");
-
-  state = radio.begin();
-  debug(state != RADIOLIB_ERR_NONE, "Initialise radio failed", state, true);
-
-// Using local radio object
-#if defined(ARDUINO_LILYGO_T3S3_LR1121)
-  radio.setRfSwitchTable(rfswitch_dio_pins, rfswitch_table);
+    uint32_t sleepSeconds = sysCtx.sleepDuration(&appLayer.sensorSchedule);
 
-  // LR1121 TCXO Voltage 2.85~3.15V
-  radio.setTCXO(3.0);
+    sysCtx.gotoSleep(sleepSeconds);
+  }
 #endif
 
-#if defined(ARDUINO_XIAO_ESP32S3)
-  // set RF switch control configuration
-  radio.setRfSwitchPins(38, RADIOLIB_NC);
+  int16_t state = 0; // return value for calls to RadioLib
 
-  // TCXO Voltage according to
-  // https://files.seeedstudio.com/products/SenseCAP/Wio_SX1262/Wio-SX1262_Module_Datasheet.pdf
-  // 1.7~3.3V
-  //
-  // Set to 1.7V as recommended by Seeed Studio's Support
-  radio.setTCXO(1.7);
-#endif
+  wakeTrace.start(E_WAKE_STAGE::E_RADIO);
 
-#if defined(HELTEC_WIRELESS_STICK_LITE_V3) || defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
-  // RF switch is controlled internally by SX1262 DIO2
-  // (SX126X_DIO2_AS_RF_SWITCH in Meshtastic heltec_wsl_v3/variant.h and heltec_v4/variant.h)
-  radio.setDio2AsRfSwitch(true);
+  // setup the radio based on the pinmap (connections) in config.h
+  state = radioBegin();
+  debug(state != RADIOLIB_ERR_NONE, "Initialise radio failed", state, true);
 
-  // TCXO voltage according to
-  // https://github.com/meshtastic/firmware/blob/master/variants/esp32s3/heltec_wsl_v3/variant.h
-  radio.setTCXO(1.8);
-#endif
+  LoRaWANNode node(&radio, &Region, subBand);
 
 #if defined(ESP32)
   // Optionally provide a custom sleep function - see config.h
   node.setSleepFunction(customDelay);
 #endif
+  wakeTrace.stop(E_WAKE_STAGE::E_RADIO);
+
+#if defined(PAYLOAD_QUEUE) && !defined(SAMPLE_BATCH)
+  // Sensor data is queued if join fails
+  // (with SAMPLE_BATCH, the records are still available in the sample buffer)
+  if (!resumeUplink)
+  {
+    unsentUplink.port = fPort;
+    unsentUplink.size = encoder.getLength();
+    unsentUplink.payload = uplinkPayload;
+  }
+#endif
 
   // activate node by restoring session or otherwise joining the network
+  wakeTrace.start(E_WAKE_STAGE::E_ACTIVATE);
   state = lwActivate(node);
+  wakeTrace.stop(E_WAKE_STAGE::E_ACTIVATE);
   // state is one of RADIOLIB_LORAWAN_NEW_SESSION or RADIOLIB_LORAWAN_SESSION_RESTORED
 
   uint8_t battLevel = sysCtx.getBattlevel();
@@ -529,16 +794,30 @@ void setup()
 
   uint8_t downlinkPayload[MAX_DOWNLINK_SIZE]; // Make sure this fits your plans!
   size_t downlinkSize;                        // To hold the actual payload size rec'd
+  LoRaWANEvent_t uplinkDetails;
   LoRaWANEvent_t downlinkDetails;
 
   uint8_t uplinkSize = encoder.getLength();
   uint8_t maxPayloadLen = node.getMaxPayloadLen();
   log_d("Max payload length: %u", maxPayloadLen);
-  if (uplinkSize > maxPayloadLen)
+#if defined(SAMPLE_BATCH)
+  // Replace sensor data by stored records
+  if (fPort == 1)
+  {
+    uplinkSize = sampleBatch.encode(uplinkPayload, maxPayloadLen, fPort);
+  }
+#endif
+  uplinkSize = appLayer.fitPayload(fPort, uplinkPayload, uplinkSize, maxPayloadLen);
+
+#if defined(PAYLOAD_FRAGMENTATION)
+  if (!resumeUplink && (fPort == 1) && (uplinkSize > maxPayloadLen))
   {
-    log_w("Payload size exceeds maximum of %u bytes - truncating", maxPayloadLen);
-    uplinkSize = maxPayloadLen;
+    // Send first fragment now, remaining fragments in E_FRAGMENT stage
+    payloadFragmenter.begin(uplinkPayload, uplinkSize);
+    fPort = PAYLOAD_FRAGMENT_PORT;
+    uplinkSize = payloadFragmenter.next(uplinkPayload, maxPayloadLen);
   }
+#endif
 
   // ----- and now for the main event -----
 
@@ -548,13 +827,31 @@ void setup()
     E_RESPONSE = 0x01,
     E_LWSTATUS = 0x02,
     E_APPSTATUS = 0x03,
-    E_DONE = 0x04
+    E_DONE = 0x04,
+    E_FRAGMENT = 0x05,
+    E_BACKFILL = 0x06,
+    E_RESUMED = 0x07,
+    E_JOINHISTORY = 0x08
   };
 
-  E_FSM_STAGE fsmStage = E_FSM_STAGE::E_SENSORDATA;
+  // Send saved uplink or sensor data first;
+  // after a new join, the join history is sent in the first uplink, followed by the sensor data
+  E_FSM_STAGE fsmStage = resumeUplink ? E_FSM_STAGE::E_RESUMED : E_FSM_STAGE::E_SENSORDATA;
+  uint8_t sensorPort = fPort;
+  uint8_t joinHistoryPayload[MAX_UPLINK_SIZE];
+  uint8_t joinHistorySize = 0;
+  if (!resumeUplink && joinBackoff.reportPending())
+  {
+    fsmStage = E_FSM_STAGE::E_JOINHISTORY;
+  }
 
-  /// Uplink request - command received via downlink
-  uint8_t uplinkReq = 0;
+#if defined(PAYLOAD_QUEUE)
+  /// Number of backfill uplinks sent in this cycle
+  uint8_t backfillCnt = 0;
+
+  /// Sensor data uplink failed in this cycle
+  bool uplinkFailed = false;
+#endif
 
   do
   {
@@ -588,44 +885,159 @@ void setup()
       log_i("LoRaWAN node status uplink pending");
     }
 
+    if (fsmStage == E_FSM_STAGE::E_JOINHISTORY)
+    {
+      // Encoded separately - the sensor data in uplinkPayload is sent next
+      log_d("Sending join history uplink.");
+      fPort = CMD_GET_JOIN_HISTORY;
+      encodeCfgUplink(fPort, joinHistoryPayload, joinHistorySize);
+    }
+    else if ((fsmStage == E_FSM_STAGE::E_SENSORDATA) && (joinHistorySize > 0))
+    {
+      log_d("Sending sensor data uplink after join history.");
+      waitForUplink(node, fPort, uplinkPayload, uplinkSize);
+    }
+    else
+#if defined(PAYLOAD_QUEUE)
+    if (fsmStage == E_FSM_STAGE::E_BACKFILL)
+    {
+      log_d("Sending backfill uplink.");
+      fPort = PAYLOAD_QUEUE_PORT;
+      uint32_t timeUntilUplink = node.timeUntilUplink();
+      if (timeUntilUplink)
+      {
+        // Only wait as long as required by the duty cycle limit
+        wakeTrace.start(E_WAKE_STAGE::E_UPLINK_DELAY);
+        sysCtx.uplinkDelay(timeUntilUplink, 0);
+        wakeTrace.stop(E_WAKE_STAGE::E_UPLINK_DELAY);
+      }
+      backfillCnt++;
+    }
+    else
+#endif
+#if defined(PAYLOAD_FRAGMENTATION)
+    if (fsmStage == E_FSM_STAGE::E_FRAGMENT)
+    {
+      log_d("Sending sensor data fragment uplink.");
+      fPort = PAYLOAD_FRAGMENT_PORT;
+      uplinkSize = payloadFragmenter.next(uplinkPayload, node.getMaxPayloadLen());
+      waitForUplink(node, fPort, uplinkPayload, uplinkSize);
+    }
+    else
+#endif
     if (fsmStage == E_FSM_STAGE::E_RESPONSE)
     {
       log_d("Sending response uplink.");
-      fPort = uplinkReq;
-      encodeCfgUplink(fPort, uplinkPayload, uplinkSize);
-      sysCtx.uplinkDelay(node.timeUntilUplink(), uplinkIntervalSeconds);
+#if defined(UPLINK_COALESCE)
+      // Combine status messages due in this cycle with the response(s)
+      if (lwStatusUplinkPending)
+      {
+        addCfgResponse(CMD_GET_LW_STATUS);
+        lwStatusUplinkPending = false;
+      }
+      if (appStatusUplinkPending)
+      {
+        addCfgResponse(CMD_GET_SENSORS_STAT);
+        appStatusUplinkPending = false;
+      }
+#endif
+      uint8_t maxSize = node.getMaxPayloadLen();
+      fPort = nextCfgUplink(maxSize);
+      encodeCfgUplink(fPort, uplinkPayload, uplinkSize, maxSize);
+      waitForUplink(node, fPort, uplinkPayload, uplinkSize);
     }
     else if (fsmStage == E_FSM_STAGE::E_LWSTATUS)
     {
       log_d("Sending LoRaWAN status uplink.");
       fPort = CMD_GET_LW_STATUS;
       encodeCfgUplink(fPort, uplinkPayload, uplinkSize);
-      sysCtx.uplinkDelay(node.timeUntilUplink(), uplinkIntervalSeconds);
       lwStatusUplinkPending = false;
+      waitForUplink(node, fPort, uplinkPayload, uplinkSize);
     }
     else if (fsmStage == E_FSM_STAGE::E_APPSTATUS)
     {
       log_d("Sending application status uplink.");
       fPort = CMD_GET_SENSORS_STAT;
       encodeCfgUplink(fPort, uplinkPayload, uplinkSize);
-      sysCtx.uplinkDelay(node.timeUntilUplink(), uplinkIntervalSeconds);
       appStatusUplinkPending = false;
+      waitForUplink(node, fPort, uplinkPayload, uplinkSize);
     }
 
-    log_i("Sending uplink; port %u, size %u", fPort, uplinkSize);
+    const uint8_t *txPayload = (fsmStage == E_FSM_STAGE::E_JOINHISTORY) ? joinHistoryPayload : uplinkPayload;
+    uint8_t txSize = (fsmStage == E_FSM_STAGE::E_JOINHISTORY) ? joinHistorySize : uplinkSize;
+    log_i("Sending uplink; port %u, size %u", fPort, txSize);
 
+    wakeTrace.start(E_WAKE_STAGE::E_UPLINK);
     state = node.sendReceive(
-        uplinkPayload,
-        uplinkSize,
+        txPayload,
+        txSize,
         fPort,
         downlinkPayload,
         &downlinkSize,
         isConfirmed,
-        nullptr,
+        &uplinkDetails,
         &downlinkDetails);
+    wakeTrace.stop(E_WAKE_STAGE::E_UPLINK);
+    energyAccount.addUplink(node.getLastToA(), uplinkDetails.power);
     debug(state < RADIOLIB_ERR_NONE, "Error in sendReceive", state, false);
 
-    uplinkReq = 0;
+    // Keep the session copy in flash within LW_SESSION_WRITE_INTERVAL frame counts
+    // (written to flash only if required)
+    sessionStore.saveSession(node.getBufferSession(), node.getFCntUp());
+
+#if defined(SAMPLE_BATCH)
+    if ((fsmStage == E_FSM_STAGE::E_SENSORDATA) && (state >= RADIOLIB_ERR_NONE))
+    {
+      // Records have been sent - remove them from the sample buffer
+      sampleBatch.commit();
+    }
+#endif
+
+#if defined(PAYLOAD_QUEUE) || defined(PAYLOAD_DELTA)
+    // Uplink failed or confirmed uplink was not acknowledged
+    bool uplinkLost = (state < RADIOLIB_ERR_NONE) || (isConfirmed && (state == RADIOLIB_ERR_NONE));
+#endif
+
+#if defined(PAYLOAD_DELTA)
+    if (uplinkLost && ((fsmStage == E_FSM_STAGE::E_SENSORDATA) || (fsmStage == E_FSM_STAGE::E_FRAGMENT)))
+    {
+      // Following delta frames must not refer to a keyframe which may be lost
+      appLayer.requestKeyframe();
+    }
+#endif
+
+#if defined(PAYLOAD_QUEUE)
+    if (fsmStage == E_FSM_STAGE::E_BACKFILL)
+    {
+      if (uplinkLost)
+      {
+        // Try again in next cycle
+        uplinkFailed = true;
+      }
+      else
+      {
+        payloadQueue.pop();
+      }
+    }
+    else if (uplinkLost && (fsmStage == E_FSM_STAGE::E_SENSORDATA))
+    {
+      uplinkFailed = true;
+      if (fPort == PAYLOAD_FRAGMENT_PORT)
+      {
+        // A single fragment cannot be restored by the decoder
+        log_w("Sensor data fragment lost");
+      }
+      else
+      {
+#if defined(SAMPLE_BATCH)
+        // Records are still available in the sample buffer and are sent with the next batch uplink
+        log_d("Sample batch uplink failed");
+#else
+        payloadQueue.push(fPort, uplinkPayload, uplinkSize, time(nullptr));
+#endif
+      }
+    }
+#endif
 
     // Check if downlink was received
     // (state 0 = no downlink, state 1/2 = downlink in window Rx1/Rx2)
@@ -639,7 +1051,8 @@ void setup()
 
         if (downlinkDetails.fPort > 0)
         {
-          uplinkReq = decodeDownlink(downlinkDetails.fPort, downlinkPayload, downlinkSize);
+          // Response (if requested) is sent in the next uplink
+          addCfgResponse(decodeDownlink(downlinkDetails.fPort, downlinkPayload, downlinkSize));
         }
       }
       else
@@ -665,20 +1078,18 @@ void setup()
       log_d("[LoRaWAN] Output power:\t%d dBm", downlinkDetails.power);
       log_d("[LoRaWAN] Frame count:\t%u", downlinkDetails.fCnt);
       log_d("[LoRaWAN] fPort:\t\t%u", downlinkDetails.fPort);
-      log_d("[LoRaWAN] Time-on-air: \t%u ms", node.getLastToA());
+      log_d("[LoRaWAN] Time-on-air: \t%lu ms", node.getLastToA());
       log_d("[LoRaWAN] Rx window: %d", state);
     }
 
     uint32_t networkTime = 0;
     uint16_t milliseconds = 0;
-    if (node.getMacDeviceTimeAns(&networkTime, &milliseconds, true) == RADIOLIB_ERR_NONE)
-      uint16_t milliseconds = 0;
     if (node.getMacDeviceTimeAns(&networkTime, &milliseconds, true) == RADIOLIB_ERR_NONE)
     {
-      log_i("[LoRaWAN] DeviceTime Unix:\t %ld", networkTime);
+      log_i("[LoRaWAN] DeviceTime Unix:\t %lu", static_cast<unsigned long>(networkTime));
       log_i("[LoRaWAN] DeviceTime frac:\t%u ms", milliseconds);
 
-      sysCtx.setTime(networkTime, E_TIME_SOURCE::E_LORA);
+      sysCtx.setTime(networkTime, E_TIME_SOURCE::E_LORA, milliseconds);
       log_d("RTC sync to LoRaWAN completed");
       sysCtx.printDateTime();
     }
@@ -691,10 +1102,38 @@ void setup()
       log_d("[LoRaWAN] LinkCheck count:\t%u", gwCnt);
     }
 
-    if (uplinkReq)
+#if defined(PAYLOAD_QUEUE)
+    // Oldest queued uplink which fits at the current data rate (backfill frame)
+    uint8_t backfillSize = 0;
+    if (!uplinkFailed && (backfillCnt < PAYLOAD_QUEUE_DRAIN_MAX) && payloadQueue.pending() &&
+        (node.timeUntilUplink() <= PAYLOAD_QUEUE_MAX_WAIT * 1000UL))
+    {
+      backfillSize = payloadQueue.peek(uplinkPayload, node.getMaxPayloadLen());
+    }
+#endif
+
+    if (fsmStage == E_FSM_STAGE::E_JOINHISTORY)
+    {
+      fPort = sensorPort;
+      fsmStage = E_FSM_STAGE::E_SENSORDATA;
+    }
+    else if (cfgUplinkPending())
+    {
+      fsmStage = E_FSM_STAGE::E_RESPONSE;
+    }
+#if defined(PAYLOAD_FRAGMENTATION)
+    else if (payloadFragmenter.pending())
+    {
+      fsmStage = E_FSM_STAGE::E_FRAGMENT;
+    }
+#endif
+#if defined(UPLINK_COALESCE)
+    else if (lwStatusUplinkPending || appStatusUplinkPending)
     {
+      // Status messages are combined in one uplink
       fsmStage = E_FSM_STAGE::E_RESPONSE;
     }
+#else
     else if (lwStatusUplinkPending)
     {
       fsmStage = E_FSM_STAGE::E_LWSTATUS;
@@ -703,18 +1142,29 @@ void setup()
     {
       fsmStage = E_FSM_STAGE::E_APPSTATUS;
     }
+#endif
+#if defined(PAYLOAD_QUEUE)
+    else if (backfillSize > 0)
+    {
+      uplinkSize = backfillSize;
+      fsmStage = E_FSM_STAGE::E_BACKFILL;
+    }
+#endif
     else
     {
       fsmStage = E_FSM_STAGE::E_DONE;
     }
   } while (fsmStage != E_FSM_STAGE::E_DONE);
 
-  // now save session to RTC memory
+  // now save session to RTC memory (and to flash, if required)
   uint8_t *persist = node.getBufferSession();
   memcpy(LWsession, persist, RADIOLIB_LORAWAN_SESSION_BUF_SIZE);
+  sessionStore.saveSession(LWsession, node.getFCntUp());
 
   // wait until next uplink - observing legal & TTN Fair Use Policy constraints
-  sysCtx.gotoSleep(sysCtx.sleepDuration());
+  uint32_t sleepSeconds = sysCtx.sleepDuration(&appLayer.sensorSchedule);
+
+  sysCtx.gotoSleep(sleepSeconds);
 }
 
 // The MCU wakes from deep-sleep and starts from the very beginning.
@@ -81,6 +81,34 @@
 //          Added SERIAL2_LOG definitions
 // 20260515 Added ADC configuration for Heltec WiFi LoRa 32(V4) and Wireless Stick Lite V3:
 //          PIN_ADC_IN A0, ADC_CTRL GPIO37, ADC_CTRL_ENABLED polarity (LOW for V3/WSL3, HIGH for V4)
+// 20261016 Disabled BLE in host-native simulation build (HOST_SIM)
+//          Added WAKE_TRACE_CYCLES
+//          Added current model for energy accounting (CURRENT_*)
+//          Added sensor transmit-phase scheduling (SENSOR_SCHEDULE_*)
+//          Added uplink payload planner priorities (PAYLOAD_PRIO_*)
+//          Added PAYLOAD_FRAGMENTATION
+//          Added PAYLOAD_DELTA
+//          Added SAMPLE_BATCH
+//          Added PAYLOAD_QUEUE
+//          Added UPLINK_COALESCE
+//          Added UPLINK_DEEP_SLEEP
+//          Added LW_NONCES_WRITE_INTERVAL and LW_SESSION_WRITE_INTERVAL
+//          Added JOIN_BACKOFF_MIN/MAX and JOIN_DR_RAMP
+//          Added RTC drift estimation (RTC_DRIFT_ESTIMATION)
+//          Added GPS_LIGHT_SLEEP, GPS_NMEA_PERIOD_MS, GPS_WAKE_MARGIN_MS,
+//          GPS_RX_BUFFER_SIZE and GPS_BACKUP_PIN/GPS_BACKUP_ACTIVE
+//          Added BLE_SCAN_TASK
+//          Added A02YYUW_WARMUP_MS, A02YYUW_SAMPLES and A02YYUW_TOLERANCE
+//          Added DYP_R01CW_I2C_CLOCK and DYP_R01CW_RANGING_MS
+//          Added LW_SESSION_FCNT_RESERVE
+//          Disabled PAYLOAD_FRAGMENTATION by default
+//          Disabled PAYLOAD_QUEUE by default
+//          Disabled UPLINK_COALESCE by default
+//          Disabled UPLINK_DEEP_SLEEP by default
+//          Disabled GPS_LIGHT_SLEEP by default
+//          Disabled BLE_SCAN_TASK by default
+//          Added MAX_SENSOR_PAYLOAD_SIZE
+//          Added LW_NONCES_DEVNONCE_RESERVE
 //
 // ToDo:
 // -
@@ -183,6 +211,19 @@ const uint8_t MAX_DOWNLINK_SIZE = 51;
 // RTC to network time sync interval (in minutes)
 #define CLOCK_SYNC_INTERVAL 24 * 60
 
+// RTC drift estimation (see RtcDrift)
+// If enabled, the drift of the RTC is estimated from the offsets observed at
+// clock synchronizations (GPS or LoRaWAN network time, at least RTC_DRIFT_MIN_INTERVAL
+// minutes apart) and the RTC / sleep duration is corrected accordingly.
+// Once the uncertainty of the estimate is known, the RTC is only synchronized if the
+// predicted clock error exceeds RTC_SYNC_MAX_ERROR seconds (assuming an uncertainty of
+// at least RTC_DRIFT_MIN_PPM) or after CLOCK_SYNC_INTERVAL_MAX minutes.
+#define RTC_DRIFT_ESTIMATION
+#define RTC_DRIFT_MIN_INTERVAL 6 * 60
+#define RTC_DRIFT_MIN_PPM 10
+#define RTC_SYNC_MAX_ERROR 10
+#define CLOCK_SYNC_INTERVAL_MAX 7 * 24 * 60
+
 // LoRaWAN Node status message interval (in frames)
 #define LW_STATUS_INTERVAL 60
 
@@ -192,6 +233,37 @@ const uint8_t MAX_DOWNLINK_SIZE = 51;
 // Timeout for weather sensor data reception (seconds)
 #define WEATHERSENSOR_TIMEOUT 180
 
+// Number of wake cycles kept in the timing trace (retained memory)
+#define WAKE_TRACE_CYCLES 8
+
+// Current model for energy accounting (see src/EnergyAccount.h) [µA]
+// Typical values; should be adjusted to measurements of the actual hardware
+#if defined(ARDUINO_ARCH_RP2040)
+#define CURRENT_CPU_ACTIVE_UA 25000
+#define CURRENT_LIGHT_SLEEP_UA 25000 // no light sleep; delay() keeps CPU running
+#define CURRENT_DEEP_SLEEP_UA 1500
+#else
+#define CURRENT_CPU_ACTIVE_UA 45000
+#define CURRENT_LIGHT_SLEEP_UA 1000
+#define CURRENT_DEEP_SLEEP_UA 150
+#endif
+#define CURRENT_RADIO_RX_UA 11000       // 868 MHz sensor data reception
+#define CURRENT_BLE_SCAN_UA 30000       // BLE sensor scan (ESP32 only)
+#define CURRENT_GPS_UA 25000            // GPS receiver
+#define CURRENT_LORA_TX_0DBM_UA 20000   // LoRaWAN transmission at 0 dBm
+#define CURRENT_LORA_TX_PER_DBM_UA 5000 // LoRaWAN transmission, increase per dBm
+
+// Sensor transmit-phase scheduling (see src/SensorSchedule.h)
+// Max. number of scheduled sensors (sensor type/channel)
+#define SENSOR_SCHEDULE_SLOTS 8
+// Guard interval around expected transmission (ms)
+#define SENSOR_SCHEDULE_GUARD_MS 2000
+// Time from wake-up until start of reception (ms)
+#define SENSOR_SCHEDULE_STARTUP_MS 1500
+// Range of plausible transmit periods (ms)
+#define SENSOR_SCHEDULE_PERIOD_MIN_MS 4000
+#define SENSOR_SCHEDULE_PERIOD_MAX_MS 300000
+
 // If enabled, enter deep sleep mode if receiving weather sensor data was not successful
 // #define WEATHERSENSOR_DATA_REQUIRED
 
@@ -218,7 +290,7 @@ const uint8_t MAX_DOWNLINK_SIZE = 51;
 // Notes:
 // * BLE requires a lot of program memory!
 // * ESP32-S2 does not provide BLE!
-#if !defined(ARDUINO_ADAFRUIT_FEATHER_ESP32S2) && !defined(ARDUINO_ARCH_RP2040)
+#if !defined(ARDUINO_ADAFRUIT_FEATHER_ESP32S2) && !defined(ARDUINO_ARCH_RP2040) && !defined(HOST_SIM)
 // #define MITHERMOMETER_EN
 #define THEENGSDECODER_EN
 #endif
@@ -382,6 +454,14 @@ const uint8_t ADC3_SAMPLES = 10;
 #define A02YYUW_PWR 4
 #define A02YYUW_RETRIES 5
 #endif
+// Warm-up time after power-on in ms
+// The sensor is powered on at the start of the wake cycle, i.e. it warms up
+// during the 868 MHz sensor data reception
+#define A02YYUW_WARMUP_MS 500
+// Number of consecutive readings which must agree - the median is used
+#define A02YYUW_SAMPLES 3
+// Max. spread of agreeing readings in mm
+#define A02YYUW_TOLERANCE 10
 #endif
 
 #ifdef DYP_R01CW_EN
@@ -409,6 +489,14 @@ const uint8_t ADC3_SAMPLES = 10;
      {                       \
          0xE8                \
      }
+
+// I2C bus clock in Hz (100000: standard mode / 400000: fast mode)
+#define DYP_R01CW_I2C_CLOCK 100000
+
+// Ranging time in ms
+// All sensors are triggered at the start of the wake cycle and read after
+// (at least) one ranging time
+#define DYP_R01CW_RANGING_MS 100
 #endif
 
 #ifdef ADC_EN
@@ -449,6 +537,18 @@ const uint8_t UBATT_SAMPLES = 10;
 //#define GPS_BAUDRATE        9600 // M5Stack Unit GPS V1.0
 #define GPS_BAUDRATE      115200 // M5Stack Unit GPS V1.1
 
+// GPS NMEA data reception
+// The NMEA sentences are parsed at the end of each burst of sentences (UART receive timeout)
+// instead of busy polling the serial port. With GPS_LIGHT_SLEEP (ESP32), the MCU enters light
+// sleep between bursts (GPS_NMEA_PERIOD_MS: NMEA output interval) and wakes up
+// GPS_WAKE_MARGIN_MS before the start of the next burst (the start of a burst is derived
+// from its end and its transfer time at GPS_BAUDRATE). GPS_RX_BUFFER_SIZE must hold a
+// complete burst.
+//#define GPS_LIGHT_SLEEP
+#define GPS_NMEA_PERIOD_MS 1000
+#define GPS_WAKE_MARGIN_MS 100
+#define GPS_RX_BUFFER_SIZE 1024
+
 #if defined(LORAWAN_NODE)
 
 // GPS power enable pin (set to -1 if not used)
@@ -485,6 +585,14 @@ const uint8_t UBATT_SAMPLES = 10;
 
 #endif // Board-specific GPS configuration
 
+// GPS backup power pin (V_BCKP supply or backup switch; set to -1 if not used)
+// If available, the GPS backup power is kept on between clock synchronizations (also during
+// deep sleep). The GPS receiver retains time, almanac and ephemeris data, so subsequent
+// fixes (hot/warm start) take only seconds instead of a cold start.
+#define GPS_BACKUP_PIN      -1
+// GPS backup power polarity: 1 = active high, 0 = active low
+#define GPS_BACKUP_ACTIVE   1
+
 #endif // GPS_EN
 
 #if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
@@ -493,6 +601,14 @@ const uint8_t UBATT_SAMPLES = 10;
 // BLE scan mode (0: passive / 1: active)
 #define BLE_SCAN_MODE 1
 
+// Run the BLE scan in a separate task concurrently with the 868 MHz sensor data reception
+// (ESP32 with Theengs Decoder only; BLE uses a separate radio)
+// The wake time is reduced to the longer of both instead of their sum.
+//#define BLE_SCAN_TASK
+#if defined(BLE_SCAN_TASK) && (!defined(ESP32) || !defined(THEENGSDECODER_EN))
+#undef BLE_SCAN_TASK
+#endif
+
 // BLE battery o.k. threshold in percent
 #define BLE_BATT_OK 5
 
@@ -648,6 +764,116 @@ const uint8_t UBATT_SAMPLES = 10;
 #define APP_PAYLOAD_OFFS_BLE 24
 #define APP_PAYLOAD_BYTES_BLE 2
 
+// Uplink payload planner
+// If the sensor data exceeds the maximum payload size of the current data rate,
+// whole sensors are dropped - starting with the group of lowest priority
+// (highest number) and, within a group, with the last sensor in the payload.
+#define PAYLOAD_PRIO_WEATHER 0   // Bresser weather sensor
+#define PAYLOAD_PRIO_BRESSER 2   // Other Bresser sensors (with channel selection)
+#define PAYLOAD_PRIO_LIGHTNING 3 // Bresser lightning sensor
+#define PAYLOAD_PRIO_ONEWIRE 1   // 1-Wire temperature sensors
+#define PAYLOAD_PRIO_ANALOG 1    // Analog channels (voltages)
+#define PAYLOAD_PRIO_DIGITAL 2   // Digital sensors (distance sensors)
+#define PAYLOAD_PRIO_BLE 4       // BLE temperature/humidity sensor
+#define PAYLOAD_PRIO_STATUS 5    // Battery status flags (appPayloadCfg[0] bit 0)
+
+// Uplink payload fragmentation
+// If enabled, sensor data exceeding the maximum payload size of the current data rate
+// is split into fragments which are sent in consecutive uplinks on PAYLOAD_FRAGMENT_PORT
+// instead of dropping sensors (see above).
+// The fragments are reassembled by the uplink formatter.
+//#define PAYLOAD_FRAGMENTATION
+#define PAYLOAD_FRAGMENT_PORT 2
+
+// Delta encoding of sensor data uplink
+// If enabled, the sensor data is sent as difference to the last keyframe
+// (complete sensor data uplink on port 1) on PAYLOAD_DELTA_PORT - if this is shorter.
+// A keyframe is sent every PAYLOAD_DELTA_KEYFRAME_INTERVAL frames, if the payload
+// layout has changed or if requested by CMD_RESET_PAYLOAD_DELTA.
+// Delta frames are decoded by the uplink formatter using the last keyframe.
+//#define PAYLOAD_DELTA
+#define PAYLOAD_DELTA_PORT 3
+#define PAYLOAD_DELTA_KEYFRAME_INTERVAL 10
+
+// Batched multi-sample uplinks
+// If enabled, the sensor data of each wake-up is stored as timestamped record in memory
+// which is retained during deep sleep. The LoRaWAN radio is only activated every
+// SAMPLE_BATCH_SIZE wake-ups, if the records reach the max. payload size or if the RTC
+// needs to be synchronized; then all records are sent in one uplink on SAMPLE_BATCH_PORT.
+// SLEEP_INTERVAL is the sampling interval in this mode.
+//#define SAMPLE_BATCH
+#define SAMPLE_BATCH_SIZE 5
+#define SAMPLE_BATCH_PORT 4
+#define SAMPLE_BATCH_MAX_UPLINK_SIZE 222
+
+// Max. sensor data payload size
+// With PAYLOAD_FRAGMENTATION, the payload is only limited by the fragmentation:
+// 8 fragments with MAX_UPLINK_SIZE - 1 bytes each (header byte), limited to 8-bit sizes.
+// Sample batch records are limited to MAX_UPLINK_SIZE.
+#if defined(PAYLOAD_FRAGMENTATION) && !defined(SAMPLE_BATCH)
+const uint8_t MAX_SENSOR_PAYLOAD_SIZE = (8 * (MAX_UPLINK_SIZE - 1) < UINT8_MAX) ? 8 * (MAX_UPLINK_SIZE - 1) : UINT8_MAX;
+#else
+const uint8_t MAX_SENSOR_PAYLOAD_SIZE = MAX_UPLINK_SIZE;
+#endif
+
+// Store-and-forward queue for sensor data uplinks
+// If enabled, sensor data which could not be sent (join failed, uplink failed or
+// confirmed uplink not acknowledged) is stored with timestamp and port in a file on LittleFS.
+// Queued uplinks are sent on PAYLOAD_QUEUE_PORT in later wake cycles (max.
+// PAYLOAD_QUEUE_DRAIN_MAX per cycle) after all other uplinks, if the duty cycle
+// limit allows an uplink within PAYLOAD_QUEUE_MAX_WAIT seconds.
+// If the queue is full, the oldest entry is overwritten.
+// A backfill frame is 5 bytes larger than the queued uplink; entries which do not
+// fit at the current data rate (e.g. > 46 bytes at EU868 DR0..2) are skipped.
+//#define PAYLOAD_QUEUE
+#define PAYLOAD_QUEUE_PORT 5
+#define PAYLOAD_QUEUE_SIZE 32
+#define PAYLOAD_QUEUE_DRAIN_MAX 2
+#define PAYLOAD_QUEUE_MAX_WAIT 60
+
+// Coalescing of response and status uplinks
+// If enabled, a response to a downlink command and the LoRaWAN node / application
+// status messages due in the same wake cycle are combined into one uplink on port
+// CMD_MULTI instead of being sent separately (each after the uplink interval).
+//#define UPLINK_COALESCE
+
+// Deep sleep between uplinks of a wake cycle
+// If enabled, the MCU enters deep sleep instead of light sleep (ESP32) or delay() (RP2040)
+// while waiting for the last response/status uplink of a wake cycle, if the wait time is
+// at least UPLINK_DEEP_SLEEP_MIN seconds. The uplink is saved in memory which is retained
+// during deep sleep and sent after wake-up - without sensor data reception.
+//#define UPLINK_DEEP_SLEEP
+#define UPLINK_DEEP_SLEEP_MIN 30
+
+// Flash writes of LoRaWAN nonces and session (see SessionStore)
+// After a failed join attempt, the nonces are written to flash only every
+// LW_NONCES_WRITE_INTERVAL attempts (always after a successful join). When joining
+// after a power loss, the DevNonce is advanced by LW_NONCES_DEVNONCE_RESERVE
+// (covering all values which may have been used since) to prevent DevNonce reuse.
+// A copy of the session is written to flash after a join and whenever the uplink frame
+// counter has advanced by LW_SESSION_WRITE_INTERVAL. It is used after a power loss instead
+// of joining again; its uplink frame counter is advanced by LW_SESSION_FCNT_RESERVE
+// (covering all values which may have been used since) to prevent frame counter reuse.
+#define LW_NONCES_WRITE_INTERVAL 4
+#define LW_NONCES_DEVNONCE_RESERVE LW_NONCES_WRITE_INTERVAL
+#define LW_SESSION_WRITE_INTERVAL 16
+#define LW_SESSION_FCNT_RESERVE (LW_SESSION_WRITE_INTERVAL + 1)
+
+// Join backoff (see JoinBackoff)
+// After the n-th failed join attempt, the next attempt is scheduled after a random delay
+// between 50% and 100% of min(JOIN_BACKOFF_MIN * 2^(n-1), JOIN_BACKOFF_MAX) seconds.
+// The aggregated airtime of join requests is limited according to LoRaWAN TS001 section 7.
+#define JOIN_BACKOFF_MIN 60
+#define JOIN_BACKOFF_MAX 3600
+
+// Data rate ramp for join attempts
+// If enabled, the first join attempt uses JOIN_DR_START; the data rate is decreased
+// by one step per failed attempt down to JOIN_DR_END (longer range, more airtime).
+// Note: The valid data rates depend on the region - e.g. EU868: DR0 (SF12) ... DR5 (SF7)
+//#define JOIN_DR_RAMP
+#define JOIN_DR_START 5
+#define JOIN_DR_END 0
+
 // Encoding of invalid values
 // for floating point, see
 // https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/NaN
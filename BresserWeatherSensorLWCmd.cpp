@@ -42,6 +42,13 @@
 // 20241227 Removed delay from encodeCfgUplink()
 // 20250806 Refactored by adding SystemContext class,
 //          replaced getLocalEpoch() (ESP32Time) with time() (POSIX)
+// 20261016 Added CMD_GET_WAKE_TRACE
+//          Added energy accounting to CMD_GET_LW_STATUS response
+//          Added CMD_MULTI
+//          Added coalescing of response and status uplinks
+//          Added CMD_GET_JOIN_HISTORY
+//          CMD_MULTI: Validate port and size of all commands before executing any,
+//          send responses which do not fit into a CMD_MULTI uplink in their own uplink
 //
 // ToDo:
 // -
@@ -54,6 +61,9 @@
 #include <RadioLib.h>
 #include "src/AppLayer.h"
 #include "src/SystemContext.h"
+#include "src/WakeTrace.h"
+#include "src/EnergyAccount.h"
+#include "src/JoinBackoff.h"
 #if defined(ARDUINO_ESP32S3_POWERFEATHER)
 #include <PowerFeather.h>
 using namespace PowerFeather;
@@ -70,10 +80,185 @@ extern AppLayer appLayer;
 /// System context
 extern SystemContext sysCtx;
 
+/// Wake cycle timing trace
+extern WakeTrace wakeTrace;
+
+/// Energy accounting
+extern EnergyAccount energyAccount;
+
+/// Join backoff and join history
+extern JoinBackoff joinBackoff;
+
+/// Pending responses/status messages
+static uint8_t cfgResp[CMD_MULTI_MAX_RESP];
+
+/// Number of pending responses/status messages
+static uint8_t cfgRespNum = 0;
+
+/// Number of pending responses (at the start of cfgResp) to be sent in their own uplink
+static uint8_t cfgRespOwn = 0;
+
+/*!
+ * \brief Check if downlink command is valid
+ *
+ * Checks port and size as decodeDownlink() does, without executing the command.
+ *
+ * \param port      command (downlink port)
+ * \param payload   command payload
+ * \param size      command payload size in bytes
+ *
+ * \returns true if the command would be accepted by decodeDownlink()
+ */
+static bool validCmd(uint8_t port, const uint8_t *payload, size_t size)
+{
+  switch (port)
+  {
+  case CMD_GET_DATETIME:
+  case CMD_GET_LW_CONFIG:
+  case CMD_GET_LW_STATUS:
+  case CMD_GET_JOIN_HISTORY:
+    return (size == 1) && (payload[0] == 0x00);
+
+  case CMD_SET_DATETIME:
+    return size == 4;
+
+  case CMD_SET_SLEEP_INTERVAL:
+  case CMD_SET_SLEEP_INTERVAL_LONG:
+    return size == 2;
+
+  case CMD_SET_LW_STATUS_INTERVAL:
+    return size == 1;
+
+  case CMD_GET_WAKE_TRACE:
+    return (size == 1) && (payload[0] < WAKE_TRACE_STAGES);
+
+  case CMD_MULTI:
+    // Nesting is not allowed
+    return false;
+
+  default:
+    return appLayer.validDownlink(port, payload, size);
+  }
+}
+
+/*!
+ * \brief Decode multi-command downlink
+ *
+ * \param payload   downlink message payload
+ * \param size      downlink message size in bytes
+ *
+ * \returns CMD_MULTI, if any command requests a response, otherwise 0
+ */
+static uint8_t decodeMultiCmd(uint8_t *payload, size_t size)
+{
+  // Validate all commands before executing any of them
+  for (size_t i = 0; i < size; i += 2 + payload[i + 1])
+  {
+    if ((i + 2 > size) || (payload[i + 1] == 0) || (i + 2 + payload[i + 1] > size) ||
+        !validCmd(payload[i], &payload[i + 2], payload[i + 1]))
+    {
+      log_w("Invalid multi-command downlink at offset %u - discarded", static_cast<unsigned>(i));
+      return 0;
+    }
+  }
+
+  bool respReq = false;
+  for (size_t i = 0; i < size; i += 2 + payload[i + 1])
+  {
+    log_d("Command 0x%02X, size %u", payload[i], payload[i + 1]);
+    uint8_t resp = decodeDownlink(payload[i], &payload[i + 2], payload[i + 1]);
+    if (resp)
+    {
+      addCfgResponse(resp);
+      respReq = true;
+    }
+  }
+
+  return respReq ? CMD_MULTI : 0;
+}
+
+// Add response/status message to pending configuration uplinks
+void addCfgResponse(uint8_t cmd)
+{
+  if ((cmd == 0) || (cmd == CMD_MULTI))
+    return;
+
+  for (uint8_t i = 0; i < cfgRespNum; i++)
+  {
+    if (cfgResp[i] == cmd)
+      return;
+  }
+
+  if (cfgRespNum < CMD_MULTI_MAX_RESP)
+  {
+    cfgResp[cfgRespNum++] = cmd;
+  }
+  else
+  {
+    log_w("Too many responses requested - skipping 0x%02X", cmd);
+  }
+}
+
+// Check if configuration uplinks are pending
+bool cfgUplinkPending(void)
+{
+  return cfgRespNum > 0;
+}
+
+// Get port of next configuration uplink
+uint8_t nextCfgUplink(uint8_t maxSize)
+{
+  if (cfgRespNum == 0)
+    return 0;
+
+  if ((cfgRespNum > 1) && (cfgRespOwn == 0))
+  {
+    // Responses which do not fit into a CMD_MULTI uplink are moved to the front
+    // and sent in their own uplinks first
+    maxSize = min(maxSize, static_cast<uint8_t>(MAX_UPLINK_SIZE));
+    uint8_t combined[CMD_MULTI_MAX_RESP];
+    uint8_t numCombined = 0;
+    for (uint8_t i = 0; i < cfgRespNum; i++)
+    {
+      uint8_t resp[MAX_UPLINK_SIZE + 8];
+      uint8_t respSize;
+      encodeCfgUplink(cfgResp[i], resp, respSize);
+      if (2 + respSize > maxSize)
+      {
+        log_d("Response 0x%02X does not fit into multi-response uplink", cfgResp[i]);
+        cfgResp[cfgRespOwn++] = cfgResp[i];
+      }
+      else
+      {
+        combined[numCombined++] = cfgResp[i];
+      }
+    }
+    memcpy(&cfgResp[cfgRespOwn], combined, numCombined);
+  }
+
+  if ((cfgRespNum > 1) && (cfgRespOwn == 0))
+    return CMD_MULTI;
+
+  // Single response or response which does not fit into a CMD_MULTI uplink -
+  // send with its own port
+  uint8_t port = cfgResp[0];
+  cfgRespNum--;
+  if (cfgRespOwn > 0)
+    cfgRespOwn--;
+  memmove(cfgResp, &cfgResp[1], cfgRespNum);
+  return port;
+}
+
 
 // Decode downlink
 uint8_t decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
 {
+  if ((port == CMD_MULTI) && (size > 0))
+  {
+    log_i("Multi-command downlink");
+    return decodeMultiCmd(payload, size);
+  }
+
   if ((port == CMD_GET_DATETIME) && (payload[0] == 0x00) && (size == 1))
   {
     log_i("Get date/time");
@@ -132,18 +317,58 @@ uint8_t decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
     return CMD_GET_LW_STATUS;
   }
 
-  log_d("appLayer.decodeDownlink(port=%d, payload[0]=0x%02X, size=%d)", port, payload[0], size);
+  if ((port == CMD_GET_WAKE_TRACE) && (size == 1) && wakeTrace.selectStats(payload[0]))
+  {
+    log_i("Get wake cycle timing trace");
+    return CMD_GET_WAKE_TRACE;
+  }
+
+  if ((port == CMD_GET_JOIN_HISTORY) && (payload[0] == 0x00) && (size == 1))
+  {
+    log_i("Get join history");
+    return CMD_GET_JOIN_HISTORY;
+  }
+
+  log_d("appLayer.decodeDownlink(port=%d, payload[0]=0x%02X, size=%u)", port, payload[0], static_cast<unsigned>(size));
   return appLayer.decodeDownlink(port, payload, size);
 }
 
 
 // Encode configuration/status uplink
-void encodeCfgUplink(uint8_t port, uint8_t *uplinkPayload, uint8_t &payloadSize)
+void encodeCfgUplink(uint8_t port, uint8_t *uplinkPayload, uint8_t &payloadSize, uint8_t maxSize)
 {
   log_d("--- Uplink Configuration/Status ---");
 
   uint8_t uplinkReq = port;
 
+  if (uplinkReq == CMD_MULTI)
+  {
+    // Combine pending responses/status messages;
+    // the ones which do not fit remain pending for the next uplink
+    // (nextCfgUplink() has moved the ones which do not fit into any
+    // CMD_MULTI uplink to their own uplinks)
+    maxSize = min(maxSize, static_cast<uint8_t>(MAX_UPLINK_SIZE));
+    payloadSize = 0;
+    uint8_t remaining = 0;
+    for (uint8_t i = 0; i < cfgRespNum; i++)
+    {
+      uint8_t resp[MAX_UPLINK_SIZE + 8];
+      uint8_t respSize;
+      encodeCfgUplink(cfgResp[i], resp, respSize);
+      if (payloadSize + 2 + respSize > maxSize)
+      {
+        cfgResp[remaining++] = cfgResp[i];
+        continue;
+      }
+      uplinkPayload[payloadSize++] = cfgResp[i];
+      uplinkPayload[payloadSize++] = respSize;
+      memcpy(&uplinkPayload[payloadSize], resp, respSize);
+      payloadSize += respSize;
+    }
+    cfgRespNum = remaining;
+    return;
+  }
+
   //
   // Encode data as byte array for LoRaWAN transmission
   //
@@ -265,6 +490,18 @@ void encodeCfgUplink(uint8_t port, uint8_t *uplinkPayload, uint8_t &payloadSize)
       encoder.writeTemperature(INV_TEMP);
     }
     #endif
+    encoder.writeUint16(energyAccount.getCycleCharge());
+    encoder.writeUint16(energyAccount.getDailyConsumption());
+  }
+  else if (uplinkReq == CMD_GET_WAKE_TRACE)
+  {
+    log_i("Wake Cycle Timing Trace");
+    wakeTrace.encodeStats(encoder);
+  }
+  else if (uplinkReq == CMD_GET_JOIN_HISTORY)
+  {
+    log_i("Join History");
+    joinBackoff.encodeHistory(encoder);
   }
   else
   {
@@ -48,6 +48,16 @@
 // 20240920 Changed sendCfgUplink() to encodeCfgUplink()
 // 20241227 Removed delay from encodeCfgUplink()
 // 20250731 Added CMD_GET_WS_POSTPROC/CMD_SET_WS_POSTPROC
+// 20261016 Added CMD_GET_WAKE_TRACE
+//          Added energy accounting to CMD_GET_LW_STATUS response
+//          Added CMD_GET_PAYLOAD_LAYOUT
+//          Added CMD_RESET_PAYLOAD_DELTA
+//          Added CMD_MULTI
+//          Added coalescing of response and status uplinks
+//          Added CMD_GET_JOIN_HISTORY
+//          Added CMD_GET_ONEWIRE_RES/CMD_SET_ONEWIRE_RES
+//          CMD_MULTI: Validate all commands, send oversized responses in their own uplink
+//          CMD_GET_LW_STATUS: Separate byte maps for PowerFeather and other boards
 //
 // ToDo:
 // -
@@ -154,10 +164,140 @@
 // Downlink (command):
 // byte0: 0x00
 
-// Uplink (response):
-// byte0: u_batt[15:8]
-// byte1: u_batt[ 7:0]
+// Uplink (response) - all boards except PowerFeather (7 bytes):
+// byte0: u_batt[ 7:0]
+// byte1: u_batt[15:8]
 // byte2: flags[ 7:0]
+// byte3: cycle_charge[ 7:0]
+// byte4: cycle_charge[15:8]
+// byte5: consumption[ 7:0]
+// byte6: consumption[15:8]
+
+// Uplink (response) - ARDUINO_ESP32S3_POWERFEATHER (23 bytes):
+// byte0:  u_batt[ 7:0]
+// byte1:  u_batt[15:8]
+// byte2:  flags[ 7:0]
+// byte3:  u_supply[ 7:0]
+// byte4:  u_supply[15:8]
+// byte5:  i_supply[ 7:0]
+// byte6:  i_supply[15:8]
+// byte7:  i_batt[ 7:0]
+// byte8:  i_batt[15:8]
+// byte9:  soc[ 7:0]
+// byte10: soh[ 7:0]
+// byte11: batt_cycles[ 7:0]
+// byte12: batt_cycles[15:8]
+// byte13: batt_time[ 7: 0]
+// byte14: batt_time[15: 8]
+// byte15: batt_time[23:16]
+// byte16: batt_time[31:24]
+// byte17: batt_temp[15:8]
+// byte18: batt_temp[ 7:0]
+// byte19: cycle_charge[ 7:0]
+// byte20: cycle_charge[15:8]
+// byte21: consumption[ 7:0]
+// byte22: consumption[15:8]
+
+// Note: u_batt/u_supply:  voltage in mV
+//       i_supply/i_batt:  current in mA + 0x8000
+//       soc/soh:          battery state of charge/health in %
+//       batt_time:        battery time left in min + 0x80000000
+//       batt_temp:        battery temperature in degC * 100 (signed, big endian)
+//       cycle_charge:     estimated charge of last wake/sleep cycle in mAs
+//       consumption:      estimated consumption in 0.1 mAh/day
+//       0xFFFF/0xFF...:   not available
+//       cycle_charge and consumption are always the last 4 bytes
+
+// CMD_GET_WAKE_TRACE
+// -------------------
+// Port: CMD_GET_WAKE_TRACE
+// Note: Get wake cycle timing statistics (min/avg/max per stage)
+//       of the last WAKE_TRACE_CYCLES cycles in units of 10 ms;
+//       up to 8 stages per uplink, starting at first_stage
+//       Stages: 0: boot / 1: sysCtx.begin() / 2: loadSecrets() /
+//               3: appLayer.begin() / 4: GPS / 5: getPayloadStage1() /
+//               6: radio.begin() / 7: lwActivate() / 8: sendReceive() /
+//               9: uplinkDelay() / 10: total
+//       0xFFFF: stage not executed in any of the recorded cycles
+#define CMD_GET_WAKE_TRACE 0x3A
+
+// Downlink (command):
+// byte0: first_stage[7:0]
+
+// Uplink (response):
+// byte0: cycles[7:0]
+// byte1: first_stage[7:0]
+// byte2: min0[ 7:0]
+// byte3: min0[15:8]
+// byte4: avg0[ 7:0]
+// byte5: avg0[15:8]
+// byte6: max0[ 7:0]
+// byte7: max0[15:8]
+// ...
+
+// CMD_GET_JOIN_HISTORY
+// ---------------------
+// Port: CMD_GET_JOIN_HISTORY
+// Note: Get history of the last join (sent automatically in the first uplink after a new join)
+//       attempts:            number of join requests (including successful one)
+//       duration:            time from first to last join request in s
+//       airtime:             total airtime of join requests in ms
+//       max_hour_attempts:   max. number of join requests per hour
+//       max_hour_airtime:    max. airtime of join requests per hour in ms
+//       dr:                  data rate of last join request (0xFF: default)
+#define CMD_GET_JOIN_HISTORY 0x3E
+
+// Downlink (command):
+// byte0: 0x00
+
+// Uplink (response):
+// byte0:  attempts[ 7: 0]
+// byte1:  attempts[15: 8]
+// byte2:  duration[ 7: 0]
+// byte3:  duration[15: 8]
+// byte4:  duration[23:16]
+// byte5:  duration[31:24]
+// byte6:  airtime[ 7: 0]
+// byte7:  airtime[15: 8]
+// byte8:  airtime[23:16]
+// byte9:  airtime[31:24]
+// byte10: max_hour_attempts[ 7: 0]
+// byte11: max_hour_attempts[15: 8]
+// byte12: max_hour_airtime[ 7: 0]
+// byte13: max_hour_airtime[15: 8]
+// byte14: max_hour_airtime[23:16]
+// byte15: max_hour_airtime[31:24]
+// byte16: dr[7:0]
+
+// CMD_MULTI
+// ---------
+// Note: Multiple commands in one downlink, each encoded as type-length-value:
+//       command (port of the single command), length, command payload.
+//       The downlink is only executed if all commands are valid (port and size
+//       as for the single command); nesting of CMD_MULTI is not allowed.
+//       The responses (if any) are combined in one uplink, encoded in the same way;
+//       responses which do not fit into the uplink are sent in a subsequent uplink,
+//       responses which do not fit into any combined uplink (2 bytes header) are
+//       sent in their own uplink with the port of the single command.
+//       With UPLINK_COALESCE, pending status messages (CMD_GET_LW_STATUS,
+//       CMD_GET_SENSORS_STAT) are combined with responses in the same way.
+// Port: CMD_MULTI
+#define CMD_MULTI 0x3C
+
+/// Max. number of responses combined in one uplink
+#define CMD_MULTI_MAX_RESP 8
+
+// Downlink (command):
+// byte0:    cmd0[7:0]
+// byte1:    len0[7:0]
+// byte2...: payload0 (len0 bytes)
+// ...
+
+// Uplink (response):
+// byte0:    cmd0[7:0]
+// byte1:    len0[7:0]
+// byte2...: response0 (len0 bytes)
+// ...
 
 // -----------------------
 // -- Application layer --
@@ -258,6 +398,66 @@
 
 // Response: n.a.
 
+// CMD_GET_PAYLOAD_LAYOUT
+// ----------------------
+// Note: Get sensor data uplink layout as planned for the max. payload size
+//       of the current data rate
+// Port: CMD_GET_PAYLOAD_LAYOUT
+#define CMD_GET_PAYLOAD_LAYOUT 0x48
+
+// Downlink (command):
+// byte0: 0x00
+
+// Response:
+// byte00: max. payload size used for planning in bytes
+// byte01: planned payload size in bytes
+// byte02: flags
+//         bit 0: BLE sensor included
+//         bit 1: sensors have been dropped
+// byte03..byte26: effective payload configuration (see CMD_GET_APP_PAYLOAD_CFG),
+//         bits of dropped sensors are cleared
+
+// CMD_RESET_PAYLOAD_DELTA
+// -----------------------
+// Note: Send a keyframe (complete sensor data uplink) next (see PAYLOAD_DELTA)
+// Port: CMD_RESET_PAYLOAD_DELTA
+#define CMD_RESET_PAYLOAD_DELTA 0x49
+
+// Downlink (command):
+// byte0: 0x00
+
+// Uplink: n.a.
+
+// CMD_GET_ONEWIRE_RES
+// -------------------
+// Note: Get 1-Wire temperature sensor resolution in bits (9...12) per index
+// Port: CMD_GET_ONEWIRE_RES
+#define CMD_GET_ONEWIRE_RES 0x4A
+
+// Downlink (command):
+// byte0: 0x00
+
+// Uplink (response):
+// byte00: res00[7:0]
+// byte01: res01[7:0]
+// ...
+// byte15: res15[7:0]
+
+// CMD_SET_ONEWIRE_RES
+// -------------------
+// Note: Set 1-Wire temperature sensor resolution in bits (9...12) per index;
+//       missing indices/other values: 12 bits
+// Port: CMD_SET_ONEWIRE_RES
+#define CMD_SET_ONEWIRE_RES 0x4B
+
+// Downlink (command):
+// byte00: res00[7:0]
+// byte01: res01[7:0]
+// ...
+// byte15: res15[7:0]
+
+// Response: n.a.
+
 // CMD_GET_WS_TIMEOUT
 // -------------------
 // Note: Get weather sensor RX timeout in seconds
@@ -496,14 +696,44 @@
  */
 uint8_t decodeDownlink(uint8_t port, uint8_t *payload, size_t size);
 
+/*!
+ * \brief Add response/status message to pending configuration uplinks
+ *
+ * Duplicates are ignored.
+ *
+ * \param cmd command ID of response (0/CMD_MULTI: ignored)
+ */
+void addCfgResponse(uint8_t cmd);
+
+/*!
+ * \brief Check if configuration uplinks are pending
+ *
+ * \returns true if responses/status messages are pending
+ */
+bool cfgUplinkPending(void);
+
+/*!
+ * \brief Get port of next configuration uplink
+ *
+ * A single pending response is removed and sent with its own port,
+ * multiple pending responses are combined with CMD_MULTI. Responses which
+ * do not fit into a CMD_MULTI uplink of maxSize bytes are sent with their
+ * own port first.
+ *
+ * \param maxSize max. payload size in bytes
+ *
+ * \returns uplink port, 0 if no response is pending
+ */
+uint8_t nextCfgUplink(uint8_t maxSize = MAX_UPLINK_SIZE);
+
 /*!
  * \brief Encode configuration uplink
  *
  * \param port uplink request port
  * \param uplinkPayload uplink payload
  * \param payloadSize   uplink payload size in bytes
- * \param uplinkInterval uplink interval in seconds
+ * \param maxSize       max. payload size in bytes (only used with CMD_MULTI)
  */
-void encodeCfgUplink(uint8_t port, uint8_t *uplinkPayload, uint8_t &payloadSize);
+void encodeCfgUplink(uint8_t port, uint8_t *uplinkPayload, uint8_t &payloadSize, uint8_t maxSize = MAX_UPLINK_SIZE);
 
 #endif
\ No newline at end of file
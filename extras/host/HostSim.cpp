@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+// HostSim.cpp
+//
+// Host-native (Linux) wake cycle simulation of BresserWeatherSensorLW
+//
+// - Shared memory, virtual time, retained memory and deep sleep
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file HostSim.cpp
+ *  \brief Host-native wake cycle simulation - runtime
+ */
+
+#include "HostSim.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+sHostSimShared *hostSim = nullptr;
+
+// Retained variables (RTC_DATA_ATTR) are placed in section "rtc_data";
+// the linker provides its boundaries.
+extern "C" uint8_t __start_rtc_data[];
+extern "C" uint8_t __stop_rtc_data[];
+
+/// True time at wake-up (us since Unix epoch)
+static uint64_t bootUs = 0;
+
+bool hostSimInit(const sHostSimCfg &cfg)
+{
+    void *mem = mmap(nullptr, sizeof(sHostSimShared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+    {
+        return false;
+    }
+    hostSim = static_cast<sHostSimShared *>(mem);
+    memset(hostSim, 0, sizeof(sHostSimShared));
+    hostSim->cfg = cfg;
+    hostSim->trueUs = cfg.startEpoch * 1000000ULL;
+    hostSim->rngState = cfg.seed ? cfg.seed : 1;
+    hostSim->powerOn = true;
+    return true;
+}
+
+bool hostSimBoot(void)
+{
+    size_t size = __stop_rtc_data - __start_rtc_data;
+    if (size > HOST_SIM_RETAINED_SIZE)
+    {
+        fprintf(stderr, "Retained memory (%zu bytes) exceeds %u bytes\n", size, HOST_SIM_RETAINED_SIZE);
+        return false;
+    }
+
+    if (hostSim->powerOn)
+    {
+        // Retained memory keeps its initial values; real time clock starts at zero
+        hostSim->clockOffsetUs = -static_cast<int64_t>(hostSim->trueUs);
+    }
+    else
+    {
+        memcpy(__start_rtc_data, hostSim->retained, size);
+    }
+    hostSim->retainedSize = size;
+    memset(&hostSim->wake, 0, sizeof(hostSim->wake));
+    bootUs = hostSim->trueUs;
+    return true;
+}
+
+uint64_t hostSimMicros(void)
+{
+    return hostSim->trueUs - bootUs;
+}
+
+void hostSimAdvance(uint64_t us)
+{
+    hostSim->trueUs += us;
+    hostSim->clockOffsetUs += static_cast<int64_t>(us) * hostSim->cfg.driftPpm / 1000000;
+}
+
+void hostSimSleep(uint64_t sleepUs)
+{
+    hostSim->wake.awakeMs = hostSimMicros() / 1000;
+    hostSimRecordCycle();
+    hostSim->wake.restart = (sleepUs == 0);
+    hostSim->wake.sleepSeconds = sleepUs / 1000000ULL;
+    memcpy(hostSim->retained, __start_rtc_data, hostSim->retainedSize);
+    hostSim->powerOn = false;
+    hostSim->timerWakeup = (sleepUs != 0);
+    hostSimAdvance(sleepUs);
+    fflush(stdout);
+    _exit(0);
+}
+
+uint32_t hostSimRandom(void)
+{
+    // xorshift32
+    uint32_t x = hostSim->rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    hostSim->rngState = x;
+    return x;
+}
+
+bool hostSimChance(float probability)
+{
+    return (hostSimRandom() >> 8) < static_cast<uint32_t>(probability * (1 << 24));
+}
+
+// The MCU's real time clock - replaces the C library functions for the
+// whole executable; the simulation driver does not use them.
+
+/// Get MCU real time clock
+static int64_t clockUs(void)
+{
+    if (!hostSim)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+    }
+    return static_cast<int64_t>(hostSim->trueUs) + hostSim->clockOffsetUs;
+}
+
+extern "C" time_t time(time_t *t) noexcept
+{
+    time_t now = clockUs() / 1000000;
+    if (t)
+    {
+        *t = now;
+    }
+    return now;
+}
+
+extern "C" int gettimeofday(struct timeval *tv, void *tz) noexcept
+{
+    (void)tz;
+    int64_t now = clockUs();
+    tv->tv_sec = now / 1000000;
+    tv->tv_usec = now % 1000000;
+    return 0;
+}
+
+extern "C" int settimeofday(const struct timeval *tv, const struct timezone *tz) noexcept
+{
+    (void)tz;
+    if (hostSim && tv)
+    {
+        hostSim->clockOffsetUs = static_cast<int64_t>(tv->tv_sec) * 1000000 + tv->tv_usec -
+                                 static_cast<int64_t>(hostSim->trueUs);
+    }
+    return 0;
+}
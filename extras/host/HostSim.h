@@ -0,0 +1,248 @@
+///////////////////////////////////////////////////////////////////////////////
+// HostSim.h
+//
+// Host-native (Linux) wake cycle simulation of BresserWeatherSensorLW
+//
+// - State shared between the simulation driver and the simulated MCU
+//   (one child process per wake-up)
+// - Virtual time, retained (RTC) memory, flash and LoRaWAN network server model
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file HostSim.h
+ *  \brief Host-native wake cycle simulation - shared state
+ *
+ * Each wake-up of the simulated MCU runs in a child process forked from the
+ * simulation driver, i.e. all global objects of the sketch start from their
+ * initial values - like after a reset. Everything which survives a reset
+ * (retained memory, flash, real time clock) and the model of the LoRaWAN
+ * network server are kept in a memory block shared with the driver.
+ */
+
+#if !defined(_HOST_SIM_H)
+#define _HOST_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/// Size of retained memory (ESP32 RTC slow memory)
+#define HOST_SIM_RETAINED_SIZE 8192
+
+/// Number of Preferences (NVS) entries
+#define HOST_SIM_PREFS_ENTRIES 64
+
+/// Max. size of a Preferences entry in bytes
+#define HOST_SIM_PREFS_SIZE 512
+
+/// Number of LittleFS files
+#define HOST_SIM_FILES 8
+
+/// Max. size of a LittleFS file in bytes
+#define HOST_SIM_FILE_SIZE 4096
+
+/// Number of wake cycle stages (see WakeTrace.h)
+#define HOST_SIM_STAGES 11
+
+/// Unix time of default simulation start (2026-10-16 00:00:00 UTC)
+#define HOST_SIM_START_DEFAULT 1792108800ULL
+
+/// Simulation settings
+struct sHostSimCfg
+{
+    uint64_t startEpoch;         //!< simulation start (Unix time)
+    uint32_t seed;               //!< random number generator seed
+    uint8_t dataRate;            //!< uplink data rate after activation (0xFF: join data rate)
+    bool dataRateRandom;         //!< uplink data rate set randomly at each wake-up (ADR)
+    float uplinkLoss;            //!< probability of uplink/downlink loss
+    float txError;               //!< probability of uplink transmission error
+    float joinLoss;              //!< probability of join request/accept loss
+    float rxLoss;                //!< probability of 868 MHz sensor message loss
+    int32_t driftPpm;            //!< RTC drift in ppm
+    uint32_t powerLossInterval;  //!< power loss every n wake-ups (0: never)
+};
+
+/// Preferences (NVS) entry
+struct sHostSimPref
+{
+    bool used;                          //!< entry in use
+    char ns[16];                        //!< namespace
+    char key[16];                       //!< key
+    uint16_t len;                       //!< value size in bytes
+    uint8_t data[HOST_SIM_PREFS_SIZE];  //!< value
+};
+
+/// LittleFS file
+struct sHostSimFile
+{
+    bool used;                         //!< file exists
+    char path[32];                     //!< path
+    uint32_t size;                     //!< file size in bytes
+    uint8_t data[HOST_SIM_FILE_SIZE];  //!< file contents
+};
+
+/// LoRaWAN network server model
+struct sHostSimNetwork
+{
+    bool devNonceValid;     //!< lastDevNonce is valid
+    uint16_t lastDevNonce;  //!< DevNonce of last accepted join request
+    uint32_t joinNonce;     //!< JoinNonce of last join accept
+    uint32_t devAddr;       //!< device address of current session
+    bool fCntValid;         //!< lastFCntUp is valid
+    uint32_t lastFCntUp;    //!< frame counter of last accepted uplink
+    uint32_t frames;        //!< accepted uplinks
+    uint32_t fCntReuse;     //!< uplinks rejected due to frame counter reuse
+    uint32_t devNonceReuse; //!< join requests rejected due to DevNonce reuse
+    uint32_t backfills;     //!< accepted backfill uplinks (PAYLOAD_QUEUE)
+    uint32_t backfillsOoo;  //!< backfill uplinks older than the previous one
+    uint32_t backfillTime;  //!< timestamp of last backfill uplink
+    uint32_t fragmented;    //!< reassembled fragmented messages (PAYLOAD_FRAGMENTATION)
+    uint16_t fragMinSize;   //!< min. size of reassembled messages
+    uint16_t fragMaxSize;   //!< max. size of reassembled messages
+    uint16_t fragSize;      //!< size of message being reassembled
+    uint8_t fragSeq;        //!< sequence number of message being reassembled
+    uint8_t fragNext;       //!< next fragment index (0: no message being reassembled)
+};
+
+/// Statistics of one wake-up
+struct sHostSimWake
+{
+    bool committed;                         //!< wake cycle completed (not suspended for a resumed uplink)
+    bool restart;                           //!< ended by restart instead of deep sleep
+    uint32_t awakeMs;                       //!< time from wake-up to deep sleep
+    uint32_t durationMs[HOST_SIM_STAGES];   //!< stage durations of the completed wake cycle
+    uint32_t sleepSeconds;                  //!< deep sleep duration
+    uint32_t uplinks;                       //!< uplinks sent
+    uint32_t uplinkBytes;                   //!< uplink payload bytes sent
+    uint32_t encodedBytes;                  //!< bytes written by LoraEncoder
+    uint32_t airtimeMs;                     //!< time on air of uplinks and join requests
+    uint32_t joins;                         //!< join requests sent
+    uint32_t joinsFailed;                   //!< join requests without join accept
+    uint32_t prefsPuts;                     //!< Preferences put*() calls
+    uint32_t prefsWrites;                   //!< Preferences put*() calls which changed the stored value
+    uint32_t prefsBytes;                    //!< bytes written by prefsWrites
+    uint32_t fileWrites;                    //!< LittleFS File::write() calls
+    uint32_t fileBytes;                     //!< bytes written to LittleFS
+};
+
+/// Memory shared between simulation driver and simulated MCU
+struct sHostSimShared
+{
+    sHostSimCfg cfg;                                  //!< simulation settings
+    uint64_t trueUs;                                  //!< true time (us since Unix epoch)
+    int64_t clockOffsetUs;                            //!< MCU real time clock - true time (us)
+    uint32_t rngState;                                //!< random number generator state
+    bool powerOn;                                     //!< next wake-up is a power-on reset
+    bool timerWakeup;                                 //!< next wake-up is caused by deep sleep timer
+    uint32_t retainedSize;                            //!< size of retained memory image
+    uint8_t retained[HOST_SIM_RETAINED_SIZE];         //!< retained memory image
+    sHostSimPref prefs[HOST_SIM_PREFS_ENTRIES];       //!< Preferences (NVS)
+    sHostSimFile files[HOST_SIM_FILES];               //!< LittleFS files
+    sHostSimNetwork network;                          //!< LoRaWAN network server
+    sHostSimWake wake;                                //!< statistics of current wake-up
+};
+
+/// Shared memory (nullptr until hostSimInit())
+extern sHostSimShared *hostSim;
+
+/*!
+ * \brief Allocate and initialize the shared memory
+ *
+ * \param cfg simulation settings
+ *
+ * \returns true if successful
+ */
+bool hostSimInit(const sHostSimCfg &cfg);
+
+/*!
+ * \brief Prepare the simulated MCU for a wake-up (called in the child process)
+ *
+ * Restores retained memory unless this is a power-on reset.
+ *
+ * \returns false if retained memory does not fit into HOST_SIM_RETAINED_SIZE
+ */
+bool hostSimBoot(void);
+
+/*!
+ * \brief Get time since wake-up
+ *
+ * \returns time in us
+ */
+uint64_t hostSimMicros(void);
+
+/*!
+ * \brief Advance virtual time
+ *
+ * The MCU's real time clock drifts by cfg.driftPpm.
+ *
+ * \param us time in us
+ */
+void hostSimAdvance(uint64_t us);
+
+/*!
+ * \brief Enter deep sleep or restart - ends the child process
+ *
+ * Saves retained memory and the wake-up statistics to shared memory.
+ *
+ * \param sleepUs sleep duration in us (0: restart)
+ */
+[[noreturn]] void hostSimSleep(uint64_t sleepUs);
+
+/*!
+ * \brief Get random number
+ *
+ * Deterministic sequence (cfg.seed), continued across wake-ups.
+ *
+ * \returns 32-bit random number
+ */
+uint32_t hostSimRandom(void);
+
+/*!
+ * \brief Get random event
+ *
+ * \param probability probability of the event (0...1)
+ *
+ * \returns true with the given probability
+ */
+bool hostSimChance(float probability);
+
+/*!
+ * \brief Record the sketch's wake cycle trace (implemented in Sketch.cpp)
+ *
+ * Called immediately before the MCU enters deep sleep.
+ */
+void hostSimRecordCycle(void);
+
+#endif // _HOST_SIM_H
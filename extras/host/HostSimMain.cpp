@@ -0,0 +1,493 @@
+///////////////////////////////////////////////////////////////////////////////
+// HostSimMain.cpp
+//
+// Host-native (Linux) wake cycle simulation of BresserWeatherSensorLW
+//
+// - Simulation driver: runs the wake-ups and reports statistics
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file HostSimMain.cpp
+ *  \brief Host-native wake cycle simulation - driver
+ *
+ * Each wake-up runs setup() of the sketch in a child process, which ends
+ * in deep sleep (see hostSimSleep()). The driver collects the statistics
+ * of each wake-up and prints a summary.
+ */
+
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <Preferences.h>
+#include "../../BresserWeatherSensorLWCfg.h"
+#include "HostSim.h"
+
+void setup(void);
+
+/// Max. host time per wake-up in s (detects hanging firmware)
+#define WAKE_TIMEOUT_S 10
+
+/// Exit code of child process if setup() returns
+#define EXIT_SETUP_RETURNED 3
+
+/// Exit code of child process if retained memory is too large
+#define EXIT_RETAINED_SIZE 4
+
+/// Stage names, in order of E_WAKE_STAGE
+static const char *stageNames[HOST_SIM_STAGES] = {
+    "boot", "sysctx", "secrets", "applayer", "gps", "payload",
+    "radio", "activate", "uplink", "uplink_delay", "total"};
+
+/// Statistics of all wake-ups
+struct sStats
+{
+    uint32_t wakeups;                      //!< wake-ups
+    uint32_t committed;                    //!< committed wake cycles
+    uint32_t restarts;                     //!< wake-ups ended by restart
+    uint32_t minAwakeMs;                   //!< min. time awake
+    uint32_t maxAwakeMs;                   //!< max. time awake
+    uint64_t sumAwakeMs;                   //!< sum of time awake
+    uint32_t minMs[HOST_SIM_STAGES];       //!< min. stage duration of committed cycles
+    uint32_t maxMs[HOST_SIM_STAGES];       //!< max. stage duration of committed cycles
+    uint64_t sumMs[HOST_SIM_STAGES];       //!< sum of stage durations of committed cycles
+    uint64_t uplinks;                      //!< uplinks
+    uint64_t uplinkBytes;                  //!< uplink payload bytes
+    uint64_t encodedBytes;                 //!< bytes written by LoraEncoder
+    uint64_t airtimeMs;                    //!< time on air
+    uint64_t joins;                        //!< join requests
+    uint64_t joinsFailed;                  //!< join requests without join accept
+    uint64_t prefsPuts;                    //!< Preferences put*() calls
+    uint64_t prefsWrites;                  //!< Preferences flash writes
+    uint64_t prefsBytes;                   //!< Preferences bytes written
+    uint64_t fileWrites;                   //!< LittleFS writes
+    uint64_t fileBytes;                    //!< LittleFS bytes written
+};
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [options]\n"
+           "  -n, --cycles N          number of wake-ups (default: 1000)\n"
+           "  -p, --payload-cfg HEX   appPayloadCfg (%u bytes as hex string)\n"
+           "  -s, --seed N            random number generator seed (default: 1)\n"
+           "  -d, --dr N              uplink data rate 0...5 (default: join data rate)\n"
+           "      --dr-random         uplink data rate changes randomly at each wake-up (ADR)\n"
+           "      --uplink-loss P     probability of uplink/downlink loss (default: 0)\n"
+           "      --tx-error P        probability of uplink transmission error (default: 0)\n"
+           "      --join-loss P       probability of join request/accept loss (default: 0)\n"
+           "      --rx-loss P         probability of 868 MHz sensor message loss (default: 0)\n"
+           "      --drift PPM         RTC drift in ppm (default: 0)\n"
+           "      --power-loss N      power loss every N wake-ups (default: never)\n"
+           "      --start EPOCH       simulation start as Unix time (default: %llu)\n"
+           "      --csv FILE          write statistics of each wake-up to FILE\n"
+           "      --strict            fail on frame counter or DevNonce reuse\n"
+           "  -v, --verbose           show firmware output\n"
+           "  -h, --help              show this help\n",
+           name, APP_PAYLOAD_CFG_SIZE, HOST_SIM_START_DEFAULT);
+}
+
+/*!
+ * \brief Parse hex string
+ *
+ * \param str  hex string
+ * \param buf  output buffer
+ * \param size expected number of bytes
+ *
+ * \returns true if successful
+ */
+static bool parseHex(const char *str, uint8_t *buf, size_t size)
+{
+    if (strlen(str) != 2 * size)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        char byte[3] = {str[2 * i], str[2 * i + 1], '\0'};
+        char *end;
+        buf[i] = strtoul(byte, &end, 16);
+        if (*end != '\0')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief Run one wake-up in a child process
+ *
+ * \param verbose show firmware output
+ *
+ * \returns true if the wake-up ended in deep sleep or restart
+ */
+static bool runWakeup(bool verbose)
+{
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        perror("fork");
+        return false;
+    }
+    if (pid == 0)
+    {
+        alarm(WAKE_TIMEOUT_S);
+        if (!verbose)
+        {
+            int fd = open("/dev/null", O_WRONLY);
+            dup2(fd, STDOUT_FILENO);
+        }
+        if (!hostSimBoot())
+        {
+            _exit(EXIT_RETAINED_SIZE);
+        }
+        setup();
+        fprintf(stderr, "setup() returned\n");
+        _exit(EXIT_SETUP_RETURNED);
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) < 0)
+    {
+        perror("waitpid");
+        return false;
+    }
+    if (WIFSIGNALED(status))
+    {
+        fprintf(stderr, "Wake-up terminated by signal %d (%s)\n", WTERMSIG(status), strsignal(WTERMSIG(status)));
+        return false;
+    }
+    if (WEXITSTATUS(status) != 0)
+    {
+        fprintf(stderr, "Wake-up failed with exit code %d\n", WEXITSTATUS(status));
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Add statistics of last wake-up
+ *
+ * \param stats statistics
+ * \param wake  statistics of last wake-up
+ */
+static void addStats(sStats &stats, const sHostSimWake &wake)
+{
+    stats.minAwakeMs = stats.wakeups ? min(stats.minAwakeMs, wake.awakeMs) : wake.awakeMs;
+    stats.maxAwakeMs = max(stats.maxAwakeMs, wake.awakeMs);
+    stats.sumAwakeMs += wake.awakeMs;
+    if (wake.committed)
+    {
+        for (uint8_t i = 0; i < HOST_SIM_STAGES; i++)
+        {
+            stats.minMs[i] = stats.committed ? min(stats.minMs[i], wake.durationMs[i]) : wake.durationMs[i];
+            stats.maxMs[i] = max(stats.maxMs[i], wake.durationMs[i]);
+            stats.sumMs[i] += wake.durationMs[i];
+        }
+        stats.committed++;
+    }
+    stats.wakeups++;
+    stats.restarts += wake.restart ? 1 : 0;
+    stats.uplinks += wake.uplinks;
+    stats.uplinkBytes += wake.uplinkBytes;
+    stats.encodedBytes += wake.encodedBytes;
+    stats.airtimeMs += wake.airtimeMs;
+    stats.joins += wake.joins;
+    stats.joinsFailed += wake.joinsFailed;
+    stats.prefsPuts += wake.prefsPuts;
+    stats.prefsWrites += wake.prefsWrites;
+    stats.prefsBytes += wake.prefsBytes;
+    stats.fileWrites += wake.fileWrites;
+    stats.fileBytes += wake.fileBytes;
+}
+
+/*!
+ * \brief Write statistics of last wake-up to CSV file
+ *
+ * \param csv  CSV file
+ * \param n    wake-up number
+ * \param wake statistics of last wake-up
+ */
+static void writeCsv(FILE *csv, uint32_t n, const sHostSimWake &wake)
+{
+    if (n == 0)
+    {
+        fprintf(csv, "wakeup,committed,restart,sleep_s,awake_ms");
+        for (const char *name : stageNames)
+        {
+            fprintf(csv, ",%s_ms", name);
+        }
+        fprintf(csv, ",uplinks,uplink_bytes,encoded_bytes,airtime_ms,joins,joins_failed,"
+                     "prefs_puts,prefs_writes,prefs_bytes,file_writes,file_bytes\n");
+    }
+    fprintf(csv, "%u,%u,%u,%u,%u", n, wake.committed, wake.restart, wake.sleepSeconds, wake.awakeMs);
+    for (uint32_t ms : wake.durationMs)
+    {
+        fprintf(csv, ",%u", ms);
+    }
+    fprintf(csv, ",%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", wake.uplinks, wake.uplinkBytes, wake.encodedBytes,
+            wake.airtimeMs, wake.joins, wake.joinsFailed, wake.prefsPuts, wake.prefsWrites, wake.prefsBytes,
+            wake.fileWrites, wake.fileBytes);
+}
+
+/*!
+ * \brief Print summary
+ *
+ * \param stats  statistics
+ * \param hostS  host time in s
+ */
+static void printStats(const sStats &stats, double hostS)
+{
+    double n = stats.wakeups ? stats.wakeups : 1;
+    double simDays = (hostSim->trueUs / 1e6 - hostSim->cfg.startEpoch) / 86400.0;
+
+    printf("Wake-ups:        %u (%u cycles committed, %u restarts)\n", stats.wakeups, stats.committed, stats.restarts);
+    printf("Simulated time:  %.2f days\n", simDays);
+    printf("Host time:       %.2f s (%.0f wake-ups/s)\n", hostS, stats.wakeups / hostS);
+    printf("Retained memory: %u bytes\n", hostSim->retainedSize);
+
+    printf("\nTime awake per wake-up and stage durations of committed cycles (WakeTrace):\n");
+    printf("  %-14s %10s %10s %10s\n", "stage", "min [ms]", "avg [ms]", "max [ms]");
+    printf("  %-14s %10u %10.1f %10u\n", "(awake)", stats.minAwakeMs, stats.sumAwakeMs / n, stats.maxAwakeMs);
+    for (uint8_t i = 0; i < HOST_SIM_STAGES; i++)
+    {
+        printf("  %-14s %10u %10.1f %10u\n", stageNames[i], stats.minMs[i],
+               stats.committed ? static_cast<double>(stats.sumMs[i]) / stats.committed : 0.0, stats.maxMs[i]);
+    }
+
+    printf("\nPer wake-up (average):\n");
+    printf("  %-22s %10.2f\n", "uplinks", stats.uplinks / n);
+    printf("  %-22s %10.2f\n", "uplink payload bytes", stats.uplinkBytes / n);
+    printf("  %-22s %10.2f\n", "encoded bytes", stats.encodedBytes / n);
+    printf("  %-22s %10.2f\n", "time on air [ms]", stats.airtimeMs / n);
+    printf("  %-22s %10.3f\n", "join requests", stats.joins / n);
+    printf("  %-22s %10.3f\n", "join requests failed", stats.joinsFailed / n);
+    printf("  %-22s %10.2f\n", "prefs put calls", stats.prefsPuts / n);
+    printf("  %-22s %10.2f\n", "prefs flash writes", stats.prefsWrites / n);
+    printf("  %-22s %10.2f\n", "prefs bytes written", stats.prefsBytes / n);
+    printf("  %-22s %10.2f\n", "file writes", stats.fileWrites / n);
+    printf("  %-22s %10.2f\n", "file bytes written", stats.fileBytes / n);
+
+    printf("\nNetwork server:\n");
+    printf("  %-22s %10u\n", "uplinks accepted", hostSim->network.frames);
+    printf("  %-22s %10u\n", "FCnt reuse", hostSim->network.fCntReuse);
+    printf("  %-22s %10u\n", "DevNonce reuse", hostSim->network.devNonceReuse);
+    printf("  %-22s %10u\n", "backfill uplinks", hostSim->network.backfills);
+    printf("  %-22s %10u\n", "backfill out of order", hostSim->network.backfillsOoo);
+    printf("  %-22s %10u\n", "fragmented messages", hostSim->network.fragmented);
+    printf("  %-22s %10u\n", "fragmented min. bytes", hostSim->network.fragMinSize);
+    printf("  %-22s %10u\n", "fragmented max. bytes", hostSim->network.fragMaxSize);
+}
+
+int main(int argc, char *argv[])
+{
+    enum
+    {
+        OPT_DR_RANDOM = 256,
+        OPT_UPLINK_LOSS,
+        OPT_TX_ERROR,
+        OPT_JOIN_LOSS,
+        OPT_RX_LOSS,
+        OPT_DRIFT,
+        OPT_POWER_LOSS,
+        OPT_START,
+        OPT_CSV,
+        OPT_STRICT
+    };
+    static const struct option options[] = {
+        {"cycles", required_argument, nullptr, 'n'},
+        {"payload-cfg", required_argument, nullptr, 'p'},
+        {"seed", required_argument, nullptr, 's'},
+        {"dr", required_argument, nullptr, 'd'},
+        {"dr-random", no_argument, nullptr, OPT_DR_RANDOM},
+        {"uplink-loss", required_argument, nullptr, OPT_UPLINK_LOSS},
+        {"tx-error", required_argument, nullptr, OPT_TX_ERROR},
+        {"join-loss", required_argument, nullptr, OPT_JOIN_LOSS},
+        {"rx-loss", required_argument, nullptr, OPT_RX_LOSS},
+        {"drift", required_argument, nullptr, OPT_DRIFT},
+        {"power-loss", required_argument, nullptr, OPT_POWER_LOSS},
+        {"start", required_argument, nullptr, OPT_START},
+        {"csv", required_argument, nullptr, OPT_CSV},
+        {"strict", no_argument, nullptr, OPT_STRICT},
+        {"verbose", no_argument, nullptr, 'v'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}};
+
+    sHostSimCfg cfg = {};
+    cfg.startEpoch = HOST_SIM_START_DEFAULT;
+    cfg.seed = 1;
+    cfg.dataRate = 0xFF;
+    uint32_t cycles = 1000;
+    uint8_t payloadCfg[APP_PAYLOAD_CFG_SIZE];
+    bool payloadCfgSet = false;
+    const char *csvPath = nullptr;
+    bool strict = false;
+    bool verbose = false;
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "n:p:s:d:vh", options, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            cycles = strtoul(optarg, nullptr, 0);
+            break;
+        case 'p':
+            if (!parseHex(optarg, payloadCfg, sizeof(payloadCfg)))
+            {
+                fprintf(stderr, "Invalid appPayloadCfg (expected %zu hex digits)\n", 2 * sizeof(payloadCfg));
+                return 1;
+            }
+            payloadCfgSet = true;
+            break;
+        case 's':
+            cfg.seed = strtoul(optarg, nullptr, 0);
+            break;
+        case 'd':
+            cfg.dataRate = strtoul(optarg, nullptr, 0);
+            break;
+        case OPT_DR_RANDOM:
+            cfg.dataRateRandom = true;
+            break;
+        case OPT_UPLINK_LOSS:
+            cfg.uplinkLoss = atof(optarg);
+            break;
+        case OPT_TX_ERROR:
+            cfg.txError = atof(optarg);
+            break;
+        case OPT_JOIN_LOSS:
+            cfg.joinLoss = atof(optarg);
+            break;
+        case OPT_RX_LOSS:
+            cfg.rxLoss = atof(optarg);
+            break;
+        case OPT_DRIFT:
+            cfg.driftPpm = strtol(optarg, nullptr, 0);
+            break;
+        case OPT_POWER_LOSS:
+            cfg.powerLossInterval = strtoul(optarg, nullptr, 0);
+            break;
+        case OPT_START:
+            cfg.startEpoch = strtoull(optarg, nullptr, 0);
+            break;
+        case OPT_CSV:
+            csvPath = optarg;
+            break;
+        case OPT_STRICT:
+            strict = true;
+            break;
+        case 'v':
+            verbose = true;
+            break;
+        case 'h':
+            usage(argv[0]);
+            return 0;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!hostSimInit(cfg))
+    {
+        perror("mmap");
+        return 1;
+    }
+
+    if (payloadCfgSet)
+    {
+        // Provisioned in flash like a downlink command would do
+        Preferences prefs;
+        prefs.begin("BWS-LW-APP", false);
+        prefs.putBytes("payloadcfg", payloadCfg, sizeof(payloadCfg));
+        prefs.end();
+    }
+
+    FILE *csv = nullptr;
+    if (csvPath && !(csv = fopen(csvPath, "w")))
+    {
+        perror(csvPath);
+        return 1;
+    }
+
+    sStats stats = {};
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    bool ok = true;
+    for (uint32_t n = 0; n < cycles; n++)
+    {
+        if (cfg.powerLossInterval && n && (n % cfg.powerLossInterval == 0))
+        {
+            hostSim->powerOn = true;
+            hostSim->timerWakeup = false;
+        }
+        if (!runWakeup(verbose))
+        {
+            fprintf(stderr, "Simulation aborted at wake-up %u\n", n);
+            ok = false;
+            break;
+        }
+        addStats(stats, hostSim->wake);
+        if (csv)
+        {
+            writeCsv(csv, n, hostSim->wake);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (csv)
+    {
+        fclose(csv);
+    }
+
+    printStats(stats, (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9);
+
+    if (!ok)
+    {
+        return 1;
+    }
+    if (strict && (hostSim->network.fCntReuse || hostSim->network.devNonceReuse))
+    {
+        fprintf(stderr, "Frame counter or DevNonce reuse detected\n");
+        return 2;
+    }
+    return 0;
+}
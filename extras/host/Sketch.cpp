@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+// Sketch.cpp
+//
+// Host-native (Linux) wake cycle simulation of BresserWeatherSensorLW
+//
+// - Compiles the sketch as a C++ translation unit
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file Sketch.cpp
+ *  \brief Host-native wake cycle simulation - the sketch
+ */
+
+#include <Arduino.h>
+#include "../../BresserWeatherSensorLW.ino"
+#include "HostSim.h"
+
+static_assert(HOST_SIM_STAGES == WAKE_TRACE_STAGES, "HOST_SIM_STAGES does not match WAKE_TRACE_STAGES");
+
+void hostSimRecordCycle(void)
+{
+    // A suspended cycle is continued after the next wake-up
+    hostSim->wake.committed = !wakeTrace.isSuspended();
+    for (uint8_t i = 0; i < WAKE_TRACE_STAGES; i++)
+    {
+        hostSim->wake.durationMs[i] = wakeTrace.duration(static_cast<E_WAKE_STAGE>(i));
+    }
+}
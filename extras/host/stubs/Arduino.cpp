@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+// Arduino.cpp
+//
+// Host-native stand-in for the Arduino ESP32 core
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file Arduino.cpp
+ *  \brief Host-native stand-in for the Arduino ESP32 core
+ */
+
+#include "Arduino.h"
+#include <stdarg.h>
+#include "../HostSim.h"
+
+EspClass ESP;
+HardwareSerial Serial;
+HardwareSerial Serial2;
+
+/// Timer wake-up of the next (light or deep) sleep in us
+static uint64_t sleepTimerUs = 0;
+
+const char *pathToFileName(const char *path)
+{
+    const char *name = strrchr(path, '/');
+    return name ? name + 1 : path;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    (void)pin;
+    (void)val;
+}
+
+int digitalRead(uint8_t pin)
+{
+    (void)pin;
+    return LOW;
+}
+
+uint16_t analogRead(uint8_t pin)
+{
+    (void)pin;
+    return 0;
+}
+
+uint32_t analogReadMilliVolts(uint8_t pin)
+{
+    (void)pin;
+    return 0;
+}
+
+void analogSetPinAttenuation(uint8_t pin, adc_attenuation_t attenuation)
+{
+    (void)pin;
+    (void)attenuation;
+}
+
+unsigned long millis(void)
+{
+    return hostSimMicros() / 1000;
+}
+
+unsigned long micros(void)
+{
+    return hostSimMicros();
+}
+
+void delay(uint32_t ms)
+{
+    hostSimAdvance(ms * 1000ULL);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    hostSimAdvance(us);
+}
+
+void yield(void)
+{
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    hostSimAdvance(ticks * portTICK_PERIOD_MS * 1000ULL);
+}
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us)
+{
+    sleepTimerUs = time_in_us;
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t source)
+{
+    if ((source == ESP_SLEEP_WAKEUP_ALL) || (source == ESP_SLEEP_WAKEUP_TIMER))
+    {
+        sleepTimerUs = 0;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_light_sleep_start(void)
+{
+    hostSimAdvance(sleepTimerUs);
+    return ESP_OK;
+}
+
+void esp_deep_sleep_start(void)
+{
+    // A deep sleep without wake-up source would never end
+    hostSimSleep(sleepTimerUs ? sleepTimerUs : 1);
+}
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause(void)
+{
+    return hostSim->timerWakeup ? ESP_SLEEP_WAKEUP_TIMER : ESP_SLEEP_WAKEUP_UNDEFINED;
+}
+
+uint32_t esp_random(void)
+{
+    return hostSimRandom();
+}
+
+void EspClass::restart(void)
+{
+    hostSimSleep(0);
+}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rxPin, int8_t txPin)
+{
+    (void)baud;
+    (void)config;
+    (void)rxPin;
+    (void)txPin;
+}
+
+void HardwareSerial::flush(void)
+{
+    fflush(stdout);
+}
+
+int HardwareSerial::printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int len = vprintf(format, args);
+    va_end(args);
+    return len;
+}
+
+size_t HardwareSerial::print(const char *str)
+{
+    return fputs(str, stdout) >= 0 ? strlen(str) : 0;
+}
+
+size_t HardwareSerial::println(const char *str)
+{
+    return print(str) + print("\n");
+}
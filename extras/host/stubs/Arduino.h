@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////
+// Arduino.h
+//
+// Host-native stand-in for the Arduino ESP32 core
+//
+// - Arduino API subset used by BresserWeatherSensorLW
+// - ESP-IDF sleep functions, FreeRTOS delay and logging macros
+// - Time is virtual (see HostSim.h)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file Arduino.h
+ *  \brief Host-native stand-in for the Arduino ESP32 core
+ */
+
+#if !defined(_HOST_ARDUINO_H)
+#define _HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <time.h>
+#include <algorithm>
+#include <string>
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Logging (esp32-hal-log.h)
+#define ARDUHAL_LOG_LEVEL_NONE 0
+#define ARDUHAL_LOG_LEVEL_ERROR 1
+#define ARDUHAL_LOG_LEVEL_WARN 2
+#define ARDUHAL_LOG_LEVEL_INFO 3
+#define ARDUHAL_LOG_LEVEL_DEBUG 4
+#define ARDUHAL_LOG_LEVEL_VERBOSE 5
+
+#if !defined(CORE_DEBUG_LEVEL)
+#define CORE_DEBUG_LEVEL ARDUHAL_LOG_LEVEL_NONE
+#endif
+
+const char *pathToFileName(const char *path);
+
+#define HOST_LOG(letter, format, ...) \
+    printf("[%6lu][" letter "][%s:%u] %s(): " format "\n", millis(), pathToFileName(__FILE__), __LINE__, __func__, ##__VA_ARGS__)
+
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_ERROR
+#define log_e(format, ...) HOST_LOG("E", format, ##__VA_ARGS__)
+#else
+#define log_e(format, ...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_WARN
+#define log_w(format, ...) HOST_LOG("W", format, ##__VA_ARGS__)
+#else
+#define log_w(format, ...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+#define log_i(format, ...) HOST_LOG("I", format, ##__VA_ARGS__)
+#else
+#define log_i(format, ...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
+#define log_d(format, ...) HOST_LOG("D", format, ##__VA_ARGS__)
+#else
+#define log_d(format, ...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_VERBOSE
+#define log_v(format, ...) HOST_LOG("V", format, ##__VA_ARGS__)
+#else
+#define log_v(format, ...) do {} while (0)
+#endif
+
+/// Variables retained during deep sleep (copied by the simulation, see HostSim.h)
+#define RTC_DATA_ATTR __attribute__((section("rtc_data")))
+
+// Digital/analog I/O - no hardware attached
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+typedef enum
+{
+    ADC_0db,
+    ADC_2_5db,
+    ADC_6db,
+    ADC_11db
+} adc_attenuation_t;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+void analogSetPinAttenuation(uint8_t pin, adc_attenuation_t attenuation);
+
+// Time
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+// FreeRTOS
+typedef uint32_t TickType_t;
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+void vTaskDelay(TickType_t ticks);
+
+// ESP-IDF sleep modes
+typedef int esp_err_t;
+#define ESP_OK 0
+
+typedef enum
+{
+    ESP_SLEEP_WAKEUP_UNDEFINED = 0,
+    ESP_SLEEP_WAKEUP_ALL,
+    ESP_SLEEP_WAKEUP_EXT0,
+    ESP_SLEEP_WAKEUP_EXT1,
+    ESP_SLEEP_WAKEUP_TIMER
+} esp_sleep_source_t;
+typedef esp_sleep_source_t esp_sleep_wakeup_cause_t;
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us);
+esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t source);
+esp_err_t esp_light_sleep_start(void);
+[[noreturn]] void esp_deep_sleep_start(void);
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause(void);
+uint32_t esp_random(void);
+
+/// ESP32 system functions
+class EspClass
+{
+public:
+    [[noreturn]] void restart(void);
+};
+
+extern EspClass ESP;
+
+/// Arduino String (subset)
+class String
+{
+public:
+    String(const char *str = "") : s(str ? str : "") {};
+    String(const std::string &str) : s(str) {};
+    const char *c_str(void) const
+    {
+        return s.c_str();
+    };
+    unsigned int length(void) const
+    {
+        return s.length();
+    };
+    String &operator+=(const String &rhs)
+    {
+        s += rhs.s;
+        return *this;
+    };
+    friend String operator+(const String &lhs, const String &rhs)
+    {
+        return String(lhs.s + rhs.s);
+    };
+    bool operator==(const String &rhs) const
+    {
+        return s == rhs.s;
+    };
+
+private:
+    std::string s;
+};
+
+#define SERIAL_8N1 0x800001c
+
+/// Serial port - output is written to stdout, no input
+class HardwareSerial
+{
+public:
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1);
+    void end(void) {};
+    void setDebugOutput(bool enable)
+    {
+        (void)enable;
+    };
+    void setRxBufferSize(size_t size)
+    {
+        (void)size;
+    };
+    void onReceive(void (*function)(void), bool onlyOnTimeout = false)
+    {
+        (void)function;
+        (void)onlyOnTimeout;
+    };
+    int available(void)
+    {
+        return 0;
+    };
+    int read(void)
+    {
+        return -1;
+    };
+    void flush(void);
+    int printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char *str);
+    size_t println(const char *str = "");
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial2;
+
+#endif // _HOST_ARDUINO_H
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// ArduinoJson.h
+//
+// Host-native stand-in for ArduinoJson
+//
+// - The simulation does not provide JSON files, so deserialization always
+//   fails and the firmware's defaults are used
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file ArduinoJson.h
+ *  \brief Host-native stand-in for ArduinoJson
+ */
+
+#if !defined(_HOST_ARDUINOJSON_H)
+#define _HOST_ARDUINOJSON_H
+
+#include <Arduino.h>
+
+/// JSON value - always null
+class JsonVariant
+{
+public:
+    JsonVariant operator[](const char *key) const
+    {
+        (void)key;
+        return JsonVariant();
+    };
+    JsonVariant operator[](size_t index) const
+    {
+        (void)index;
+        return JsonVariant();
+    };
+    bool isNull(void) const
+    {
+        return true;
+    };
+    template <typename T>
+    T as(void) const
+    {
+        return T();
+    };
+    template <typename T>
+    operator T(void) const
+    {
+        return T();
+    };
+};
+
+typedef JsonVariant JsonObject;
+typedef JsonVariant JsonDocument;
+
+/// Deserialization result
+class DeserializationError
+{
+public:
+    enum Code
+    {
+        Ok,
+        EmptyInput,
+        NotSupported
+    };
+
+    DeserializationError(Code code) : code(code) {};
+    explicit operator bool(void) const
+    {
+        return code != Ok;
+    };
+    const char *c_str(void) const
+    {
+        return (code == Ok) ? "Ok" : (code == EmptyInput) ? "EmptyInput" : "NotSupported";
+    };
+
+private:
+    Code code;
+};
+
+/*!
+ * \brief Deserialize JSON document
+ *
+ * Not supported - the firmware falls back to its defaults.
+ */
+template <typename TInput>
+DeserializationError deserializeJson(JsonDocument &doc, TInput &input)
+{
+    (void)doc;
+    (void)input;
+    return DeserializationError::NotSupported;
+}
+
+#endif // _HOST_ARDUINOJSON_H
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+// DallasTemperature.cpp
+//
+// Host-native stand-in for the DallasTemperature library
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file DallasTemperature.cpp
+ *  \brief Host-native stand-in for the DallasTemperature library
+ */
+
+#include "DallasTemperature.h"
+#include "../HostSim.h"
+
+/// Sensor resolution (stored in the sensor's EEPROM; kept in retained memory
+/// for simplicity - after a power loss the firmware scans the bus again anyway)
+RTC_DATA_ATTR uint8_t simResolution = 12;
+
+/// Time of last conversion request (true time in ms)
+static uint64_t simConvStart = 0;
+
+/*!
+ * \brief Get conversion time
+ *
+ * \param res resolution in bits (9...12)
+ *
+ * \returns conversion time in ms
+ */
+static uint32_t simConvTime(uint8_t res)
+{
+    return 750 >> (12 - res);
+}
+
+/*!
+ * \brief Get simulated sensor's ROM address
+ *
+ * \param addr ROM address
+ */
+static void simAddress(uint8_t *addr)
+{
+    addr[0] = 0x28; // DS18B20
+    for (uint8_t i = 1; i < 8; i++)
+    {
+        addr[i] = (hostSim->cfg.seed * 0x9E3779B9UL) >> (4 * i);
+    }
+}
+
+/*!
+ * \brief Check address
+ *
+ * \param addr ROM address
+ *
+ * \returns true if address of simulated sensor
+ */
+static bool simMatch(const uint8_t *addr)
+{
+    DeviceAddress sim;
+    simAddress(sim);
+    return memcmp(addr, sim, sizeof(sim)) == 0;
+}
+
+void DallasTemperature::begin(void)
+{
+    (void)oneWire;
+    // Bus reset and search
+    delay(3);
+}
+
+uint8_t DallasTemperature::getDeviceCount(void)
+{
+    return 1;
+}
+
+bool DallasTemperature::getAddress(uint8_t *deviceAddress, uint8_t index)
+{
+    if (index != 0)
+    {
+        return false;
+    }
+    simAddress(deviceAddress);
+    return true;
+}
+
+uint8_t DallasTemperature::getResolution(void)
+{
+    return simResolution;
+}
+
+uint8_t DallasTemperature::getResolution(const uint8_t *deviceAddress)
+{
+    return simMatch(deviceAddress) ? simResolution : 0;
+}
+
+bool DallasTemperature::setResolution(const uint8_t *deviceAddress, uint8_t newResolution, bool skipGlobalBitResolutionCalculation)
+{
+    (void)skipGlobalBitResolutionCalculation;
+    if (!simMatch(deviceAddress))
+    {
+        return false;
+    }
+    simResolution = constrain(newResolution, 9, 12);
+    // EEPROM write
+    delay(10);
+    return true;
+}
+
+bool DallasTemperature::isParasitePowerMode(void)
+{
+    return false;
+}
+
+void DallasTemperature::setWaitForConversion(bool flag)
+{
+    waitForConversion = flag;
+}
+
+void DallasTemperature::requestTemperatures(void)
+{
+    simConvStart = hostSim->trueUs / 1000;
+    if (waitForConversion)
+    {
+        delay(simConvTime(simResolution));
+    }
+}
+
+float DallasTemperature::getTempC(const uint8_t *deviceAddress)
+{
+    if (!simMatch(deviceAddress) || (hostSim->trueUs / 1000 - simConvStart < simConvTime(simResolution)))
+    {
+        // Conversion not complete - the sensor returns its power-on reset value
+        return (simMatch(deviceAddress)) ? 85.0 : DEVICE_DISCONNECTED_C;
+    }
+    uint64_t t = hostSim->trueUs / 1000000ULL;
+    float tempC = 15.0 - 5.0 * cos(2 * M_PI * (t % 86400) / 86400.0);
+    // Quantize to resolution
+    float step = 1.0 / (1 << (simResolution - 8));
+    return roundf(tempC / step) * step;
+}
+
+float DallasTemperature::getTempCByIndex(uint8_t index)
+{
+    DeviceAddress addr;
+    if (!getAddress(addr, index))
+    {
+        return DEVICE_DISCONNECTED_C;
+    }
+    return getTempC(addr);
+}
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+// DallasTemperature.h
+//
+// Host-native stand-in for the DallasTemperature library
+//
+// - One simulated DS18B20 sensor (external power)
+// - Conversion time depends on the resolution; temperature is a function of time
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file DallasTemperature.h
+ *  \brief Host-native stand-in for the DallasTemperature library
+ */
+
+#if !defined(_HOST_DALLASTEMPERATURE_H)
+#define _HOST_DALLASTEMPERATURE_H
+
+#include <Arduino.h>
+#include <OneWire.h>
+
+/// Returned by getTempC() if the sensor is not available
+#define DEVICE_DISCONNECTED_C -127
+
+/// ROM address
+typedef uint8_t DeviceAddress[8];
+
+/// Dallas/Maxim temperature sensors
+class DallasTemperature
+{
+public:
+    DallasTemperature(OneWire *oneWire) : oneWire(oneWire) {};
+
+    void begin(void);
+    uint8_t getDeviceCount(void);
+    bool getAddress(uint8_t *deviceAddress, uint8_t index);
+    uint8_t getResolution(void);
+    uint8_t getResolution(const uint8_t *deviceAddress);
+    bool setResolution(const uint8_t *deviceAddress, uint8_t newResolution, bool skipGlobalBitResolutionCalculation = false);
+    bool isParasitePowerMode(void);
+    void setWaitForConversion(bool flag);
+    void requestTemperatures(void);
+    float getTempC(const uint8_t *deviceAddress);
+    float getTempCByIndex(uint8_t index);
+
+private:
+    OneWire *oneWire;
+    bool waitForConversion = true; //!< requestTemperatures() blocks until conversion is done
+};
+
+#endif // _HOST_DALLASTEMPERATURE_H
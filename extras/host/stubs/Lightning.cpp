@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// Lightning.cpp
+//
+// Host-native stand-in for BresserWeatherSensorReceiver's Lightning
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file Lightning.cpp
+ *  \brief Host-native stand-in for BresserWeatherSensorReceiver's Lightning
+ */
+
+#include "Lightning.h"
+
+/// Lightning post-processing state
+struct sLightningState
+{
+    bool valid;       //!< prevCount is valid
+    int16_t prevCount; //!< previous strike counter value
+    bool event;       //!< event data available
+    time_t eventTs;   //!< timestamp of last event
+    int events;       //!< number of strikes of last event
+    uint8_t distance; //!< distance of last event
+};
+
+RTC_DATA_ATTR sLightningState lightningState = {};
+
+void Lightning::reset(void)
+{
+    memset(&lightningState, 0, sizeof(lightningState));
+}
+
+void Lightning::update(time_t timestamp, int16_t count, uint8_t distance, bool startup)
+{
+    if (!lightningState.valid || startup)
+    {
+        lightningState.valid = true;
+        lightningState.prevCount = count;
+        return;
+    }
+    int delta = count - lightningState.prevCount;
+    if (delta < 0)
+    {
+        // Counter overflow (1600)
+        delta += 1600;
+    }
+    lightningState.prevCount = count;
+    if (delta > 0)
+    {
+        lightningState.event = true;
+        lightningState.eventTs = timestamp;
+        lightningState.events = delta;
+        lightningState.distance = distance;
+    }
+}
+
+bool Lightning::lastEvent(time_t &timestamp, int &events, uint8_t &distance)
+{
+    if (!lightningState.event)
+    {
+        return false;
+    }
+    timestamp = lightningState.eventTs;
+    events = lightningState.events;
+    distance = lightningState.distance;
+    return true;
+}
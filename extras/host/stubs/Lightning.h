@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////
+// Lightning.h
+//
+// Host-native stand-in for BresserWeatherSensorReceiver's Lightning
+//
+// - Simplified post-processing: last lightning event only
+// - State is kept in retained memory
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file Lightning.h
+ *  \brief Host-native stand-in for BresserWeatherSensorReceiver's Lightning
+ */
+
+#if !defined(_HOST_LIGHTNING_H)
+#define _HOST_LIGHTNING_H
+
+#include <Arduino.h>
+
+/// Lightning sensor post-processing
+class Lightning
+{
+public:
+    void setUpdateRate(uint8_t rate)
+    {
+        updateRate = rate;
+    };
+    void reset(void);
+    void update(time_t timestamp, int16_t count, uint8_t distance, bool startup = false);
+    bool lastEvent(time_t &timestamp, int &events, uint8_t &distance);
+
+private:
+    uint8_t updateRate = 0; //!< update rate in minutes (unused)
+};
+
+#endif // _HOST_LIGHTNING_H
@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+// LittleFS.cpp
+//
+// Host-native stand-in for the LittleFS file system
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file LittleFS.cpp
+ *  \brief Host-native stand-in for the LittleFS file system
+ */
+
+#include "LittleFS.h"
+#include "../HostSim.h"
+
+LittleFSFS LittleFS;
+
+/*!
+ * \brief Find file
+ *
+ * \param path file path
+ *
+ * \returns file index or -1 if not found
+ */
+static int findFile(const char *path)
+{
+    for (int i = 0; i < HOST_SIM_FILES; i++)
+    {
+        if (hostSim->files[i].used && (strcmp(hostSim->files[i].path, path) == 0))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+size_t File::size(void) const
+{
+    return (index >= 0) ? hostSim->files[index].size : 0;
+}
+
+bool File::seek(uint32_t pos)
+{
+    if ((index < 0) || (pos > size()))
+    {
+        return false;
+    }
+    this->pos = pos;
+    return true;
+}
+
+int File::available(void) const
+{
+    return size() - pos;
+}
+
+int File::read(void)
+{
+    uint8_t c;
+    return (read(&c, 1) == 1) ? c : -1;
+}
+
+size_t File::read(uint8_t *buf, size_t size)
+{
+    size = min(size, static_cast<size_t>(available()));
+    if (size > 0)
+    {
+        memcpy(buf, &hostSim->files[index].data[pos], size);
+        pos += size;
+    }
+    return size;
+}
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+    if ((index < 0) || !writable)
+    {
+        return 0;
+    }
+    sHostSimFile &file = hostSim->files[index];
+    size = min(size, static_cast<size_t>(HOST_SIM_FILE_SIZE - pos));
+    memcpy(&file.data[pos], buf, size);
+    pos += size;
+    file.size = max(file.size, pos);
+    hostSim->wake.fileWrites++;
+    hostSim->wake.fileBytes += size;
+    return size;
+}
+
+void File::close(void)
+{
+    index = -1;
+}
+
+bool LittleFSFS::begin(bool formatOnFail)
+{
+    (void)formatOnFail;
+    return true;
+}
+
+bool LittleFSFS::exists(const char *path)
+{
+    return findFile(path) >= 0;
+}
+
+File LittleFSFS::open(const char *path, const char *mode)
+{
+    int index = findFile(path);
+    if (mode[0] == 'w')
+    {
+        if (index < 0)
+        {
+            for (int i = 0; i < HOST_SIM_FILES; i++)
+            {
+                if (!hostSim->files[i].used && (strlen(path) < sizeof(hostSim->files[i].path)))
+                {
+                    hostSim->files[i].used = true;
+                    strcpy(hostSim->files[i].path, path);
+                    index = i;
+                    break;
+                }
+            }
+        }
+        if (index >= 0)
+        {
+            hostSim->files[index].size = 0;
+        }
+    }
+    if (index < 0)
+    {
+        return File();
+    }
+    return File(index, (mode[0] == 'w') || (strchr(mode, '+') != nullptr));
+}
+
+bool LittleFSFS::remove(const char *path)
+{
+    int index = findFile(path);
+    if (index < 0)
+    {
+        return false;
+    }
+    hostSim->files[index].used = false;
+    return true;
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// LittleFS.h
+//
+// Host-native stand-in for the LittleFS file system
+//
+// - Files are kept in the simulation's shared memory (see HostSim.h)
+// - Flash writes are counted per File::write() call
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file LittleFS.h
+ *  \brief Host-native stand-in for the LittleFS file system
+ */
+
+#if !defined(_HOST_LITTLEFS_H)
+#define _HOST_LITTLEFS_H
+
+#include <Arduino.h>
+
+/// Open file
+class File
+{
+public:
+    File(void) {};
+    File(int index, bool writable) : index(index), writable(writable) {};
+
+    explicit operator bool(void) const
+    {
+        return index >= 0;
+    };
+    size_t size(void) const;
+    bool seek(uint32_t pos);
+    size_t position(void) const
+    {
+        return pos;
+    };
+    int available(void) const;
+    int read(void);
+    size_t read(uint8_t *buf, size_t size);
+    size_t write(const uint8_t *buf, size_t size);
+    void close(void);
+
+private:
+    int index = -1;         //!< file index in shared memory, -1: not open
+    bool writable = false;  //!< opened for writing
+    uint32_t pos = 0;       //!< read/write position
+};
+
+/// LittleFS file system
+class LittleFSFS
+{
+public:
+    bool begin(bool formatOnFail = false);
+    bool exists(const char *path);
+    File open(const char *path, const char *mode = "r");
+    bool remove(const char *path);
+};
+
+extern LittleFSFS LittleFS;
+
+#endif // _HOST_LITTLEFS_H
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// LoraEncoder.cpp
+//
+// Host-native stand-in for LoRa Serialization's LoraEncoder
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file LoraEncoder.cpp
+ *  \brief Host-native stand-in for LoRa Serialization's LoraEncoder
+ */
+
+#include "LoraEncoder.h"
+#include "../HostSim.h"
+
+void LoraEncoder::_intToBytes(uint8_t *buf, int32_t i, uint8_t byteSize)
+{
+    for (uint8_t x = 0; x < byteSize; x++)
+    {
+        buf[x] = static_cast<uint8_t>(i >> (x * 8));
+    }
+}
+
+void LoraEncoder::_append(const uint8_t *buf, uint8_t size)
+{
+    memcpy(&_buffer[_length], buf, size);
+    _length += size;
+    hostSim->wake.encodedBytes += size;
+}
+
+void LoraEncoder::writeUnixtime(uint32_t unixtime)
+{
+    uint8_t buf[4];
+    _intToBytes(buf, unixtime, 4);
+    _append(buf, 4);
+}
+
+void LoraEncoder::writeLatLng(double latitude, double longitude)
+{
+    uint8_t buf[8];
+    _intToBytes(buf, static_cast<int32_t>(latitude * 1e6), 4);
+    _intToBytes(&buf[4], static_cast<int32_t>(longitude * 1e6), 4);
+    _append(buf, 8);
+}
+
+void LoraEncoder::writeUint32(uint32_t i)
+{
+    uint8_t buf[4];
+    _intToBytes(buf, i, 4);
+    _append(buf, 4);
+}
+
+void LoraEncoder::writeUint16(uint16_t i)
+{
+    uint8_t buf[2];
+    _intToBytes(buf, i, 2);
+    _append(buf, 2);
+}
+
+void LoraEncoder::writeUint8(uint8_t i)
+{
+    _append(&i, 1);
+}
+
+void LoraEncoder::writeHumidity(float humidity)
+{
+    uint8_t buf[2];
+    _intToBytes(buf, static_cast<int16_t>(humidity * 100), 2);
+    _append(buf, 2);
+}
+
+void LoraEncoder::writeTemperature(float temperature)
+{
+    // Big endian, two's complement of temperature * 100
+    int16_t t = static_cast<int16_t>(temperature * 100);
+    uint8_t buf[2] = {static_cast<uint8_t>(t >> 8), static_cast<uint8_t>(t)};
+    _append(buf, 2);
+}
+
+void LoraEncoder::writeRawFloat(float value)
+{
+    uint8_t buf[4];
+    memcpy(buf, &value, 4);
+    _append(buf, 4);
+}
+
+void LoraEncoder::writeBitmap(bool a, bool b, bool c, bool d, bool e, bool f, bool g, bool h)
+{
+    uint8_t bitmap = (a << 7) | (b << 6) | (c << 5) | (d << 4) | (e << 3) | (f << 2) | (g << 1) | h;
+    _append(&bitmap, 1);
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// LoraEncoder.h
+//
+// Host-native stand-in for LoRa Serialization's LoraEncoder
+//
+// - Same encoding as the original library (https://github.com/thesolarnomad/lora-serialization)
+// - Encoded bytes are counted (see HostSim.h)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file LoraEncoder.h
+ *  \brief Host-native stand-in for LoRa Serialization's LoraEncoder
+ */
+
+#if !defined(_HOST_LORAENCODER_H)
+#define _HOST_LORAENCODER_H
+
+#include <Arduino.h>
+
+/// Payload encoder
+class LoraEncoder
+{
+public:
+    LoraEncoder(uint8_t *buffer) : _buffer(buffer), _length(0) {};
+
+    void writeUnixtime(uint32_t unixtime);
+    void writeLatLng(double latitude, double longitude);
+    void writeUint32(uint32_t i);
+    void writeUint16(uint16_t i);
+    void writeUint8(uint8_t i);
+    void writeHumidity(float humidity);
+    void writeTemperature(float temperature);
+    void writeRawFloat(float value);
+    void writeBitmap(bool a, bool b, bool c, bool d, bool e, bool f, bool g, bool h);
+    int getLength(void)
+    {
+        return _length;
+    };
+
+private:
+    uint8_t *_buffer;
+    int _length;
+
+    void _intToBytes(uint8_t *buf, int32_t i, uint8_t byteSize);
+    void _append(const uint8_t *buf, uint8_t size);
+};
+
+#endif // _HOST_LORAENCODER_H
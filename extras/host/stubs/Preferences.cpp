@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////
+// Preferences.cpp
+//
+// Host-native stand-in for the ESP32 Preferences library (NVS)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file Preferences.cpp
+ *  \brief Host-native stand-in for the ESP32 Preferences library
+ */
+
+#include "Preferences.h"
+#include "../HostSim.h"
+
+/// Key which marks an existing namespace
+#define NS_MARKER ""
+
+/*!
+ * \brief Find entry
+ *
+ * \param ns  namespace
+ * \param key key
+ *
+ * \returns entry or nullptr if not found
+ */
+static sHostSimPref *findPref(const char *ns, const char *key)
+{
+    for (sHostSimPref &pref : hostSim->prefs)
+    {
+        if (pref.used && (strcmp(pref.ns, ns) == 0) && (strcmp(pref.key, key) == 0))
+        {
+            return &pref;
+        }
+    }
+    return nullptr;
+}
+
+/*!
+ * \brief Allocate entry
+ *
+ * \param ns  namespace
+ * \param key key
+ *
+ * \returns entry or nullptr if storage is full
+ */
+static sHostSimPref *newPref(const char *ns, const char *key)
+{
+    for (sHostSimPref &pref : hostSim->prefs)
+    {
+        if (!pref.used)
+        {
+            memset(&pref, 0, sizeof(pref));
+            pref.used = true;
+            strncpy(pref.ns, ns, sizeof(pref.ns) - 1);
+            strncpy(pref.key, key, sizeof(pref.key) - 1);
+            return &pref;
+        }
+    }
+    log_e("Preferences storage full");
+    return nullptr;
+}
+
+bool Preferences::begin(const char *name, bool readOnly, const char *partition_label)
+{
+    (void)partition_label;
+    if (started || (strlen(name) >= sizeof(ns)))
+    {
+        return false;
+    }
+    if (!findPref(name, NS_MARKER))
+    {
+        // Opening a non-existing namespace read-only fails (NVS_NOT_FOUND)
+        if (readOnly || !newPref(name, NS_MARKER))
+        {
+            return false;
+        }
+    }
+    strcpy(ns, name);
+    this->readOnly = readOnly;
+    started = true;
+    return true;
+}
+
+void Preferences::end(void)
+{
+    started = false;
+}
+
+bool Preferences::isKey(const char *key)
+{
+    return started && findPref(ns, key);
+}
+
+size_t Preferences::getBytesLength(const char *key)
+{
+    const sHostSimPref *pref = started ? findPref(ns, key) : nullptr;
+    return pref ? pref->len : 0;
+}
+
+size_t Preferences::get(const char *key, void *buf, size_t len)
+{
+    const sHostSimPref *pref = started ? findPref(ns, key) : nullptr;
+    if (!pref || (pref->len > len))
+    {
+        return 0;
+    }
+    memcpy(buf, pref->data, pref->len);
+    return pref->len;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen)
+{
+    return get(key, buf, maxLen);
+}
+
+uint8_t Preferences::getUChar(const char *key, uint8_t defaultValue)
+{
+    uint8_t value = defaultValue;
+    return (get(key, &value, sizeof(value)) == sizeof(value)) ? value : defaultValue;
+}
+
+uint16_t Preferences::getUShort(const char *key, uint16_t defaultValue)
+{
+    uint16_t value = defaultValue;
+    return (get(key, &value, sizeof(value)) == sizeof(value)) ? value : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue)
+{
+    uint32_t value = defaultValue;
+    return (get(key, &value, sizeof(value)) == sizeof(value)) ? value : defaultValue;
+}
+
+size_t Preferences::put(const char *key, const void *value, size_t len)
+{
+    if (!started || readOnly || (len > HOST_SIM_PREFS_SIZE))
+    {
+        return 0;
+    }
+    hostSim->wake.prefsPuts++;
+    sHostSimPref *pref = findPref(ns, key);
+    if (pref && (pref->len == len) && (memcmp(pref->data, value, len) == 0))
+    {
+        // NVS does not write an unchanged value
+        return len;
+    }
+    if (!pref && !(pref = newPref(ns, key)))
+    {
+        return 0;
+    }
+    memcpy(pref->data, value, len);
+    pref->len = len;
+    hostSim->wake.prefsWrites++;
+    hostSim->wake.prefsBytes += len;
+    return len;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len)
+{
+    return put(key, value, len);
+}
+
+size_t Preferences::putUChar(const char *key, uint8_t value)
+{
+    return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putUShort(const char *key, uint16_t value)
+{
+    return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value)
+{
+    return put(key, &value, sizeof(value));
+}
+
+bool Preferences::remove(const char *key)
+{
+    if (!started || readOnly)
+    {
+        return false;
+    }
+    sHostSimPref *pref = findPref(ns, key);
+    if (!pref)
+    {
+        return false;
+    }
+    pref->used = false;
+    hostSim->wake.prefsWrites++;
+    return true;
+}
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+// Preferences.h
+//
+// Host-native stand-in for the ESP32 Preferences library (NVS)
+//
+// - Entries are kept in the simulation's shared memory (see HostSim.h)
+// - Flash writes are counted; writes of an unchanged value are skipped like NVS does
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file Preferences.h
+ *  \brief Host-native stand-in for the ESP32 Preferences library
+ */
+
+#if !defined(_HOST_PREFERENCES_H)
+#define _HOST_PREFERENCES_H
+
+#include <Arduino.h>
+
+/// Non-volatile key/value storage
+class Preferences
+{
+public:
+    bool begin(const char *name, bool readOnly = false, const char *partition_label = NULL);
+    void end(void);
+
+    bool isKey(const char *key);
+    size_t getBytesLength(const char *key);
+    size_t getBytes(const char *key, void *buf, size_t maxLen);
+    uint8_t getUChar(const char *key, uint8_t defaultValue = 0);
+    uint16_t getUShort(const char *key, uint16_t defaultValue = 0);
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+
+    size_t putBytes(const char *key, const void *value, size_t len);
+    size_t putUChar(const char *key, uint8_t value);
+    size_t putUShort(const char *key, uint16_t value);
+    size_t putUInt(const char *key, uint32_t value);
+
+    bool remove(const char *key);
+
+private:
+    char ns[16] = {};       //!< namespace
+    bool started = false;   //!< begin() successful
+    bool readOnly = true;   //!< opened read-only
+
+    size_t get(const char *key, void *buf, size_t len);
+    size_t put(const char *key, const void *value, size_t len);
+};
+
+#endif // _HOST_PREFERENCES_H
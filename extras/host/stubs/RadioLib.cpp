@@ -0,0 +1,598 @@
+///////////////////////////////////////////////////////////////////////////////
+// RadioLib.cpp
+//
+// Host-native stand-in for RadioLib (LoRaWAN node and SX1276 transceiver)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file RadioLib.cpp
+ *  \brief Host-native stand-in for RadioLib
+ */
+
+#include "RadioLib.h"
+#include "../HostSim.h"
+#include "../../../BresserWeatherSensorLWCfg.h"
+
+const LoRaWANBand_t EU868 = {"EU868", 16};
+const LoRaWANBand_t US915 = {"US915", 30};
+
+/// Number of data rates (EU868 DR0...DR5: SF12...SF7, BW 125 kHz)
+#define LW_DATA_RATES 6
+
+/// Maximum MAC payload size per data rate (EU868, no repeater)
+static const uint8_t maxPayload[LW_DATA_RATES] = {51, 51, 51, 115, 222, 222};
+
+/// Data rate used for join requests if not specified
+#define LW_JOIN_DR_DEFAULT 2
+
+/// LoRaWAN frame overhead (MHDR, FHDR without FOpts, FPort, MIC)
+#define LW_FRAME_OVERHEAD 13
+
+/// Join request size
+#define LW_JOIN_REQUEST_SIZE 23
+
+/// Join accept size (with CFList)
+#define LW_JOIN_ACCEPT_SIZE 33
+
+// Receive window timing
+#define LW_RX1_DELAY_MS 1000
+#define LW_JOIN_ACCEPT_DELAY1_MS 5000
+#define LW_RX2_OFFSET_MS 1000
+
+/// Preamble symbols detected before a receive window times out
+#define LW_RX_WINDOW_SYMBOLS 8
+
+/// Duty cycle (1%): off-time in multiples of the time on air
+#define LW_DUTY_CYCLE_OFF_FACTOR 99
+
+// MAC answer sizes (CID + payload)
+#define LW_DEVICE_TIME_ANS_SIZE 6
+#define LW_LINK_CHECK_ANS_SIZE 3
+
+/*!
+ * \brief Get symbol time
+ *
+ * \param dr data rate
+ *
+ * \returns symbol time in us
+ */
+static uint32_t symbolUs(uint8_t dr)
+{
+    uint8_t sf = 12 - dr;
+    return (1UL << sf) * 8; // 2^SF / 125 kHz
+}
+
+/*!
+ * \brief Get time on air (Semtech AN1200.13; CR 4/5, explicit header, CRC on)
+ *
+ * \param dr   data rate
+ * \param size PHY payload size in bytes
+ *
+ * \returns time on air in ms
+ */
+static RadioLibTime_t timeOnAir(uint8_t dr, size_t size)
+{
+    int sf = 12 - dr;
+    int de = (sf >= 11) ? 1 : 0;
+    int num = 8 * static_cast<int>(size) - 4 * sf + 28 + 16;
+    int den = 4 * (sf - 2 * de);
+    int symbols = 8 + max((num + den - 1) / den, 0) * 5;
+    uint64_t us = (static_cast<uint64_t>(symbols) * 4 + 8 * 4 + 17) * symbolUs(dr) / 4; // preamble: 8 + 4.25 symbols
+    return (us + 999) / 1000;
+}
+
+/*!
+ * \brief Calculate buffer signature (XOR of 16-bit words, big endian)
+ *
+ * \param buf  buffer
+ * \param size size in bytes
+ *
+ * \returns signature
+ */
+static uint16_t checkSum16(const uint8_t *buf, size_t size)
+{
+    uint16_t checksum = 0;
+    for (size_t i = 0; i < size; i += 2)
+    {
+        uint16_t word = buf[i] << 8;
+        if (i + 1 < size)
+        {
+            word |= buf[i + 1];
+        }
+        checksum ^= word;
+    }
+    return checksum;
+}
+
+static void setU16(uint8_t *buf, uint16_t val)
+{
+    buf[0] = val & 0xFF;
+    buf[1] = val >> 8;
+}
+
+static uint16_t getU16(const uint8_t *buf)
+{
+    return buf[0] | (buf[1] << 8);
+}
+
+static void setU32(uint8_t *buf, uint32_t val)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        buf[i] = (val >> (8 * i)) & 0xFF;
+    }
+}
+
+static uint32_t getU32(const uint8_t *buf)
+{
+    return buf[0] | (buf[1] << 8) | (buf[2] << 16) | (static_cast<uint32_t>(buf[3]) << 24);
+}
+
+void SX1276::reset(void)
+{
+    (void)mod;
+    delay(2);
+}
+
+int16_t SX1276::begin(void)
+{
+    delay(10);
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1276::sleep(void)
+{
+    return RADIOLIB_ERR_NONE;
+}
+
+float SX1276::getRSSI(void)
+{
+    return -97.0;
+}
+
+float SX1276::getSNR(void)
+{
+    return 7.5;
+}
+
+float SX1276::getFrequencyError(bool autoCorrect)
+{
+    (void)autoCorrect;
+    return 120.0;
+}
+
+LoRaWANNode::LoRaWANNode(PhysicalLayer *phy, const LoRaWANBand_t *band, uint8_t subBand)
+    : phy(phy), band(band)
+{
+    (void)subBand;
+}
+
+int16_t LoRaWANNode::beginOTAA(uint64_t joinEUI, uint64_t devEUI, const uint8_t *nwkKey, const uint8_t *appKey)
+{
+    uint8_t creds[48] = {};
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        creds[i] = (joinEUI >> (8 * i)) & 0xFF;
+        creds[8 + i] = (devEUI >> (8 * i)) & 0xFF;
+    }
+    if (nwkKey)
+    {
+        memcpy(&creds[16], nwkKey, 16);
+    }
+    memcpy(&creds[32], appKey, 16);
+    keyCheckSum = checkSum16(creds, sizeof(creds));
+
+    sessionValid = false;
+    activated = false;
+    devNonce = 0;
+    joinNonce = 0;
+    return RADIOLIB_ERR_NONE;
+}
+
+void LoRaWANNode::updateBufferNonces(void)
+{
+    memset(bufferNonces, 0, sizeof(bufferNonces));
+    bufferNonces[RADIOLIB_LORAWAN_NONCES_VERSION] = RADIOLIB_LORAWAN_BUF_VERSION;
+    bufferNonces[RADIOLIB_LORAWAN_NONCES_CLASS] = 0;
+    setU16(&bufferNonces[RADIOLIB_LORAWAN_NONCES_CHECKSUM], keyCheckSum);
+    setU16(&bufferNonces[RADIOLIB_LORAWAN_NONCES_DEV_NONCE], devNonce);
+    setU32(&bufferNonces[RADIOLIB_LORAWAN_NONCES_JOIN_NONCE], joinNonce & 0xFFFFFF);
+    setU16(&bufferNonces[RADIOLIB_LORAWAN_NONCES_SIGNATURE],
+           checkSum16(bufferNonces, RADIOLIB_LORAWAN_NONCES_SIGNATURE));
+}
+
+void LoRaWANNode::updateBufferSession(void)
+{
+    memset(bufferSession, 0, sizeof(bufferSession));
+    if (!sessionValid)
+    {
+        return;
+    }
+    updateBufferNonces();
+    setU32(&bufferSession[RADIOLIB_LORAWAN_SESSION_DEV_ADDR], devAddr);
+    setU32(&bufferSession[RADIOLIB_LORAWAN_SESSION_FCNT_UP], fCntUp);
+    setU32(&bufferSession[RADIOLIB_LORAWAN_SESSION_N_FCNT_DOWN], nFCntDown);
+    bufferSession[RADIOLIB_LORAWAN_SESSION_DATA_RATE] = dataRate;
+    memcpy(&bufferSession[RADIOLIB_LORAWAN_SESSION_NONCES_SIGNATURE],
+           &bufferNonces[RADIOLIB_LORAWAN_NONCES_SIGNATURE], 2);
+    bufferSession[RADIOLIB_LORAWAN_SESSION_VERSION] = RADIOLIB_LORAWAN_BUF_VERSION;
+    setU16(&bufferSession[RADIOLIB_LORAWAN_SESSION_SIGNATURE],
+           checkSum16(bufferSession, RADIOLIB_LORAWAN_SESSION_SIGNATURE));
+}
+
+uint8_t *LoRaWANNode::getBufferNonces(void)
+{
+    updateBufferNonces();
+    return bufferNonces;
+}
+
+int16_t LoRaWANNode::setBufferNonces(const uint8_t *persistentBuffer)
+{
+    if (getU16(&persistentBuffer[RADIOLIB_LORAWAN_NONCES_SIGNATURE]) !=
+        checkSum16(persistentBuffer, RADIOLIB_LORAWAN_NONCES_SIGNATURE))
+    {
+        return RADIOLIB_ERR_CHECKSUM_MISMATCH;
+    }
+    if ((persistentBuffer[RADIOLIB_LORAWAN_NONCES_VERSION] != RADIOLIB_LORAWAN_BUF_VERSION) ||
+        (getU16(&persistentBuffer[RADIOLIB_LORAWAN_NONCES_CHECKSUM]) != keyCheckSum))
+    {
+        return RADIOLIB_ERR_NONCES_DISCARDED;
+    }
+    devNonce = getU16(&persistentBuffer[RADIOLIB_LORAWAN_NONCES_DEV_NONCE]);
+    joinNonce = getU32(&persistentBuffer[RADIOLIB_LORAWAN_NONCES_JOIN_NONCE]) & 0xFFFFFF;
+    return RADIOLIB_ERR_NONE;
+}
+
+uint8_t *LoRaWANNode::getBufferSession(void)
+{
+    updateBufferSession();
+    return bufferSession;
+}
+
+int16_t LoRaWANNode::setBufferSession(const uint8_t *persistentBuffer)
+{
+    if (getU16(&persistentBuffer[RADIOLIB_LORAWAN_SESSION_SIGNATURE]) !=
+        checkSum16(persistentBuffer, RADIOLIB_LORAWAN_SESSION_SIGNATURE))
+    {
+        return RADIOLIB_ERR_CHECKSUM_MISMATCH;
+    }
+    updateBufferNonces();
+    if ((persistentBuffer[RADIOLIB_LORAWAN_SESSION_VERSION] != RADIOLIB_LORAWAN_BUF_VERSION) ||
+        (memcmp(&persistentBuffer[RADIOLIB_LORAWAN_SESSION_NONCES_SIGNATURE],
+                &bufferNonces[RADIOLIB_LORAWAN_NONCES_SIGNATURE], 2) != 0))
+    {
+        return RADIOLIB_ERR_SESSION_DISCARDED;
+    }
+    devAddr = getU32(&persistentBuffer[RADIOLIB_LORAWAN_SESSION_DEV_ADDR]);
+    fCntUp = getU32(&persistentBuffer[RADIOLIB_LORAWAN_SESSION_FCNT_UP]);
+    nFCntDown = getU32(&persistentBuffer[RADIOLIB_LORAWAN_SESSION_N_FCNT_DOWN]);
+    dataRate = persistentBuffer[RADIOLIB_LORAWAN_SESSION_DATA_RATE];
+    sessionValid = true;
+    return RADIOLIB_ERR_NONE;
+}
+
+void LoRaWANNode::clearSession(void)
+{
+    sessionValid = false;
+    activated = false;
+}
+
+void LoRaWANNode::sleepDelay(RadioLibTime_t ms)
+{
+    // The custom sleep function does not handle very short delays
+    if (sleepCb && (ms > 2))
+    {
+        sleepCb(ms);
+    }
+    else
+    {
+        delay(ms);
+    }
+}
+
+int16_t LoRaWANNode::activateOTAA(uint8_t initialDr, LoRaWANJoinEvent_t *joinEvent)
+{
+    (void)joinEvent;
+    if (sessionValid)
+    {
+        if (hostSim->cfg.dataRateRandom)
+        {
+            dataRate = hostSimRandom() % LW_DATA_RATES;
+        }
+        activated = true;
+        return RADIOLIB_LORAWAN_SESSION_RESTORED;
+    }
+
+    uint8_t dr = (initialDr < LW_DATA_RATES) ? initialDr : LW_JOIN_DR_DEFAULT;
+    devNonce++;
+    lastToA = timeOnAir(dr, LW_JOIN_REQUEST_SIZE);
+    hostSimAdvance(lastToA * 1000ULL);
+    hostSim->wake.joins++;
+    hostSim->wake.airtimeMs += lastToA;
+
+    // Network server
+    sHostSimNetwork &ns = hostSim->network;
+    bool accepted = false;
+    if (!hostSimChance(hostSim->cfg.joinLoss))
+    {
+        if (ns.devNonceValid && (devNonce <= ns.lastDevNonce))
+        {
+            ns.devNonceReuse++;
+        }
+        else
+        {
+            ns.devNonceValid = true;
+            ns.lastDevNonce = devNonce;
+            ns.joinNonce++;
+            ns.devAddr = 0x26000000UL | (hostSimRandom() & 0x00FFFFFFUL);
+            ns.fCntValid = false;
+            accepted = !hostSimChance(hostSim->cfg.joinLoss);
+        }
+    }
+
+    sleepDelay(LW_JOIN_ACCEPT_DELAY1_MS);
+    if (accepted)
+    {
+        delay(timeOnAir(dr, LW_JOIN_ACCEPT_SIZE));
+        joinNonce = ns.joinNonce;
+        devAddr = ns.devAddr;
+        fCntUp = 0;
+        nFCntDown = 0;
+        dataRate = (hostSim->cfg.dataRate < LW_DATA_RATES) ? hostSim->cfg.dataRate : dr;
+        sessionValid = true;
+        activated = true;
+        nextUplinkMs = millis() + LW_DUTY_CYCLE_OFF_FACTOR * lastToA;
+        return RADIOLIB_LORAWAN_NEW_SESSION;
+    }
+
+    // RX1 and RX2 window timeout
+    delay(LW_RX_WINDOW_SYMBOLS * symbolUs(dr) / 1000);
+    sleepDelay(LW_RX2_OFFSET_MS - LW_RX_WINDOW_SYMBOLS * symbolUs(dr) / 1000);
+    delay(LW_RX_WINDOW_SYMBOLS * symbolUs(0) / 1000);
+    hostSim->wake.joinsFailed++;
+    return RADIOLIB_ERR_NO_JOIN_ACCEPT;
+}
+
+uint8_t LoRaWANNode::fOptsLen(void)
+{
+    return (devTimeReq ? 1 : 0) + (linkCheckReq ? 1 : 0);
+}
+
+int16_t LoRaWANNode::sendReceive(const uint8_t *dataUp, size_t lenUp, uint8_t fPort, uint8_t *dataDown,
+                                 size_t *lenDown, bool isConfirmed, LoRaWANEvent_t *eventUp,
+                                 LoRaWANEvent_t *eventDown)
+{
+    (void)dataDown;
+    *lenDown = 0;
+    devTimeAns = false;
+    linkCheckAns = false;
+
+    if (!activated)
+    {
+        return RADIOLIB_ERR_NETWORK_NOT_JOINED;
+    }
+    if (lenUp > getMaxPayloadLen())
+    {
+        return RADIOLIB_ERR_PACKET_TOO_LONG;
+    }
+    if (timeUntilUplink() > 0)
+    {
+        return RADIOLIB_ERR_UPLINK_UNAVAILABLE;
+    }
+    if (hostSimChance(hostSim->cfg.txError))
+    {
+        return RADIOLIB_ERR_TX_TIMEOUT;
+    }
+
+    uint32_t fCnt = fCntUp++;
+    lastToA = timeOnAir(dataRate, LW_FRAME_OVERHEAD + fOptsLen() + lenUp);
+    hostSimAdvance(lastToA * 1000ULL);
+    uint64_t txEndUs = hostSim->trueUs;
+    nextUplinkMs = millis() + LW_DUTY_CYCLE_OFF_FACTOR * lastToA;
+    hostSim->wake.uplinks++;
+    hostSim->wake.uplinkBytes += lenUp;
+    hostSim->wake.airtimeMs += lastToA;
+
+    if (eventUp)
+    {
+        *eventUp = {0, isConfirmed, false, dataRate, 868.1f, band->powerMax, fCnt, fPort};
+    }
+
+    // Network server
+    sHostSimNetwork &ns = hostSim->network;
+    bool received = !hostSimChance(hostSim->cfg.uplinkLoss);
+    if (received && ns.fCntValid && (fCnt <= ns.lastFCntUp))
+    {
+        // Replayed frame counter - frame is discarded
+        ns.fCntReuse++;
+        received = false;
+    }
+    if (received)
+    {
+        ns.fCntValid = true;
+        ns.lastFCntUp = fCnt;
+        ns.frames++;
+#if defined(PAYLOAD_QUEUE)
+        if ((fPort == PAYLOAD_QUEUE_PORT) && (lenUp >= 5))
+        {
+            // Backfill frame: port, timestamp (4 bytes, little endian), payload
+            uint32_t t = dataUp[1] | (dataUp[2] << 8) | (dataUp[3] << 16) | (static_cast<uint32_t>(dataUp[4]) << 24);
+            if (ns.backfills && (t < ns.backfillTime))
+            {
+                ns.backfillsOoo++;
+            }
+            ns.backfills++;
+            ns.backfillTime = t;
+        }
+#endif
+#if defined(PAYLOAD_FRAGMENTATION)
+        if ((fPort == PAYLOAD_FRAGMENT_PORT) && (lenUp >= 1))
+        {
+            // Fragment: header (sequence number, last fragment flag, index), payload
+            uint8_t seq = dataUp[0] >> 4;
+            uint8_t idx = dataUp[0] & 0x07;
+            if (idx == 0)
+            {
+                ns.fragSeq = seq;
+                ns.fragSize = 0;
+                ns.fragNext = 0;
+            }
+            if ((seq == ns.fragSeq) && (idx == ns.fragNext))
+            {
+                ns.fragSize += lenUp - 1;
+                ns.fragNext++;
+                if (dataUp[0] & 0x08)
+                {
+                    ns.fragMinSize = ns.fragmented ? min(ns.fragMinSize, ns.fragSize) : ns.fragSize;
+                    ns.fragMaxSize = max(ns.fragMaxSize, ns.fragSize);
+                    ns.fragmented++;
+                    ns.fragNext = 0;
+                }
+            }
+            else
+            {
+                // Fragment missing - message cannot be reassembled
+                ns.fragNext = 0xFF;
+            }
+        }
+#endif
+    }
+    bool answer = received && (isConfirmed || devTimeReq || linkCheckReq) &&
+                  !hostSimChance(hostSim->cfg.uplinkLoss);
+    bool reqDevTime = devTimeReq;
+    bool reqLinkCheck = linkCheckReq;
+    devTimeReq = false;
+    linkCheckReq = false;
+
+    sleepDelay(LW_RX1_DELAY_MS);
+    if (answer)
+    {
+        size_t size = LW_FRAME_OVERHEAD - 1 + (reqDevTime ? LW_DEVICE_TIME_ANS_SIZE : 0) +
+                      (reqLinkCheck ? LW_LINK_CHECK_ANS_SIZE : 0);
+        delay(timeOnAir(dataRate, size));
+        if (reqDevTime)
+        {
+            devTimeAns = true;
+            devTimeEpoch = txEndUs / 1000000ULL;
+            devTimeMs = (txEndUs / 1000ULL) % 1000;
+        }
+        linkCheckAns = reqLinkCheck;
+        nFCntDown++;
+        if (eventDown)
+        {
+            *eventDown = {1, false, isConfirmed, dataRate, 868.1f, 0, nFCntDown, 0};
+        }
+        return 1;
+    }
+
+    // RX1 and RX2 window timeout
+    delay(LW_RX_WINDOW_SYMBOLS * symbolUs(dataRate) / 1000);
+    sleepDelay(LW_RX2_OFFSET_MS - LW_RX_WINDOW_SYMBOLS * symbolUs(dataRate) / 1000);
+    delay(LW_RX_WINDOW_SYMBOLS * symbolUs(0) / 1000);
+    return RADIOLIB_ERR_NONE;
+}
+
+RadioLibTime_t LoRaWANNode::getLastToA(void)
+{
+    return lastToA;
+}
+
+uint32_t LoRaWANNode::getFCntUp(void)
+{
+    // Frame counter of last uplink
+    return fCntUp ? fCntUp - 1 : 0;
+}
+
+uint8_t LoRaWANNode::getMaxPayloadLen(void)
+{
+    return maxPayload[min(dataRate, static_cast<uint8_t>(LW_DATA_RATES - 1))] - fOptsLen();
+}
+
+RadioLibTime_t LoRaWANNode::timeUntilUplink(void)
+{
+    RadioLibTime_t now = millis();
+    return (nextUplinkMs > now) ? nextUplinkMs - now : 0;
+}
+
+void LoRaWANNode::setDeviceStatus(uint8_t battLevel)
+{
+    (void)battLevel;
+}
+
+int16_t LoRaWANNode::sendMacCommandReq(uint8_t cid)
+{
+    if (cid == RADIOLIB_LORAWAN_MAC_DEVICE_TIME)
+    {
+        devTimeReq = true;
+    }
+    else if (cid == RADIOLIB_LORAWAN_MAC_LINK_CHECK)
+    {
+        linkCheckReq = true;
+    }
+    else
+    {
+        return RADIOLIB_ERR_INVALID_CID;
+    }
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t LoRaWANNode::getMacDeviceTimeAns(uint32_t *gpsEpoch, uint16_t *milliseconds, bool returnUnix)
+{
+    if (!devTimeAns)
+    {
+        return RADIOLIB_ERR_COMMAND_QUEUE_ITEM_NOT_FOUND;
+    }
+    // GPS epoch (1980-01-06) is 315964800 s after Unix epoch; leap seconds are ignored
+    *gpsEpoch = returnUnix ? devTimeEpoch : devTimeEpoch - 315964800UL;
+    *milliseconds = devTimeMs;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t LoRaWANNode::getMacLinkCheckAns(uint8_t *margin, uint8_t *gwCnt)
+{
+    if (!linkCheckAns)
+    {
+        return RADIOLIB_ERR_COMMAND_QUEUE_ITEM_NOT_FOUND;
+    }
+    *margin = 20;
+    *gwCnt = 1;
+    return RADIOLIB_ERR_NONE;
+}
+
+void LoRaWANNode::setSleepFunction(void (*cb)(RadioLibTime_t ms))
+{
+    sleepCb = cb;
+}
@@ -0,0 +1,262 @@
+///////////////////////////////////////////////////////////////////////////////
+// RadioLib.h
+//
+// Host-native stand-in for RadioLib (LoRaWAN node and SX1276 transceiver)
+//
+// - Subset of the RadioLib API used by BresserWeatherSensorLW
+// - OTAA join, session/nonces buffers, uplinks with RX windows, duty cycle
+//   and the MAC commands DeviceTimeReq/LinkCheckReq
+// - Time on air according to Semtech AN1200.13 (EU868, BW 125 kHz)
+// - Frames are exchanged with the network server model in HostSim.h
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// - Downlinks with application payload
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file RadioLib.h
+ *  \brief Host-native stand-in for RadioLib
+ */
+
+#if !defined(_HOST_RADIOLIB_H)
+#define _HOST_RADIOLIB_H
+
+#include <Arduino.h>
+
+/// Time in ms
+typedef unsigned long RadioLibTime_t;
+
+/// Pin not connected
+#define RADIOLIB_NC (0xFFFFFFFF)
+
+/// Built-in module drivers
+#define RADIOLIB_BUILTIN_MODULE_SX1276
+
+// Status codes (distinct values, see RadioLib TypeDef.h)
+#define RADIOLIB_ERR_NONE (0)
+#define RADIOLIB_ERR_CHIP_NOT_FOUND (-2)
+#define RADIOLIB_ERR_PACKET_TOO_LONG (-4)
+#define RADIOLIB_ERR_TX_TIMEOUT (-5)
+#define RADIOLIB_ERR_RX_TIMEOUT (-6)
+#define RADIOLIB_ERR_INVALID_BANDWIDTH (-8)
+#define RADIOLIB_ERR_INVALID_SPREADING_FACTOR (-9)
+#define RADIOLIB_ERR_INVALID_CODING_RATE (-10)
+#define RADIOLIB_ERR_INVALID_FREQUENCY (-12)
+#define RADIOLIB_ERR_INVALID_OUTPUT_POWER (-13)
+#define RADIOLIB_ERR_NETWORK_NOT_JOINED (-1101)
+#define RADIOLIB_ERR_DOWNLINK_MALFORMED (-1102)
+#define RADIOLIB_ERR_INVALID_REVISION (-1103)
+#define RADIOLIB_ERR_INVALID_PORT (-1104)
+#define RADIOLIB_ERR_NO_RX_WINDOW (-1105)
+#define RADIOLIB_ERR_INVALID_CID (-1106)
+#define RADIOLIB_ERR_UPLINK_UNAVAILABLE (-1107)
+#define RADIOLIB_ERR_COMMAND_QUEUE_FULL (-1108)
+#define RADIOLIB_ERR_COMMAND_QUEUE_ITEM_NOT_FOUND (-1109)
+#define RADIOLIB_ERR_JOIN_NONCE_INVALID (-1110)
+#define RADIOLIB_ERR_MIC_MISMATCH (-1111)
+#define RADIOLIB_ERR_DWELL_TIME_EXCEEDED (-1113)
+#define RADIOLIB_ERR_CHECKSUM_MISMATCH (-1114)
+#define RADIOLIB_ERR_NO_JOIN_ACCEPT (-1115)
+#define RADIOLIB_LORAWAN_SESSION_RESTORED (-1116)
+#define RADIOLIB_LORAWAN_NEW_SESSION (-1117)
+#define RADIOLIB_ERR_NONCES_DISCARDED (-1118)
+#define RADIOLIB_ERR_SESSION_DISCARDED (-1119)
+
+/// Data rate not set
+#define RADIOLIB_LORAWAN_DATA_RATE_UNUSED (0xFF)
+
+// MAC commands
+#define RADIOLIB_LORAWAN_MAC_LINK_CHECK (0x02)
+#define RADIOLIB_LORAWAN_MAC_DEVICE_TIME (0x0D)
+
+// Nonces buffer layout
+#define RADIOLIB_LORAWAN_NONCES_VERSION (0x00)
+#define RADIOLIB_LORAWAN_NONCES_MODE (0x01)
+#define RADIOLIB_LORAWAN_NONCES_CLASS (0x03)
+#define RADIOLIB_LORAWAN_NONCES_PLAN (0x04)
+#define RADIOLIB_LORAWAN_NONCES_CHECKSUM (0x05)
+#define RADIOLIB_LORAWAN_NONCES_DEV_NONCE (0x07)
+#define RADIOLIB_LORAWAN_NONCES_JOIN_NONCE (0x09)
+#define RADIOLIB_LORAWAN_NONCES_SIGNATURE (0x0C)
+#define RADIOLIB_LORAWAN_NONCES_BUF_SIZE (0x0E)
+
+// Session buffer layout
+#define RADIOLIB_LORAWAN_SESSION_DEV_ADDR (0x00)
+#define RADIOLIB_LORAWAN_SESSION_FCNT_UP (0x04)
+#define RADIOLIB_LORAWAN_SESSION_N_FCNT_DOWN (0x08)
+#define RADIOLIB_LORAWAN_SESSION_DATA_RATE (0x0C)
+#define RADIOLIB_LORAWAN_SESSION_NONCES_SIGNATURE (0x0E)
+#define RADIOLIB_LORAWAN_SESSION_VERSION (0x10)
+#define RADIOLIB_LORAWAN_SESSION_SIGNATURE (0x016E)
+#define RADIOLIB_LORAWAN_SESSION_BUF_SIZE (0x0170)
+
+/// Buffer layout version
+#define RADIOLIB_LORAWAN_BUF_VERSION (0x01)
+
+/// LoRaWAN band (subset)
+struct LoRaWANBand_t
+{
+    const char *name; //!< band name
+    int8_t powerMax;  //!< maximum output power in dBm
+};
+
+extern const LoRaWANBand_t EU868;
+extern const LoRaWANBand_t US915;
+
+/// LoRaWAN uplink/downlink event details
+struct LoRaWANEvent_t
+{
+    uint8_t dir;       //!< direction (0: uplink, 1: downlink)
+    bool confirmed;    //!< confirmed frame
+    bool confirming;   //!< frame confirms a previous frame
+    uint8_t datarate;  //!< data rate
+    float freq;        //!< frequency in MHz
+    int16_t power;     //!< output power in dBm
+    uint32_t fCnt;     //!< frame counter
+    uint8_t fPort;     //!< port
+};
+
+/// Join event details (unused)
+struct LoRaWANJoinEvent_t
+{
+    bool newSession; //!< new session
+};
+
+/// Transceiver module pins
+class Module
+{
+public:
+    Module(uint32_t cs, uint32_t irq, uint32_t rst, uint32_t gpio = RADIOLIB_NC)
+        : cs(cs), irq(irq), rst(rst), gpio(gpio) {};
+
+    uint32_t cs;   //!< chip select
+    uint32_t irq;  //!< interrupt
+    uint32_t rst;  //!< reset
+    uint32_t gpio; //!< GPIO/BUSY
+};
+
+/// Transceiver base class
+class PhysicalLayer
+{
+public:
+    virtual ~PhysicalLayer() {};
+
+    /*!
+     * \brief Get RSSI of last received packet
+     *
+     * \returns RSSI in dBm
+     */
+    virtual float getRSSI(void) = 0;
+
+    /*!
+     * \brief Get SNR of last received packet
+     *
+     * \returns SNR in dB
+     */
+    virtual float getSNR(void) = 0;
+};
+
+/// SX1276 transceiver - all operations only take time
+class SX1276 : public PhysicalLayer
+{
+public:
+    SX1276(Module *mod) : mod(mod) {};
+
+    void reset(void);
+    int16_t begin(void);
+    int16_t sleep(void);
+    float getRSSI(void) override;
+    float getSNR(void) override;
+    float getFrequencyError(bool autoCorrect = false);
+
+private:
+    Module *mod;
+};
+
+/// LoRaWAN node (class A, OTAA)
+class LoRaWANNode
+{
+public:
+    LoRaWANNode(PhysicalLayer *phy, const LoRaWANBand_t *band, uint8_t subBand = 0);
+
+    int16_t beginOTAA(uint64_t joinEUI, uint64_t devEUI, const uint8_t *nwkKey, const uint8_t *appKey);
+    uint8_t *getBufferNonces(void);
+    int16_t setBufferNonces(const uint8_t *persistentBuffer);
+    uint8_t *getBufferSession(void);
+    int16_t setBufferSession(const uint8_t *persistentBuffer);
+    void clearSession(void);
+    int16_t activateOTAA(uint8_t initialDr = RADIOLIB_LORAWAN_DATA_RATE_UNUSED, LoRaWANJoinEvent_t *joinEvent = NULL);
+    int16_t sendReceive(const uint8_t *dataUp, size_t lenUp, uint8_t fPort, uint8_t *dataDown, size_t *lenDown,
+                        bool isConfirmed = false, LoRaWANEvent_t *eventUp = NULL, LoRaWANEvent_t *eventDown = NULL);
+    RadioLibTime_t getLastToA(void);
+    uint32_t getFCntUp(void);
+    uint8_t getMaxPayloadLen(void);
+    RadioLibTime_t timeUntilUplink(void);
+    void setDeviceStatus(uint8_t battLevel);
+    int16_t sendMacCommandReq(uint8_t cid);
+    int16_t getMacDeviceTimeAns(uint32_t *gpsEpoch, uint16_t *milliseconds, bool returnUnix = true);
+    int16_t getMacLinkCheckAns(uint8_t *margin, uint8_t *gwCnt);
+    void setSleepFunction(void (*cb)(RadioLibTime_t ms));
+
+private:
+    PhysicalLayer *phy;
+    const LoRaWANBand_t *band;
+
+    uint16_t keyCheckSum = 0;           //!< checksum of the credentials
+    uint8_t bufferNonces[RADIOLIB_LORAWAN_NONCES_BUF_SIZE] = {};
+    uint8_t bufferSession[RADIOLIB_LORAWAN_SESSION_BUF_SIZE] = {};
+    bool sessionValid = false;          //!< session restored or joined
+    bool activated = false;             //!< activateOTAA() completed
+    uint16_t devNonce = 0;              //!< last DevNonce
+    uint32_t joinNonce = 0;             //!< last JoinNonce
+    uint32_t devAddr = 0;               //!< device address
+    uint32_t fCntUp = 0;                //!< next uplink frame counter
+    uint32_t nFCntDown = 0;             //!< network downlink frame counter
+    uint8_t dataRate = 0;               //!< uplink data rate
+    RadioLibTime_t lastToA = 0;         //!< time on air of last uplink in ms
+    RadioLibTime_t nextUplinkMs = 0;    //!< millis() of next uplink permitted by duty cycle
+    bool devTimeReq = false;            //!< DeviceTimeReq pending
+    bool linkCheckReq = false;          //!< LinkCheckReq pending
+    bool devTimeAns = false;            //!< DeviceTimeAns received in last downlink
+    uint32_t devTimeEpoch = 0;          //!< DeviceTimeAns: Unix time
+    uint16_t devTimeMs = 0;             //!< DeviceTimeAns: milliseconds
+    bool linkCheckAns = false;          //!< LinkCheckAns received in last downlink
+    void (*sleepCb)(RadioLibTime_t ms) = nullptr;
+
+    uint8_t fOptsLen(void);
+    void sleepDelay(RadioLibTime_t ms);
+    void updateBufferNonces(void);
+    void updateBufferSession(void);
+};
+
+#endif // _HOST_RADIOLIB_H
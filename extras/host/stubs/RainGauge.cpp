@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////
+// RainGauge.cpp
+//
+// Host-native stand-in for BresserWeatherSensorReceiver's RainGauge
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file RainGauge.cpp
+ *  \brief Host-native stand-in for BresserWeatherSensorReceiver's RainGauge
+ */
+
+#include "RainGauge.h"
+
+/// Number of samples for the past hour
+#define RAIN_HIST_SIZE 16
+
+/// Rain gauge state
+struct sRainState
+{
+    bool valid;                          //!< state initialized
+    float lastRaw;                       //!< last raw counter value
+    float total;                         //!< accumulated rain (with overflows)
+    time_t histTs[RAIN_HIST_SIZE];       //!< sample timestamps
+    float histTotal[RAIN_HIST_SIZE];     //!< accumulated rain at sample time
+    uint8_t histIdx;                     //!< next history index
+    int tmDay;                           //!< day of year of dayStart
+    int tmWeek;                          //!< week of year of weekStart
+    int tmMonth;                         //!< month of monthStart
+    float dayStart;                      //!< accumulated rain at start of day
+    float weekStart;                     //!< accumulated rain at start of week
+    float monthStart;                    //!< accumulated rain at start of month
+};
+
+RTC_DATA_ATTR sRainState rainState = {};
+
+void RainGauge::reset(uint8_t flags)
+{
+    if (flags & RESET_RAIN_H)
+    {
+        memset(rainState.histTs, 0, sizeof(rainState.histTs));
+    }
+    if (flags & RESET_RAIN_D)
+    {
+        rainState.dayStart = rainState.total;
+    }
+    if (flags & RESET_RAIN_W)
+    {
+        rainState.weekStart = rainState.total;
+    }
+    if (flags & RESET_RAIN_M)
+    {
+        rainState.monthStart = rainState.total;
+    }
+    if (flags == 0xF)
+    {
+        rainState.valid = false;
+    }
+}
+
+void RainGauge::update(time_t timestamp, float rain, bool startup)
+{
+    struct tm t;
+    localtime_r(&timestamp, &t);
+    int week = (t.tm_yday + 7 - ((t.tm_wday + 6) % 7)) / 7;
+
+    if (!rainState.valid)
+    {
+        memset(&rainState, 0, sizeof(rainState));
+        rainState.valid = true;
+        rainState.lastRaw = rain;
+        rainState.tmDay = t.tm_yday;
+        rainState.tmWeek = week;
+        rainState.tmMonth = t.tm_mon;
+    }
+
+    // Sensor restart resets the counter; counter overflow at raingaugeMax
+    float delta = rain - rainState.lastRaw;
+    if (startup)
+    {
+        delta = rain;
+    }
+    else if (delta < 0)
+    {
+        delta += raingaugeMax;
+    }
+    rainState.lastRaw = rain;
+    rainState.total += delta;
+
+    if (t.tm_yday != rainState.tmDay)
+    {
+        rainState.tmDay = t.tm_yday;
+        rainState.dayStart = rainState.total - delta;
+    }
+    if (week != rainState.tmWeek)
+    {
+        rainState.tmWeek = week;
+        rainState.weekStart = rainState.total - delta;
+    }
+    if (t.tm_mon != rainState.tmMonth)
+    {
+        rainState.tmMonth = t.tm_mon;
+        rainState.monthStart = rainState.total - delta;
+    }
+
+    rainState.histTs[rainState.histIdx] = timestamp;
+    rainState.histTotal[rainState.histIdx] = rainState.total;
+    rainState.histIdx = (rainState.histIdx + 1) % RAIN_HIST_SIZE;
+}
+
+float RainGauge::pastHour(bool *valid, int *nbins, float *quality)
+{
+    time_t now = 0;
+    float total = 0;
+    for (uint8_t i = 0; i < RAIN_HIST_SIZE; i++)
+    {
+        if (rainState.histTs[i] > now)
+        {
+            now = rainState.histTs[i];
+            total = rainState.histTotal[i];
+        }
+    }
+
+    // Oldest sample within the past hour
+    time_t oldest = now;
+    float start = total;
+    for (uint8_t i = 0; i < RAIN_HIST_SIZE; i++)
+    {
+        time_t ts = rainState.histTs[i];
+        if (ts && (now - ts <= 3600) && (ts < oldest))
+        {
+            oldest = ts;
+            start = rainState.histTotal[i];
+        }
+    }
+
+    bool ok = rainState.valid && (now - oldest >= 3600 - 600);
+    if (valid)
+    {
+        *valid = ok;
+    }
+    if (nbins)
+    {
+        *nbins = 0;
+    }
+    if (quality)
+    {
+        *quality = ok ? 1.0 : 0.0;
+    }
+    return total - start;
+}
+
+float RainGauge::currentDay(void)
+{
+    return rainState.valid ? rainState.total - rainState.dayStart : -1;
+}
+
+float RainGauge::currentWeek(void)
+{
+    return rainState.valid ? rainState.total - rainState.weekStart : -1;
+}
+
+float RainGauge::currentMonth(void)
+{
+    return rainState.valid ? rainState.total - rainState.monthStart : -1;
+}
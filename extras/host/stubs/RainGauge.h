@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+// RainGauge.h
+//
+// Host-native stand-in for BresserWeatherSensorReceiver's RainGauge
+//
+// - Simplified rain statistics: past 60 minutes, current day, week and month
+// - State is kept in retained memory
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file RainGauge.h
+ *  \brief Host-native stand-in for BresserWeatherSensorReceiver's RainGauge
+ */
+
+#if !defined(_HOST_RAINGAUGE_H)
+#define _HOST_RAINGAUGE_H
+
+#include <Arduino.h>
+
+// Flags for reset()
+#define RESET_RAIN_H 1  //!< reset past hour
+#define RESET_RAIN_D 2  //!< reset current day
+#define RESET_RAIN_W 4  //!< reset current week
+#define RESET_RAIN_M 8  //!< reset current month
+
+/// Rain gauge statistics
+class RainGauge
+{
+public:
+    RainGauge(const float raingauge_max = 100000) : raingaugeMax(raingauge_max) {};
+
+    void set_max(float raingauge_max)
+    {
+        raingaugeMax = raingauge_max;
+    };
+    void setUpdateRate(uint8_t rate)
+    {
+        updateRate = rate;
+    };
+    void reset(uint8_t flags = 0xF);
+    void update(time_t timestamp, float rain, bool startup = false);
+    float pastHour(bool *valid = nullptr, int *nbins = nullptr, float *quality = nullptr);
+    float currentDay(void);
+    float currentWeek(void);
+    float currentMonth(void);
+
+private:
+    float raingaugeMax;      //!< rain gauge counter overflow value
+    uint8_t updateRate = 0;  //!< update rate in minutes (unused)
+};
+
+#endif // _HOST_RAINGAUGE_H
@@ -0,0 +1,369 @@
+///////////////////////////////////////////////////////////////////////////////
+// WeatherSensor.cpp
+//
+// Host-native stand-in for BresserWeatherSensorReceiver's WeatherSensor
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file WeatherSensor.cpp
+ *  \brief Host-native stand-in for BresserWeatherSensorReceiver's WeatherSensor
+ */
+
+#include "WeatherSensor.h"
+#include "../HostSim.h"
+
+/// Time after which getMessage() returns if no message was received in ms
+#define RX_POLL_MS 100
+
+/// Duration of a sensor message in ms
+#define RX_MESSAGE_MS 20
+
+/// Simulated sensor
+struct sSimSensor
+{
+    uint8_t s_type;    //!< sensor type
+    uint8_t chan;      //!< channel
+    uint8_t decoder;   //!< decoder bitmap
+    uint32_t periodMs; //!< transmit period
+};
+
+/// Simulated sensors
+static const sSimSensor simSensors[] = {
+    {SENSOR_TYPE_WEATHER1, 0, 0x02, 12000},
+    {SENSOR_TYPE_THERMO_HYGRO, 1, 0x02, 47000},
+    {SENSOR_TYPE_SOIL, 1, 0x02, 61000},
+    {SENSOR_TYPE_LIGHTNING, 0, 0x08, 59000}};
+
+#define SIM_SENSORS (sizeof(simSensors) / sizeof(simSensors[0]))
+
+/*!
+ * \brief Hash function (MurmurHash3 finalizer)
+ *
+ * Used to derive sensor IDs and transmit phases from the seed without
+ * consuming random numbers.
+ */
+static uint32_t hash32(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x85EBCA6BUL;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35UL;
+    x ^= x >> 16;
+    return x;
+}
+
+/*!
+ * \brief Get sensor ID
+ *
+ * \param i simulated sensor index
+ */
+static uint32_t simId(size_t i)
+{
+    return hash32(hostSim->cfg.seed * SIM_SENSORS + i + 1) | 0x01000000UL;
+}
+
+/*!
+ * \brief Get time of next transmission
+ *
+ * \param i   simulated sensor index
+ * \param now true time in ms
+ *
+ * \returns true time of next transmission (>= now) in ms
+ */
+static uint64_t simNextTx(size_t i, uint64_t now)
+{
+    uint64_t period = simSensors[i].periodMs;
+    uint64_t phase = simId(i) % period;
+    return now + (phase + period - now % period) % period;
+}
+
+/*!
+ * \brief Set sensor data
+ *
+ * \param s sensor slot
+ * \param i simulated sensor index
+ * \param t true time in s
+ */
+static void simData(WeatherSensor::Sensor &s, size_t i, uint64_t t)
+{
+    const sSimSensor &sim = simSensors[i];
+    double elapsed = static_cast<double>(t - hostSim->cfg.startEpoch);
+    double day = 2 * M_PI * (t % 86400) / 86400.0;
+
+    memset(&s, 0, sizeof(s));
+    s.sensor_id = simId(i);
+    s.s_type = sim.s_type;
+    s.chan = sim.chan;
+    s.decoder = sim.decoder;
+    s.battery_ok = true;
+    s.valid = true;
+    s.complete = true;
+    s.rssi = -60.0 - (s.sensor_id % 30);
+
+    switch (sim.s_type)
+    {
+    case SENSOR_TYPE_WEATHER1:
+        s.w.temp_ok = true;
+        s.w.temp_c = roundf(10 * (12.0 - 8.0 * cos(day))) / 10;
+        s.w.humidity_ok = true;
+        s.w.humidity = 65 + 20 * cos(day);
+        s.w.wind_ok = true;
+        s.w.wind_avg_meter_sec_fp1 = 25 + 15 * sin(day);
+        s.w.wind_gust_meter_sec_fp1 = s.w.wind_avg_meter_sec_fp1 + 12;
+        s.w.wind_direction_deg_fp1 = (t / 60 % 360) * 10;
+        s.w.rain_ok = true;
+        // 1 mm/h, rain counter wraps at 100000 mm
+        s.w.rain_mm = fmod(floor(elapsed / 360.0) / 10, 100000.0);
+        s.w.uv_ok = true;
+        s.w.uv = roundf(10 * max(0.0, 6.0 * -cos(day))) / 10;
+        break;
+
+    case SENSOR_TYPE_THERMO_HYGRO:
+        s.w.temp_ok = true;
+        s.w.temp_c = roundf(10 * (20.0 - 2.0 * cos(day))) / 10;
+        s.w.humidity_ok = true;
+        s.w.humidity = 45 + 5 * cos(day);
+        break;
+
+    case SENSOR_TYPE_SOIL:
+        s.soil.temp_c = roundf(10 * (14.0 - 3.0 * cos(day))) / 10;
+        s.soil.moisture = 40 + 10 * cos(day);
+        break;
+
+    case SENSOR_TYPE_LIGHTNING:
+        // One strike every two hours
+        s.lgt.strike_count = static_cast<uint64_t>(elapsed / 7200) % 1600;
+        s.lgt.distance_km = 5 + (t / 7200) % 20;
+        break;
+    }
+}
+
+int16_t WeatherSensor::begin(uint8_t max_sensors_default, bool init_filters)
+{
+    (void)init_filters;
+    sensor.resize(max_sensors_default);
+    clearSlots();
+    delay(5);
+    return 0;
+}
+
+void WeatherSensor::clearSlots(uint8_t type)
+{
+    for (Sensor &s : sensor)
+    {
+        if ((type == 0xFF) || (s.s_type == type))
+        {
+            s.valid = false;
+            s.complete = false;
+        }
+    }
+}
+
+int WeatherSensor::getMessage(void)
+{
+    uint64_t now = hostSim->trueUs / 1000;
+    size_t next = 0;
+    uint64_t nextTx = UINT64_MAX;
+    for (size_t i = 0; i < SIM_SENSORS; i++)
+    {
+        uint64_t tx = simNextTx(i, now);
+        if (tx < nextTx)
+        {
+            nextTx = tx;
+            next = i;
+        }
+    }
+
+    if (nextTx - now > RX_POLL_MS)
+    {
+        delay(RX_POLL_MS);
+        return DECODE_INVALID;
+    }
+    delay(nextTx - now + RX_MESSAGE_MS);
+
+    if (!((enDecoders & simSensors[next].decoder) && !hostSimChance(hostSim->cfg.rxLoss)))
+    {
+        return DECODE_INVALID;
+    }
+
+    // Find slot with same ID or first free slot
+    Sensor *slot = nullptr;
+    for (Sensor &s : sensor)
+    {
+        if (s.valid && (s.sensor_id == simId(next)))
+        {
+            slot = &s;
+            break;
+        }
+    }
+    for (size_t i = 0; !slot && (i < sensor.size()); i++)
+    {
+        if (!sensor[i].valid)
+        {
+            slot = &sensor[i];
+        }
+    }
+    if (!slot)
+    {
+        return DECODE_FULL;
+    }
+    simData(*slot, next, nextTx / 1000);
+    return DECODE_OK;
+}
+
+int WeatherSensor::findType(uint8_t type, uint8_t channel)
+{
+    for (size_t i = 0; i < sensor.size(); i++)
+    {
+        if (sensor[i].valid && (sensor[i].s_type == type) && ((channel == 0xFF) || (sensor[i].chan == channel)))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool WeatherSensor::allSlotsFilled(uint8_t flags)
+{
+    for (const Sensor &s : sensor)
+    {
+        if (!s.valid || ((flags & DATA_COMPLETE) && !s.complete))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WeatherSensor::getData(uint32_t timeout, uint8_t flags, uint8_t type, void (*func)())
+{
+    (void)type;
+    uint32_t timestamp = millis();
+    while (millis() - timestamp < timeout)
+    {
+        if (func)
+        {
+            func();
+        }
+        if ((getMessage() == DECODE_OK) && !(flags & DATA_ALL_SLOTS))
+        {
+            return true;
+        }
+        if ((flags & DATA_ALL_SLOTS) && allSlotsFilled(flags))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WeatherSensor::genMessage(int i, uint32_t id, uint8_t s_type, uint8_t channel)
+{
+    if (static_cast<size_t>(i) >= sensor.size())
+    {
+        sensor.resize(i + 1);
+    }
+    Sensor &s = sensor[i];
+    memset(&s, 0, sizeof(s));
+    s.sensor_id = id;
+    s.s_type = s_type;
+    s.chan = channel;
+    s.startup = false;
+    s.battery_ok = true;
+    s.valid = true;
+    s.complete = true;
+    s.rssi = 88.8;
+
+    if ((s_type == SENSOR_TYPE_WEATHER0) || (s_type == SENSOR_TYPE_WEATHER1))
+    {
+        s.w.temp_ok = true;
+        s.w.temp_c = 22.2;
+        s.w.humidity_ok = true;
+        s.w.humidity = 55;
+        s.w.wind_ok = true;
+        s.w.wind_direction_deg_fp1 = 2700;
+        s.w.wind_gust_meter_sec_fp1 = 33;
+        s.w.wind_avg_meter_sec_fp1 = 22;
+        s.w.rain_ok = true;
+        s.w.rain_mm = 9.9;
+        s.w.uv_ok = true;
+        s.w.uv = 7.7;
+    }
+    else if (s_type == SENSOR_TYPE_SOIL)
+    {
+        s.soil.temp_c = 7.7;
+        s.soil.moisture = 50;
+    }
+    return true;
+}
+
+uint8_t WeatherSensor::getSensorsInc(uint8_t *payload)
+{
+    (void)payload;
+    return 0;
+}
+
+uint8_t WeatherSensor::getSensorsExc(uint8_t *payload)
+{
+    (void)payload;
+    return 0;
+}
+
+void WeatherSensor::setSensorsInc(uint8_t *bytes, uint8_t size)
+{
+    (void)bytes;
+    (void)size;
+}
+
+void WeatherSensor::setSensorsExc(uint8_t *bytes, uint8_t size)
+{
+    (void)bytes;
+    (void)size;
+}
+
+void WeatherSensor::getSensorsCfg(uint8_t &maxSensors, uint8_t &rxFlags, uint8_t &enDecoders)
+{
+    maxSensors = sensor.size();
+    rxFlags = this->rxFlags;
+    enDecoders = this->enDecoders;
+}
+
+void WeatherSensor::setSensorsCfg(uint8_t maxSensors, uint8_t rxFlags, uint8_t enDecoders)
+{
+    sensor.resize(maxSensors);
+    this->rxFlags = rxFlags;
+    this->enDecoders = enDecoders;
+}
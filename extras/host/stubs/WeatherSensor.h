@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+// WeatherSensor.h
+//
+// Host-native stand-in for BresserWeatherSensorReceiver's WeatherSensor
+//
+// - Simulated 868 MHz sensors transmit periodically in true (virtual) time:
+//   weather sensor (type 1, ch 0), thermo-/hygrometer (type 2, ch 1),
+//   soil moisture sensor (type 4, ch 1) and lightning sensor (type 9, ch 0)
+// - Messages are lost with probability rxLoss (see HostSim.h)
+// - Sensor values are deterministic functions of time
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file WeatherSensor.h
+ *  \brief Host-native stand-in for BresserWeatherSensorReceiver's WeatherSensor
+ */
+
+#if !defined(_HOST_WEATHERSENSOR_H)
+#define _HOST_WEATHERSENSOR_H
+
+#include <Arduino.h>
+#include <vector>
+#include "WeatherSensorCfg.h"
+
+// Sensor types
+#define SENSOR_TYPE_WEATHER0 0     //!< Weather Station
+#define SENSOR_TYPE_WEATHER1 1     //!< Weather Station
+#define SENSOR_TYPE_THERMO_HYGRO 2 //!< Thermo-/Hygro-Sensor
+#define SENSOR_TYPE_POOL_THERMO 3  //!< Pool / Spa Thermometer
+#define SENSOR_TYPE_SOIL 4         //!< Soil Temperature and Moisture
+#define SENSOR_TYPE_LEAKAGE 5      //!< Water Leakage
+#define SENSOR_TYPE_AIR_PM 8       //!< Air Quality Sensor (Particle Matter)
+#define SENSOR_TYPE_LIGHTNING 9    //!< Lightning Sensor
+#define SENSOR_TYPE_CO2 10         //!< CO2 Sensor
+#define SENSOR_TYPE_HCHO_VOC 11    //!< Air Quality Sensor (HCHO and VOC)
+#define SENSOR_TYPE_WEATHER3 12    //!< Weather Station (3-in-1)
+#define SENSOR_TYPE_WEATHER8 13    //!< Weather Station (8-in-1)
+
+// Receive flags
+#define DATA_COMPLETE 0x1  //!< only complete data sets are valid
+#define DATA_TYPE 0x2      //!< only sensors of the given type
+#define DATA_ALL_SLOTS 0x4 //!< all slots have to be filled
+
+// Decoder status
+#define DECODE_INVALID 0 //!< no message decoded
+#define DECODE_OK 1      //!< message decoded
+#define DECODE_FULL 6    //!< all slots are in use
+
+/// Weather sensor receiver
+class WeatherSensor
+{
+public:
+    /// Weather station data
+    struct Weather
+    {
+        bool temp_ok;
+        bool humidity_ok;
+        bool light_ok;
+        bool uv_ok;
+        bool wind_ok;
+        bool rain_ok;
+        bool tglobe_ok;
+        float temp_c;
+        float light_klx;
+        float light_lux;
+        float uv;
+        float rain_mm;
+        uint16_t wind_direction_deg_fp1;
+        uint16_t wind_gust_meter_sec_fp1;
+        uint16_t wind_avg_meter_sec_fp1;
+        uint8_t humidity;
+        float tglobe_c;
+    };
+
+    /// Soil temperature and moisture sensor data
+    struct Soil
+    {
+        float temp_c;
+        uint8_t moisture;
+    };
+
+    /// Water leakage sensor data
+    struct Leakage
+    {
+        bool alarm;
+    };
+
+    /// Air quality (particulate matter) sensor data
+    struct AirPM
+    {
+        uint16_t pm_1_0;
+        uint16_t pm_2_5;
+        uint16_t pm_10;
+        bool pm_1_0_init;
+        bool pm_2_5_init;
+        bool pm_10_init;
+    };
+
+    /// Lightning sensor data
+    struct Lightning
+    {
+        uint8_t distance_km;
+        uint16_t strike_count;
+    };
+
+    /// CO2 sensor data
+    struct AirCO2
+    {
+        uint16_t co2_ppm;
+        bool co2_init;
+    };
+
+    /// Air quality (HCHO/VOC) sensor data
+    struct AirVOC
+    {
+        uint16_t hcho_ppb;
+        uint8_t voc_level;
+        bool hcho_init;
+        bool voc_init;
+    };
+
+    /// Sensor slot
+    struct Sensor
+    {
+        uint32_t sensor_id; //!< sensor ID
+        uint8_t s_type;     //!< sensor type
+        uint8_t chan;       //!< channel
+        uint8_t decoder;    //!< decoder bitmap
+        bool startup;       //!< sensor restarted
+        bool battery_ok;    //!< battery o.k.
+        bool valid;         //!< data valid
+        bool complete;      //!< data complete
+        float rssi;         //!< received signal strength
+        union
+        {
+            struct Weather w;
+            struct Soil soil;
+            struct Leakage leak;
+            struct AirPM pm;
+            struct Lightning lgt;
+            struct AirCO2 co2;
+            struct AirVOC voc;
+        };
+    };
+
+    std::vector<Sensor> sensor; //!< sensor data slots
+    uint8_t rxFlags = 0;        //!< receive flags
+    uint8_t enDecoders = 0xFF;  //!< enabled decoders
+
+    int16_t begin(uint8_t max_sensors_default = MAX_SENSORS_DEFAULT, bool init_filters = true);
+    void setRxCfg(uint8_t flags)
+    {
+        rxFlags = flags;
+    };
+    void clearSlots(uint8_t type = 0xFF);
+    bool getData(uint32_t timeout, uint8_t flags = 0, uint8_t type = 0, void (*func)() = NULL);
+    int getMessage(void);
+    bool genMessage(int i, uint32_t id = 0xff, uint8_t s_type = 1, uint8_t channel = 0);
+    int findType(uint8_t type, uint8_t channel = 0xFF);
+
+    // Sensor include/exclude lists and configuration are not persisted
+    uint8_t getSensorsInc(uint8_t *payload);
+    uint8_t getSensorsExc(uint8_t *payload);
+    void setSensorsInc(uint8_t *bytes, uint8_t size);
+    void setSensorsExc(uint8_t *bytes, uint8_t size);
+    void getSensorsCfg(uint8_t &maxSensors, uint8_t &rxFlags, uint8_t &enDecoders);
+    void setSensorsCfg(uint8_t maxSensors, uint8_t rxFlags, uint8_t enDecoders);
+
+private:
+    bool allSlotsFilled(uint8_t flags);
+};
+
+#endif // _HOST_WEATHERSENSOR_H
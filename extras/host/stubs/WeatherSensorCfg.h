@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////
+// WeatherSensorCfg.h
+//
+// Host-native stand-in for BresserWeatherSensorReceiver's WeatherSensorCfg.h
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file WeatherSensorCfg.h
+ *  \brief Host-native stand-in for BresserWeatherSensorReceiver's WeatherSensorCfg.h
+ */
+
+#if !defined(_HOST_WEATHERSENSORCFG_H)
+#define _HOST_WEATHERSENSORCFG_H
+
+#include <Arduino.h>
+
+/// Default number of sensor slots
+#define MAX_SENSORS_DEFAULT 1
+
+// Enabled decoders
+#define BRESSER_5_IN_1
+#define BRESSER_6_IN_1
+#define BRESSER_7_IN_1
+#define BRESSER_LIGHTNING
+#define BRESSER_LEAKAGE
+
+#endif // _HOST_WEATHERSENSORCFG_H
@@ -33,10 +33,19 @@
 // port = CMD_SET_SENSORS_EXC, {"sensors_exc": [<sensors_exc0>, ..., <sensors_excN>]}
 // port = CMD_GET_APP_PAYLOAD_CFG, {"cmd": "CMD_GET_APP_PAYLOAD_CFG"} / payload = 0x00
 // port = CMD_SET_APP_PAYLOAD_CFG, ["bresser": [<type0>, ... <type15>], "onewire": <onewire>, "analog": <analog>, "digital": <digital>]
+// port = CMD_GET_PAYLOAD_LAYOUT, {"cmd": "CMD_GET_PAYLOAD_LAYOUT"} / payload = 0x00
+// port = CMD_RESET_PAYLOAD_DELTA, {"cmd": "CMD_RESET_PAYLOAD_DELTA"} / payload = 0x00
+// port = CMD_GET_ONEWIRE_RES, {"cmd": "CMD_GET_ONEWIRE_RES"} / payload = 0x00
+// port = CMD_SET_ONEWIRE_RES, {"onewire_res": [<onewire_res0>, ..., <onewire_resN>]}
 // port = CMD_GET_BLE_ADDR, {"cmd": "CMD_GET_BLE_ADDR"} / payload = 0x00
 // port = CMD_SET_BLE_ADDR, {"ble_addr": [<ble_addr0>, ..., <ble_addrN>]}
 // port = CMD_GET_BLE_CONFIG, {"cmd": "CMD_GET_BLE_CONFIG"} / payload = 0x00
 // port = CMD_SET_BLE_CONFIG, {"ble_active": <ble_active>, "ble_scantime": <ble_scantime>}
+// port = CMD_GET_WAKE_TRACE, {"cmd": "CMD_GET_WAKE_TRACE"} / payload = 0x00
+//                            {"wake_trace_stage": <first_stage>}
+// port = CMD_GET_JOIN_HISTORY, {"cmd": "CMD_GET_JOIN_HISTORY"} / payload = 0x00
+// port = CMD_MULTI, {"commands": [{<command0>}, ..., {<commandN>}]}
+//                   (<commandN>: any of the above, encoded as <port>, <length>, <payload>)
 //
 // Responses:
 // -----------
@@ -62,10 +71,22 @@
 //
 // CMD_GET_APP_PAYLOAD_CFG {"bresser": [<type0>, <type1>, ..., <type15>], "onewire": <onewire>, "analog": <analog>, "digital": <digital>}
 //
+// CMD_GET_PAYLOAD_LAYOUT {"max_len": <max_len>, "size": <size>, "ble": <ble>, "dropped": <dropped>,
+//                         "bresser": [<type0>, <type1>, ..., <type15>], "onewire": <onewire>, "analog": <analog>, "digital": <digital>}
+//
+// CMD_GET_ONEWIRE_RES {"onewire_res": [<onewire_res0>, ..., <onewire_res15>]}
+//
 // CMD_GET_BLE_ADDR {"ble_addr": [<ble_addr0>, ...]}
 //
 // CMD_GET_BLE_CONFIG {"ble_active": <ble_active>, "ble_scantime": <ble_scantime>}
 //
+// CMD_GET_WAKE_TRACE {"cycles": <cycles>, "wake_trace": {<stage>: {"min_ms": <min_ms>, "avg_ms": <avg_ms>, "max_ms": <max_ms>}, ...}}
+// CMD_MULTI {<response0>, ..., <responseN>} (responses combined in one object)
+//
+// CMD_GET_JOIN_HISTORY {"join_attempts": <join_attempts>, "join_duration_s": <join_duration_s>, "join_airtime_ms": <join_airtime_ms>,
+//                       "join_max_hour_attempts": <join_max_hour_attempts>, "join_max_hour_airtime_ms": <join_max_hour_airtime_ms>,
+//                       "join_dr": <join_dr>}
+//
 // <ws_timeout>         : 0...255
 // <sleep_interval>     : 0...65535
 // <sleep_interval>     : 0...65535
@@ -86,8 +107,16 @@
 // <typeN>              : Bitmap for enabling Bresser sensors of type N; each bit position corresponds to a channel, e.g. bit 0 controls ch0; 
 //                        unused bits can be used to select features
 // <onewire>            : Bitmap for enabling 1-Wire sensors; each bit position corresponds to an index
+// <onewire_resN>       : Resolution of 1-Wire sensor with index N in bits (9...12); N: 0...15
 // <analog>             : Bitmap for enabling analog input channels; each bit positions corresponds to a channel
 // <digital>            : Bitmap for enabling digital input channels in a broad sense &mdash; GPIO, SPI, I2C, UART, ...
+// <first_stage>        : First wake cycle stage to be reported (0...10); max. 8 stages per response
+// <join_attempts>      : Number of join requests until the last successful join
+// <join_duration_s>    : Time from first to last join request in seconds
+// <join_airtime_ms>    : Total airtime of join requests in ms
+// <join_max_hour_attempts>: Max. number of join requests per hour
+// <join_max_hour_airtime_ms>: Max. airtime of join requests per hour in ms
+// <join_dr>            : Data rate of last join request (255: default)
 //
 //
 // Based on:
@@ -142,6 +171,12 @@
 // 20250905 Renamed status_interval to app_status_interval
 //          Renamed ble_timeout to ble_scantime
 //          Added module exports
+// 20261016 Added CMD_GET_WAKE_TRACE
+//          Added CMD_GET_PAYLOAD_LAYOUT
+//          Added CMD_RESET_PAYLOAD_DELTA
+//          Added CMD_MULTI
+//          Added CMD_GET_JOIN_HISTORY
+//          Added CMD_GET_ONEWIRE_RES/CMD_SET_ONEWIRE_RES
 //
 // ToDo:
 // -  
@@ -156,11 +191,18 @@ const CMD_SET_SLEEP_INTERVAL_LONG = 0x33;
 const CMD_SET_LW_STATUS_INTERVAL = 0x35;
 const CMD_GET_LW_CONFIG = 0x36;
 const CMD_GET_LW_STATUS = 0x38;
+const CMD_GET_WAKE_TRACE = 0x3A;
+const CMD_MULTI = 0x3C;
+const CMD_GET_JOIN_HISTORY = 0x3E;
 const CMD_GET_APP_STATUS_INTERVAL = 0x40;
 const CMD_SET_APP_STATUS_INTERVAL = 0x41;
 const CMD_GET_SENSORS_STAT = 0x42;
 const CMD_GET_APP_PAYLOAD_CFG = 0x46;
 const CMD_SET_APP_PAYLOAD_CFG = 0x47;
+const CMD_GET_PAYLOAD_LAYOUT = 0x48;
+const CMD_RESET_PAYLOAD_DELTA = 0x49;
+const CMD_GET_ONEWIRE_RES = 0x4A;
+const CMD_SET_ONEWIRE_RES = 0x4B;
 const CMD_GET_WS_TIMEOUT = 0xC0;
 const CMD_SET_WS_TIMEOUT = 0xC1;
 const CMD_RESET_WS_POSTPROC = 0xC3;
@@ -178,6 +220,9 @@ const CMD_SET_BLE_CONFIG = 0xD1;
 const CMD_GET_BLE_ADDR = 0xD2;
 const CMD_SET_BLE_ADDR = 0xD3;
 
+// Max. downlink payload size in bytes (MAX_DOWNLINK_SIZE in BresserWeatherSensorLWCfg.h)
+const MAX_DOWNLINK_SIZE = 51;
+
 
 // Source of Real Time Clock setting
 var rtc_source_code = {
@@ -275,6 +320,40 @@ function encodeDownlink(input) {
     var k;
     var output = [];
     var value;
+    if (input.data.hasOwnProperty('commands')) {
+        // Multiple commands: <port>, <length>, <payload>, ...
+        for (i = 0; i < input.data.commands.length; i++) {
+            var res = encodeDownlink({ data: input.data.commands[i] });
+            if (res.errors.length > 0) {
+                return {
+                    bytes: [],
+                    warnings: [],
+                    errors: ["'commands[" + i + "]': " + res.errors[0]]
+                };
+            }
+            if (res.fPort === CMD_MULTI) {
+                return {
+                    bytes: [],
+                    warnings: [],
+                    errors: ["'commands[" + i + "]': Nested commands not allowed"]
+                };
+            }
+            output = output.concat([res.fPort, res.bytes.length], res.bytes);
+        }
+        if (output.length > MAX_DOWNLINK_SIZE) {
+            return {
+                bytes: [],
+                warnings: [],
+                errors: ["Downlink size " + output.length + " exceeds " + MAX_DOWNLINK_SIZE + " bytes"]
+            };
+        }
+        return {
+            bytes: output,
+            fPort: CMD_MULTI,
+            warnings: [],
+            errors: []
+        };
+    }
     if (input.data.hasOwnProperty('cmd')) {
         if (input.data.cmd == "CMD_GET_DATETIME") {
             return {
@@ -300,6 +379,22 @@ function encodeDownlink(input) {
                 errors: []
             };
         }
+        else if (input.data.cmd == "CMD_GET_WAKE_TRACE") {
+            return {
+                bytes: [0],
+                fPort: CMD_GET_WAKE_TRACE,
+                warnings: [],
+                errors: []
+            };
+        }
+        else if (input.data.cmd == "CMD_GET_JOIN_HISTORY") {
+            return {
+                bytes: [0],
+                fPort: CMD_GET_JOIN_HISTORY,
+                warnings: [],
+                errors: []
+            };
+        }
         else if (input.data.cmd == "CMD_GET_WS_TIMEOUT") {
             return {
                 bytes: [0],
@@ -364,6 +459,30 @@ function encodeDownlink(input) {
                 errors: []
             };
         }
+        else if (input.data.cmd == "CMD_GET_PAYLOAD_LAYOUT") {
+            return {
+                bytes: [0],
+                fPort: CMD_GET_PAYLOAD_LAYOUT,
+                warnings: [],
+                errors: []
+            };
+        }
+        else if (input.data.cmd == "CMD_RESET_PAYLOAD_DELTA") {
+            return {
+                bytes: [0],
+                fPort: CMD_RESET_PAYLOAD_DELTA,
+                warnings: [],
+                errors: []
+            };
+        }
+        else if (input.data.cmd == "CMD_GET_ONEWIRE_RES") {
+            return {
+                bytes: [0],
+                fPort: CMD_GET_ONEWIRE_RES,
+                warnings: [],
+                errors: []
+            };
+        }
         else if (input.data.cmd == "CMD_GET_BLE_ADDR") {
             return {
                 bytes: [0],
@@ -403,6 +522,14 @@ function encodeDownlink(input) {
             errors: []
         };
     }
+    else if (input.data.hasOwnProperty('wake_trace_stage')) {
+        return {
+            bytes: [input.data.wake_trace_stage],
+            fPort: CMD_GET_WAKE_TRACE,
+            warnings: [],
+            errors: []
+        };
+    }
     else if (input.data.hasOwnProperty('lw_status_interval')) {
         return {
             bytes: [input.data.lw_status_interval],
@@ -580,6 +707,31 @@ function encodeDownlink(input) {
             warnings: [],
             errors: []
         };
+    } else if (input.data.hasOwnProperty('onewire_res')) {
+        if ((input.data.onewire_res.length < 1) || (input.data.onewire_res.length > 16)) {
+            return {
+                bytes: [],
+                warnings: [],
+                errors: ["<onewire_res>: expected 1...16 values, got " + input.data.onewire_res.length]
+            };
+        }
+        output = [];
+        for (i = 0; i < input.data.onewire_res.length; i++) {
+            if ((input.data.onewire_res[i] < 9) || (input.data.onewire_res[i] > 12)) {
+                return {
+                    bytes: [],
+                    warnings: [],
+                    errors: ["'onewire_res': Invalid resolution (9...12)"]
+                };
+            }
+            output[i] = input.data.onewire_res[i];
+        }
+        return {
+            bytes: output,
+            fPort: CMD_SET_ONEWIRE_RES,
+            warnings: [],
+            errors: []
+        };
     } else if (input.data.hasOwnProperty('ble_addr')) {
         output = [];
         k = 0;
@@ -617,9 +769,26 @@ function encodeDownlink(input) {
 // Decode Downlink from bytes to JSON
 function decodeDownlink(input) {
     switch (input.fPort) {
+        case CMD_MULTI:
+            var commands = [];
+            for (var i = 0; i + 2 <= input.bytes.length; i += 2 + input.bytes[i + 1]) {
+                var res = decodeDownlink({
+                    fPort: input.bytes[i],
+                    bytes: input.bytes.slice(i + 2, i + 2 + input.bytes[i + 1])
+                });
+                commands.push({ port: input.bytes[i], data: res.data });
+            }
+            return {
+                data: {
+                    commands: commands
+                },
+                warnings: [],
+                errors: []
+            };
         case CMD_GET_DATETIME:
         case CMD_GET_LW_CONFIG:
         case CMD_GET_LW_STATUS:
+        case CMD_GET_JOIN_HISTORY:
         case CMD_GET_WS_TIMEOUT:
         case CMD_GET_WS_POSTPROC:
         case CMD_GET_APP_STATUS_INTERVAL:
@@ -628,6 +797,9 @@ function decodeDownlink(input) {
         case CMD_GET_SENSORS_EXC:
         case CMD_GET_SENSORS_CFG:
         case CMD_GET_APP_PAYLOAD_CFG:
+        case CMD_GET_PAYLOAD_LAYOUT:
+        case CMD_RESET_PAYLOAD_DELTA:
+        case CMD_GET_ONEWIRE_RES:
         case CMD_GET_BLE_ADDR:
         case CMD_GET_BLE_CONFIG:
             return {
@@ -653,6 +825,14 @@ function decodeDownlink(input) {
                     sleep_interval_long: uint16BE(input.bytes)
                 }
             };
+        case CMD_GET_WAKE_TRACE:
+            return {
+                data: {
+                    wake_trace_stage: uint8(input.bytes)
+                },
+                warnings: [],
+                errors: []
+            };
         case CMD_SET_LW_STATUS_INTERVAL:
             return {
                 data: {
@@ -718,6 +898,12 @@ function decodeDownlink(input) {
                     digital: hex32(input.bytes.slice(20, 24))
                 }
             };
+        case CMD_SET_ONEWIRE_RES:
+            return {
+                data: {
+                    onewire_res: Array.from(input.bytes)
+                }
+            };
         case CMD_SET_BLE_ADDR:
             return {
                 data: {
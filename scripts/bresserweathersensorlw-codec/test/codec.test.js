@@ -33,6 +33,17 @@
 // History:
 //
 // 20250903 Created
+// 20261016 Added CMD_GET_WAKE_TRACE
+//          Added payload schema tests
+//          Added CMD_GET_PAYLOAD_LAYOUT
+//          Added sensor data fragment reassembly tests
+//          Added sensor data delta frame and CMD_RESET_PAYLOAD_DELTA tests
+//          Added batched sensor data test
+//          Added backfilled sensor data test
+//          Added CMD_MULTI tests
+//          Added coalesced status uplink test
+//          Added CMD_GET_JOIN_HISTORY tests
+//          Added CMD_GET_ONEWIRE_RES/CMD_SET_ONEWIRE_RES tests
 //
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -95,12 +106,241 @@ test('decodeUplink() -> CMD_GET_LW_STATUS response', () => {
     assert.deepEqual(res.data, { bytes: { ubatt_mv: 3700, long_sleep: 0 } }, 'data should match expected value');
 });
 
+test('decodeUplink() -> CMD_GET_LW_STATUS response with energy accounting', () => {
+    const uplinkBytes = Buffer.from([0x74, 0x0E, 0x00, 0x2C, 0x01, 0xD2, 0x04]);
+    const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0x38 });
+    assert.deepEqual(res.data, {
+        bytes: { ubatt_mv: 3700, long_sleep: 0, cycle_charge_mas: 300, consumption_mah_day: '123.4' }
+    }, 'data should match expected value');
+});
+
+test('uplink formatter payload schema matches src/PayloadSchema.h', (t) => {
+    const fs = require('fs');
+    const path = require('path');
+    const header = path.join(__dirname, '..', '..', '..', 'src', 'PayloadSchema.h');
+    if (!fs.existsSync(header)) {
+        t.skip('src/PayloadSchema.h not available');
+        return;
+    }
+    const gen = require('../../gen_payload_schema.js');
+    const expected = gen.formatSchema(gen.parseSchema(fs.readFileSync(header, 'utf8')));
+    const formatter = fs.readFileSync(path.join(__dirname, '..', 'uplink_formatter.js'), 'utf8');
+    assert.equal(gen.extractSchema(formatter), expected, 'run scripts/gen_payload_schema.js');
+});
+
+test('uplink formatter schema_mask() -> sensor data (port 1)', () => {
+    // Helper functions are exported by the uplink formatter on first use
+    codec.decodeUplink({ bytes: Buffer.from([0xFF]), fPort: 0xC0 });
+    const formatter = require('../uplink_formatter.js');
+    let cfg = new Array(24).fill(0);
+    cfg[1] = 0x07; // Weather sensor: humidity, wind
+    cfg[2] = 0x02; // Thermo/hygro sensor: ch 1
+    cfg[9] = 0x11; // Lightning sensor: raw data
+    const schema = formatter.schema_mask(cfg);
+    assert.deepEqual(schema.names, [
+        'ws_temp_c', 'ws_humidity', 'ws_wind_avg_ms', 'ws_wind_gust_ms', 'ws_wind_dir_deg',
+        'th1_temp_c', 'th1_humidity',
+        'lgt_storm_dist_km', 'lgt_strike_count'
+    ], 'names should match expected value');
+    const uplinkBytes = [
+        0x08, 0xDE, 0x37, 0x0C, 0x00, 0x19, 0x00, 0x08, 0x07,
+        0x7F, 0xFF, 0xFF,
+        0x05, 0x2A, 0x00
+    ];
+    const res = formatter.decode(1, uplinkBytes, schema.mask, schema.names);
+    assert.deepEqual(res, {
+        ws_temp_c: '22.7', ws_humidity: 55, ws_wind_avg_ms: '1.2', ws_wind_gust_ms: '2.5', ws_wind_dir_deg: '180.0',
+        th1_temp_c: '327.7', th1_humidity: 255,
+        lgt_storm_dist_km: 5, lgt_strike_count: 42
+    }, 'data should match expected value');
+});
+
+test('decodeUplink() -> sensor data fragments (port 2)', () => {
+    let payload = [];
+    for (let i = 0; i < 51; i++) {
+        payload.push(i);
+    }
+    const expected = codec.decodeUplink({ bytes: Buffer.from(payload), fPort: 1 });
+
+    // seq 3, fragments of 10 bytes; received out of order
+    let fragments = [];
+    for (let idx = 0; idx * 10 < payload.length; idx++) {
+        const last = ((idx + 1) * 10 >= payload.length) ? 0x08 : 0x00;
+        fragments.push(Buffer.from([(3 << 4) | last | idx].concat(payload.slice(idx * 10, (idx + 1) * 10))));
+    }
+    assert.equal(fragments.length, 6, 'should be 6 fragments');
+    const order = [0, 1, 2, 5, 3];
+    for (const idx of order) {
+        const res = codec.decodeUplink({ bytes: fragments[idx], fPort: 2 });
+        assert.equal(res.data.bytes.fragment.seq, 3, 'seq should be 3');
+        assert.equal(res.data.bytes.fragment.idx, idx, 'idx should match');
+        assert.equal(res.data.bytes.fragment.last, idx === 5, 'last should match');
+    }
+    assert.equal(codec.decodeUplink({ bytes: fragments[0], fPort: 2 }).data.bytes.fragment.data,
+        '00010203040506070809', 'data should match expected value');
+
+    // Fragment 0 restarts the message
+    for (const idx of [1, 2, 3, 5]) {
+        assert.ok('fragment' in codec.decodeUplink({ bytes: fragments[idx], fPort: 2 }).data.bytes);
+    }
+    const res = codec.decodeUplink({ bytes: fragments[4], fPort: 2 });
+    assert.deepEqual(res.data, expected.data, 'reassembled data should match port 1 data');
+});
+
+test('decodeUplink() -> sensor data delta frames (port 3)', () => {
+    let keyframe = [];
+    for (let i = 0; i < 51; i++) {
+        keyframe.push(i);
+    }
+    let payload = keyframe.slice();
+    payload[0] = 0x80;
+    payload[9] = 0x90;
+    const expected = codec.decodeUplink({ bytes: Buffer.from(payload), fPort: 1 });
+
+    // Keyframe
+    codec.decodeUplink({ bytes: Buffer.from(keyframe), fPort: 1 });
+
+    // CRC-8 of keyframe, bitmap (7 bytes), changed bytes
+    const delta = Buffer.from([0x1E, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x90]);
+    let res = codec.decodeUplink({ bytes: delta, fPort: 3 });
+    assert.deepEqual(res.data, expected.data, 'restored data should match port 1 data');
+
+    // Delta frame refers to keyframe, not to restored payload
+    res = codec.decodeUplink({ bytes: delta, fPort: 3 });
+    assert.deepEqual(res.data, expected.data, 'restored data should match port 1 data');
+
+    // Keyframe mismatch
+    res = codec.decodeUplink({ bytes: Buffer.from([0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00]), fPort: 3 });
+    assert.deepEqual(res.data.bytes, {
+        delta: { keyframe_crc: 0x1F, data: '00000000000000' }
+    }, 'data should match expected value');
+});
+
+test('decodeUplink() -> batched sensor data (port 4)', () => {
+    let record0 = [];
+    for (let i = 0; i < 51; i++) {
+        record0.push(i);
+    }
+    let record1 = record0.slice();
+    record1[3] = 0x10;
+    const expected0 = codec.decodeUplink({ bytes: Buffer.from(record0), fPort: 1 });
+    const expected1 = codec.decodeUplink({ bytes: Buffer.from(record1), fPort: 1 });
+
+    // 2 records, first at 1000 s, size 51; second 120 s later with byte 3 changed
+    const uplinkBytes = Buffer.from([0x02, 0xE8, 0x03, 0x00, 0x00, 0x33].concat(record0).concat(
+        [0x78, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10]));
+    const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 4 });
+    assert.deepEqual(res.data.bytes, {
+        records: [
+            { time: '1970-01-01T00:16:40.000Z', timestamp: 1000, data: expected0.data.bytes },
+            { time: '1970-01-01T00:18:40.000Z', timestamp: 1120, data: expected1.data.bytes }
+        ]
+    }, 'data should match expected value');
+});
+
+test('decodeUplink() -> backfilled sensor data (port 5)', () => {
+    let keyframe = [];
+    for (let i = 0; i < 51; i++) {
+        keyframe.push(i);
+    }
+    let payload = keyframe.slice();
+    payload[0] = 0x80;
+    payload[9] = 0x90;
+    let current = keyframe.slice();
+    current[0] = 0xFF;
+    const expectedKeyframe = codec.decodeUplink({ bytes: Buffer.from(keyframe), fPort: 1 });
+    const expected = codec.decodeUplink({ bytes: Buffer.from(payload), fPort: 1 });
+
+    // Current keyframe received before the queue is drained
+    codec.decodeUplink({ bytes: Buffer.from(current), fPort: 1 });
+
+    // Queued keyframe, port 1 at 1000 s
+    let res = codec.decodeUplink({ bytes: Buffer.from([0x01, 0xE8, 0x03, 0x00, 0x00].concat(keyframe)), fPort: 5 });
+    assert.deepEqual(res.data.bytes, Object.assign({}, expectedKeyframe.data.bytes, {
+        backfill: { port: 1, time: '1970-01-01T00:16:40.000Z', timestamp: 1000 }
+    }), 'data should match expected value');
+
+    // Queued delta frame referring to queued keyframe, port 3 at 1300 s
+    const delta = [0x1E, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x90];
+    res = codec.decodeUplink({ bytes: Buffer.from([0x03, 0x14, 0x05, 0x00, 0x00].concat(delta)), fPort: 5 });
+    assert.deepEqual(res.data.bytes, Object.assign({}, expected.data.bytes, {
+        backfill: { port: 3, time: '1970-01-01T00:21:40.000Z', timestamp: 1300 }
+    }), 'data should match expected value');
+});
+
+test('decodeUplink() -> CMD_GET_WAKE_TRACE response', () => {
+    const uplinkBytes = Buffer.from([
+        0x08, 0x08,
+        0x0A, 0x00, 0x0C, 0x00, 0x0F, 0x00,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xE8, 0x03, 0xDC, 0x05, 0xD0, 0x07
+    ]);
+    const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0x3A });
+    assert.deepEqual(res.data, {
+        bytes: {
+            cycles: 8,
+            wake_trace: {
+                uplink: { min_ms: 100, avg_ms: 120, max_ms: 150 },
+                total: { min_ms: 10000, avg_ms: 15000, max_ms: 20000 }
+            }
+        }
+    }, 'data should match expected value');
+});
+
+test('decodeUplink() -> CMD_GET_JOIN_HISTORY response', () => {
+    const uplinkBytes = Buffer.from([
+        0x05, 0x00,
+        0x10, 0x0E, 0x00, 0x00,
+        0xB8, 0x0B, 0x00, 0x00,
+        0x03, 0x00,
+        0x08, 0x07, 0x00, 0x00,
+        0x03
+    ]);
+    const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0x3E });
+    assert.deepEqual(res.data, {
+        bytes: {
+            join_attempts: 5,
+            join_duration_s: 3600,
+            join_airtime_ms: 3000,
+            join_max_hour_attempts: 3,
+            join_max_hour_airtime_ms: 1800,
+            join_dr: 3
+        }
+    }, 'data should match expected value');
+});
+
 test('decodeUplink() -> CMD_GET_APP_STATUS_INTERVAL response', () => {
     const uplinkBytes = Buffer.from([0x40]);
     const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0x40 });
     assert.deepEqual(res.data, { bytes: { app_status_interval: 64 } }, 'data should match expected value');
 });
 
+test('decodeUplink() -> CMD_MULTI response', () => {
+    const uplinkBytes = Buffer.from([0x40, 0x01, 0x40, 0x36, 0x05, 0x01, 0x2C, 0x02, 0x58, 0x80]);
+    const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0x3C });
+    assert.deepEqual(res.data, {
+        bytes: {
+            app_status_interval: 64,
+            sleep_interval: 300, sleep_interval_long: 600, lw_status_interval: 128
+        }
+    }, 'data should match expected value');
+});
+
+test('decodeUplink() -> coalesced status uplinks (CMD_MULTI)', () => {
+    const lwStatus = [0x74, 0x0E, 0x00];
+    const sensorsStat = [0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B,
+        0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x20, 0x21, 0x30, 0x31, 0x32, 0x33,
+        0x40, 0x41, 0x42, 0x43, 0x50, 0x51];
+    const uplinkBytes = Buffer.from([0x38, lwStatus.length].concat(lwStatus, [0x42, sensorsStat.length], sensorsStat));
+    const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0x3C });
+    const expected = Object.assign({},
+        codec.decodeUplink({ bytes: Buffer.from(lwStatus), fPort: 0x38 }).data.bytes,
+        codec.decodeUplink({ bytes: Buffer.from(sensorsStat), fPort: 0x42 }).data.bytes);
+    assert.deepEqual(res.data.bytes, expected, 'data should match expected value');
+    assert.ok('ubatt_mv' in res.data.bytes, 'should contain LoRaWAN node status');
+    assert.ok('sensor_status' in res.data.bytes, 'should contain sensor status');
+});
+
 test('decodeUplink() -> CMD_GET_SENSORS_STAT response', () => {
     const uplinkBytes = Buffer.from([0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B,
         0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x20, 0x21, 0x30, 0x31, 0x32, 0x33,
@@ -136,6 +376,31 @@ test('decodeUplink() -> CMD_GET_APP_PAYLOAD_CFG response', () => {
     }, 'data should match expected value');
 });
 
+test('decodeUplink() -> CMD_GET_PAYLOAD_LAYOUT response', () => {
+    const uplinkBytes = Buffer.from([
+        0x0B, 0x0B, 0x02,
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00,
+        0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00
+    ]);
+    const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0x48 });
+    assert.deepEqual(res.data.bytes, {
+        max_len: 11,
+        size: 11,
+        ble: false,
+        dropped: true,
+        bresser: [
+            "0x00", "0x01", "0x00", "0x00", "0x00", "0x00", "0x00", "0x00",
+            "0x00", "0x00", "0x00", "0x00", "0x00", "0x00", "0x00", "0x00"
+        ],
+        onewire: "0x0000",
+        analog: "0x0001",
+        digital: "0x00000000"
+    }, 'data should match expected value');
+});
+
 test('decodeUplink() -> CMD_GET_WS_TIMEOUT response', () => {
     const uplinkBytes = Buffer.from([0xFF]);
     const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0xC0 });
@@ -180,6 +445,14 @@ test('decodeUplink() -> CMD_GET_SENSORS_CFG response', () => {
         'data should match expected values')
 });
 
+test('decodeUplink() -> CMD_GET_ONEWIRE_RES response', () => {
+    const uplinkBytes = Buffer.from([0x09, 0x0A, 0x0B, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
+        0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C]);
+    const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0x4A });
+    assert.deepEqual(res.data.bytes, { onewire_res: [9, 10, 11, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12] },
+        'data should match expected values');
+});
+
 test('decodeUplink() -> CMD_GET_BLE_CONFIG response', () => {
     const uplinkBytes = Buffer.from([0x01, 0x20]);
     const res = codec.decodeUplink({ bytes: uplinkBytes, fPort: 0xD0 });
@@ -285,6 +558,30 @@ test('encodeDownlink(cmd: "CMD_GET_LW_STATUS")', () => {
     assert.ok(res.errors.length === 0, 'should be no errors');
 });
 
+test('encodeDownlink(cmd: "CMD_GET_WAKE_TRACE")', () => {
+    const res = codec.encodeDownlink({ data: { cmd: "CMD_GET_WAKE_TRACE" } });
+    assert.ok(res.bytes.equals(Buffer.from([0x00])), 'bytes should be [0x00]');
+    assert.ok(res.fPort === 0x3A, 'fPort should be 0x3A');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
+test('encodeDownlink(cmd: "CMD_GET_JOIN_HISTORY")', () => {
+    const res = codec.encodeDownlink({ data: { cmd: "CMD_GET_JOIN_HISTORY" } });
+    assert.ok(res.bytes.equals(Buffer.from([0x00])), 'bytes should be [0x00]');
+    assert.ok(res.fPort === 0x3E, 'fPort should be 0x3E');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
+test('encodeDownlink({ wake_trace_stage: 8 })', () => {
+    const res = codec.encodeDownlink({ data: { wake_trace_stage: 8 } });
+    assert.ok(res.bytes.equals(Buffer.from([0x08])), 'bytes should be [0x08]');
+    assert.ok(res.fPort === 0x3A, 'fPort should be 0x3A');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
 test('encodeDownlink(cmd: "CMD_GET_APP_STATUS_INTERVAL")', () => {
     const res = codec.encodeDownlink({ data: { cmd: "CMD_GET_APP_STATUS_INTERVAL" } });
     assert.ok(res.bytes.equals(Buffer.from([0x00])), 'bytes should be [0x00]');
@@ -309,6 +606,35 @@ test('encodeDownlink(cmd: "CMD_GET_APP_PAYLOAD_CFG")', () => {
     assert.ok(res.errors.length === 0, 'should be no errors');
 });
 
+test('encodeDownlink(cmd: "CMD_GET_PAYLOAD_LAYOUT")', () => {
+    const res = codec.encodeDownlink({ data: { cmd: "CMD_GET_PAYLOAD_LAYOUT" } });
+    assert.ok(res.bytes.equals(Buffer.from([0x00])), 'bytes should be [0x00]');
+    assert.ok(res.fPort === 0x48, 'fPort should be 0x48');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
+test('encodeDownlink(cmd: "CMD_RESET_PAYLOAD_DELTA")', () => {
+    const res = codec.encodeDownlink({ data: { cmd: "CMD_RESET_PAYLOAD_DELTA" } });
+    assert.ok(res.bytes.equals(Buffer.from([0x00])), 'bytes should be [0x00]');
+    assert.ok(res.fPort === 0x49, 'fPort should be 0x49');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
+test('encodeDownlink(commands: [{ sleep_interval: 600 }, { cmd: "CMD_GET_LW_CONFIG" }])', () => {
+    const res = codec.encodeDownlink({ data: { commands: [{ sleep_interval: 600 }, { cmd: "CMD_GET_LW_CONFIG" }] } });
+    assert.ok(res.bytes.equals(Buffer.from([0x31, 0x02, 0x02, 0x58, 0x36, 0x01, 0x00])), 'bytes should match expected value');
+    assert.ok(res.fPort === 0x3C, 'fPort should be 0x3C');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
+test('encodeDownlink(commands: nested commands)', () => {
+    const res = codec.encodeDownlink({ data: { commands: [{ commands: [{ cmd: "CMD_GET_LW_CONFIG" }] }] } });
+    assert.ok(res.errors.length === 1, 'should be one error');
+});
+
 test('encodeDownlink(cmd: "CMD_GET_WS_TIMEOUT")', () => {
     const res = codec.encodeDownlink({ data: { cmd: "CMD_GET_WS_TIMEOUT" } });
     assert.ok(res.bytes.equals(Buffer.from([0x00])), 'bytes should be [0x00]');
@@ -499,6 +825,30 @@ test('encodeDownlink( <CMD_SET_SENSORS_CFG> )', () => {
     assert.ok(res.errors.length === 0, 'should be no errors');
 });
 
+test('encodeDownlink(cmd: "CMD_GET_ONEWIRE_RES")', () => {
+    const res = codec.encodeDownlink({ data: { cmd: "CMD_GET_ONEWIRE_RES" } });
+    assert.ok(res.bytes.equals(Buffer.from([0x00])), 'bytes should be [0x00]');
+    assert.ok(res.fPort === 0x4A, 'fPort should be 0x4A');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
+test('encodeDownlink( <CMD_SET_ONEWIRE_RES> )', () => {
+    const downlinkData = {
+        onewire_res: [9, 12, 10]
+    };
+    const res = codec.encodeDownlink({ data: downlinkData });
+    assert.ok(res.bytes.equals(Buffer.from([
+        0x09, 0x0C, 0x0A
+    ])), 'bytes should match expected value');
+    assert.ok(res.fPort === 0x4B, 'fPort should be 0x4B');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+
+    const invalid = codec.encodeDownlink({ data: { onewire_res: [8] } });
+    assert.ok(invalid.errors.length === 1, 'invalid resolution should be rejected');
+});
+
 test('encodeDownlink( <CMD_SET_BLE_CONFIG> )', () => {
     const downlinkData = {
         ble_active: 1, ble_scantime: 20
@@ -579,6 +929,20 @@ test('decodeDownlink(<CMD_GET_LW_STATUS>)', () => {
     assert.ok(res.errors.length === 0, 'should be no errors');
 });
 
+test('decodeDownlink(<CMD_GET_WAKE_TRACE>)', () => {
+    const downlinkBytes = Buffer.from([0x08]);
+    const res = codec.decodeDownlink({ bytes: downlinkBytes, fPort: 0x3A });
+    assert.deepEqual(res.data, { wake_trace_stage: 8 }, 'data should match expected value');
+});
+
+test('decodeDownlink(<CMD_GET_JOIN_HISTORY>)', () => {
+    const downlinkBytes = Buffer.from([0x00]);
+    const res = codec.decodeDownlink({ bytes: downlinkBytes, fPort: 0x3E });
+    assert.deepEqual(res.data, [0], 'data should match expected value');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
 test('decodeDownlink(<CMD_GET_APP_STATUS_INTERVAL>)', () => {
     const downlinkBytes = Buffer.from([0x00]);
     const res = codec.decodeDownlink({ bytes: downlinkBytes, fPort: 0x40 });
@@ -603,6 +967,35 @@ test('decodeDownlink(<CMD_GET_APP_PAYLOAD_CFG>)', () => {
     assert.ok(res.errors.length === 0, 'should be no errors');
 });
 
+test('decodeDownlink(<CMD_GET_PAYLOAD_LAYOUT>)', () => {
+    const downlinkBytes = Buffer.from([0x00]);
+    const res = codec.decodeDownlink({ bytes: downlinkBytes, fPort: 0x48 });
+    assert.deepEqual(res.data, [0], 'data should match expected value');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
+test('decodeDownlink(<CMD_RESET_PAYLOAD_DELTA>)', () => {
+    const downlinkBytes = Buffer.from([0x00]);
+    const res = codec.decodeDownlink({ bytes: downlinkBytes, fPort: 0x49 });
+    assert.deepEqual(res.data, [0], 'data should match expected value');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
+test('decodeDownlink(<CMD_MULTI>)', () => {
+    const downlinkBytes = Buffer.from([0x31, 0x02, 0x02, 0x58, 0x36, 0x01, 0x00]);
+    const res = codec.decodeDownlink({ bytes: downlinkBytes, fPort: 0x3C });
+    assert.deepEqual(res.data, {
+        commands: [
+            { port: 0x31, data: { sleep_interval: 600 } },
+            { port: 0x36, data: [0] }
+        ]
+    }, 'data should match expected value');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
 test('decodeDownlink(<CMD_GET_WS_TIMEOUT>)', () => {
     const downlinkBytes = Buffer.from([0x00]);
     const res = codec.decodeDownlink({ bytes: downlinkBytes, fPort: 0xC0 });
@@ -774,6 +1167,16 @@ test('decodeDownlink(<CMD_SET_SENSORS_CFG>)', () => {
     assert.ok(res.errors.length === 0, 'should be no errors');
 });
 
+test('decodeDownlink(<CMD_SET_ONEWIRE_RES>)', () => {
+    const downlinkBytes = Buffer.from([0x09, 0x0C, 0x0A]);
+    const res = codec.decodeDownlink({ bytes: downlinkBytes, fPort: 0x4B });
+    assert.deepEqual(res.data, {
+        onewire_res: [9, 12, 10]
+    }, 'data should match expected value');
+    assert.ok(res.warnings.length === 0, 'should be no warnings');
+    assert.ok(res.errors.length === 0, 'should be no errors');
+});
+
 test('decodeDownlink(<CMD_SET_BLE_CONFIG>)', () => {
     const downlinkBytes = Buffer.from([0x01, 0x20]);
     const res = codec.decodeDownlink({ bytes: downlinkBytes, fPort: 0xD1 });
@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////
+// gen_payload_schema.js
+//
+// Generates the uplink payload schema of the uplink formatter from the
+// firmware's payload schema table (src/PayloadSchema.h)
+//
+// Usage:
+// node scripts/gen_payload_schema.js
+//
+// The block between the markers PAYLOAD_SCHEMA_BEGIN and PAYLOAD_SCHEMA_END
+// in scripts/uplink_formatter.js and
+// scripts/bresserweathersensorlw-codec/uplink_formatter.js is replaced.
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+///////////////////////////////////////////////////////////////////////////////
+
+const fs = require('fs');
+const path = require('path');
+
+// Sensor types (see WeatherSensorCfg.h)
+const SENSOR_TYPES = {
+    SENSOR_TYPE_WEATHER1: 1,
+    SENSOR_TYPE_THERMO_HYGRO: 2,
+    SENSOR_TYPE_POOL_THERMO: 3,
+    SENSOR_TYPE_SOIL: 4,
+    SENSOR_TYPE_LEAKAGE: 5,
+    SENSOR_TYPE_AIR_PM: 8,
+    SENSOR_TYPE_LIGHTNING: 9,
+    SENSOR_TYPE_CO2: 10,
+    SENSOR_TYPE_HCHO_VOC: 11
+};
+
+// Configuration flags (see BresserWeatherSensorLWCfg.h)
+const FLAGS = {
+    PAYLOAD_WS_HUMIDITY: 0x02,
+    PAYLOAD_WS_WIND: 0x04,
+    PAYLOAD_WS_RAINGAUGE: 0x08,
+    PAYLOAD_WS_LIGHT: 0x10,
+    PAYLOAD_WS_UV: 0x20,
+    PAYLOAD_WS_RAIN_H: 0x40,
+    PAYLOAD_WS_RAIN_DWM: 0x80,
+    PAYLOAD_WS_TGLOBE: 0x100,
+    PAYLOAD_LIGHTNING_RAW: 0x10,
+    PAYLOAD_LIGHTNING_PROC: 0x20
+};
+
+// Field encodings (E_PAYLOAD_ENC) -> uplink formatter decoding functions
+const ENCODINGS = {
+    E_TEMPERATURE: 'temperature',
+    E_UINT8: 'uint8',
+    E_UINT8FP1: 'uint8fp1',
+    E_UINT16: 'uint16',
+    E_UINT16FP1: 'uint16fp1',
+    E_UINT32: 'uint32',
+    E_RAWFLOAT: 'rawfloat',
+    E_UNIXTIME: 'unixtime'
+};
+
+/**
+ * Parses the payload schema table in PayloadSchema.h.
+ *
+ * Conditionally compiled entries (RAINDATA_EN, LIGHTNINGSENSOR_EN) are
+ * included - both features are enabled by default.
+ *
+ * @param {string} header - Content of PayloadSchema.h
+ * @returns {Array} - Entries [type, flag, decoder, name]
+ * @throws {Error} - If the table or an entry cannot be parsed
+ */
+function parseSchema(header) {
+    const begin = header.indexOf('// PAYLOAD_SCHEMA_BEGIN');
+    const end = header.indexOf('// PAYLOAD_SCHEMA_END');
+    if ((begin < 0) || (end < begin)) {
+        throw new Error('Payload schema markers not found');
+    }
+    const entryRe = /^\s*\{(\w+),\s*(\w+),\s*E_PAYLOAD_ENC::(\w+),\s*"([^"]+)",\s*[\w:]+\},?\s*$/;
+    let entries = [];
+    for (const line of header.slice(begin, end).split('\n').slice(1)) {
+        if ((line.trim() === '') || line.trim().startsWith('#') || line.trim().startsWith('//')) {
+            continue;
+        }
+        const m = line.match(entryRe);
+        if (!m || !(m[1] in SENSOR_TYPES) || !(m[3] in ENCODINGS) || ((m[2] !== '0') && !(m[2] in FLAGS))) {
+            throw new Error('Cannot parse payload schema entry: ' + line.trim());
+        }
+        entries.push([SENSOR_TYPES[m[1]], (m[2] === '0') ? 0 : FLAGS[m[2]], ENCODINGS[m[3]], m[4]]);
+    }
+    return entries;
+}
+
+/**
+ * Formats the payload schema as uplink formatter source code.
+ *
+ * @param {Array} entries - Entries [type, flag, decoder, name]
+ * @returns {string} - Lines between the markers (including indentation)
+ */
+function formatSchema(entries) {
+    return entries.map(function (e) {
+        return '        [' + e[0] + ', 0x' + e[1].toString(16).padStart(2, '0').toUpperCase() +
+            ', ' + e[2] + ', \'' + e[3] + '\'],';
+    }).join('\n') + '\n';
+}
+
+/**
+ * Extracts the generated block from the uplink formatter.
+ *
+ * @param {string} formatter - Content of uplink_formatter.js
+ * @returns {string} - Lines between the markers
+ */
+function extractSchema(formatter) {
+    const m = formatter.match(/\/\/ PAYLOAD_SCHEMA_BEGIN[^\n]*\n([\s\S]*?)^\s*\/\/ PAYLOAD_SCHEMA_END/m);
+    if (!m) {
+        throw new Error('Payload schema markers not found');
+    }
+    return m[1];
+}
+
+if (require.main === module) {
+    const root = path.join(__dirname, '..');
+    const schema = formatSchema(parseSchema(fs.readFileSync(path.join(root, 'src', 'PayloadSchema.h'), 'utf8')));
+    for (const file of ['uplink_formatter.js', path.join('bresserweathersensorlw-codec', 'uplink_formatter.js')]) {
+        const fname = path.join(__dirname, file);
+        const formatter = fs.readFileSync(fname, 'utf8');
+        const old = extractSchema(formatter);
+        const begin = formatter.indexOf('\n', formatter.indexOf('// PAYLOAD_SCHEMA_BEGIN')) + 1;
+        fs.writeFileSync(fname, formatter.slice(0, begin) + schema + formatter.slice(begin + old.length));
+        console.log(file + ((old === schema) ? ': up to date' : ': updated'));
+    }
+}
+
+module.exports = {
+    parseSchema: parseSchema,
+    formatSchema: formatSchema,
+    extractSchema: extractSchema
+};
@@ -36,6 +36,14 @@
 // port = CMD_GET_BLE_CONFIG, {"cmd": "CMD_GET_BLE_CONFIG"} / payload = 0x00
 // port = CMD_SET_BLE_CONFIG, {"ble_active": <ble_active>, "ble_scantime": <ble_scantime>}
 // port = CMD_GET_APP_PAYLOAD_CFG, {"cmd": "CMD_GET_APP_PAYLOAD_CFG"} / payload = 0x00
+// port = CMD_GET_WAKE_TRACE, {"cmd": "CMD_GET_WAKE_TRACE"} / payload = 0x00
+// port = CMD_GET_PAYLOAD_LAYOUT, {"cmd": "CMD_GET_PAYLOAD_LAYOUT"} / payload = 0x00
+// port = CMD_RESET_PAYLOAD_DELTA, {"cmd": "CMD_RESET_PAYLOAD_DELTA"} / payload = 0x00
+// port = CMD_GET_ONEWIRE_RES, {"cmd": "CMD_GET_ONEWIRE_RES"} / payload = 0x00
+// port = CMD_SET_ONEWIRE_RES, {"onewire_res": [<onewire_res0>, ..., <onewire_resN>]}
+//                            {"wake_trace_stage": <first_stage>}
+// port = CMD_GET_JOIN_HISTORY, {"cmd": "CMD_GET_JOIN_HISTORY"} / payload = 0x00
+// port = CMD_MULTI, {"commands": [{<command0>}, ..., {<commandN>}]}
 //
 // Responses:
 // -----------
@@ -45,6 +53,15 @@
 // 
 // CMD_GET_DATETIME {"epoch": <unix_epoch_time>, "rtc_source": <rtc_source>}
 //
+// CMD_GET_WAKE_TRACE {"cycles": <cycles>, "wake_trace": {<stage>: {"min_ms": <min_ms>, "avg_ms": <avg_ms>, "max_ms": <max_ms>}, ...}}
+//
+// CMD_GET_JOIN_HISTORY {"join_attempts": <join_attempts>, "join_duration_s": <join_duration_s>, "join_airtime_ms": <join_airtime_ms>,
+//                       "join_max_hour_attempts": <join_max_hour_attempts>, "join_max_hour_airtime_ms": <join_max_hour_airtime_ms>,
+//                       "join_dr": <join_dr>}
+//
+// CMD_MULTI {<response0>, ..., <responseN>} (responses combined in one object;
+//           each response is encoded as <port>, <length>, <payload>)
+//
 // CMD_GET_WS_TIMEOUT {"ws_timeout": <ws_timeout>}
 //
 // CMD_GET_WS_POSTPROC {"update_interval": <update_interval>}
@@ -65,6 +82,11 @@
 //
 // CMD_GET_APP_PAYLOAD_CFG {"bresser": [<type0>, <type1>, ..., <type15>], "onewire": <onewire>, "analog": <analog>, "digital": <digital>}
 //
+// CMD_GET_PAYLOAD_LAYOUT {"max_len": <max_len>, "size": <size>, "ble": <ble>, "dropped": <dropped>,
+//                         "bresser": [<type0>, <type1>, ..., <type15>], "onewire": <onewire>, "analog": <analog>, "digital": <digital>}
+//
+// CMD_GET_ONEWIRE_RES {"onewire_res": [<onewire_res0>, ..., <onewire_res15>]}
+//
 // <ws_timeout>         : 0...255
 // <sleep_interval>     : 0...65535
 // <sleep_interval_long>: 0...65535
@@ -85,8 +107,54 @@
 // <typeN>              : Bitmap for enabling Bresser sensors of type N; each bit position corresponds to a channel, e.g. bit 0 controls ch0; 
 //                        unused bits can be used to select features
 // <onewire>            : Bitmap for enabling 1-Wire sensors; each bit position corresponds to an index
+// <onewire_resN>       : Resolution of 1-Wire sensor with index N in bits (9...12)
 // <analog>             : Bitmap for enabling analog input channels; each bit positions corresponds to a channel
 // <digital>            : Bitmap for enabling digital input channels in a broad sense &mdash; GPIO, SPI, I2C, UART, ...
+// <first_stage>        : First wake cycle stage to be reported (0...10); max. 8 stages per response
+// <cycles>             : Number of wake cycles recorded
+// <stage>              : boot, sysctx, secrets, app_layer, gps, payload, radio, activate, uplink, uplink_delay, total
+// <join_attempts>      : Number of join requests until the last successful join
+// <join_duration_s>    : Time from first to last join request in seconds
+// <join_airtime_ms>    : Total airtime of join requests in ms
+// <join_max_hour_attempts>: Max. number of join requests per hour
+// <join_max_hour_airtime_ms>: Max. airtime of join requests per hour in ms
+// <join_dr>            : Data rate of last join request (255: default)
+//
+// Sensor data fragments (port = PAYLOAD_FRAGMENT_PORT):
+// ------------------------------------------------------
+// Sensor data exceeding the max. payload size of the current data rate is sent in
+// consecutive uplinks. Each fragment starts with a header byte
+// (bit 7..4: message sequence number, bit 3: last fragment, bit 2..0: fragment index).
+// When all fragments of a message have been received, the reassembled payload is
+// decoded like port 1. Otherwise, the fragment is returned as
+// {"fragment": {"seq": <seq>, "idx": <idx>, "last": <last>, "data": <hex_string>}}.
+// Note: Reassembly requires that the formatter's state (fragment_store) is retained
+//       between uplinks; in stateless environments, the fragments have to be
+//       reassembled by the backend (concatenate "data" of all fragments in order of "idx").
+//
+// Sensor data delta frames (port = PAYLOAD_DELTA_PORT):
+// -----------------------------------------------------
+// Sensor data sent as difference to the last keyframe (sensor data on port 1):
+// byte 0: CRC-8 of the keyframe, byte 1..n: bitmap of changed bytes (bit i of byte i/8:
+// keyframe byte i), followed by the changed bytes.
+// If the keyframe is available (delta_keyframes), the sensor data is restored and
+// decoded like port 1. Otherwise (e.g. keyframe lost or formatter's state not retained),
+// the delta frame is returned as {"delta": {"keyframe_crc": <crc>, "data": <hex_string>}}.
+//
+// Batched sensor data (port = SAMPLE_BATCH_PORT):
+// -----------------------------------------------
+// byte 0: number of records, byte 1..4: unix time of first record, byte 5: record size s,
+// byte 6..s+5: first record; each further record: time since previous record in seconds
+// (2 bytes), bitmap of bytes changed w.r.t. previous record, changed bytes.
+// Each record is decoded like port 1:
+// {"records": [{"time": <time>, "timestamp": <timestamp>, "data": {<sensor data>}}, ...]}
+//
+// Backfilled uplinks (port = PAYLOAD_QUEUE_PORT):
+// -----------------------------------------------
+// Uplink which could not be sent in its wake cycle, sent later from the node's queue:
+// byte 0: original port, byte 1..4: unix time of original uplink, byte 5...: original payload.
+// The original payload is decoded according to its port and marked as backfilled:
+// {<decoded payload>, "backfill": {"port": <port>, "time": <time>, "timestamp": <timestamp>}}
 
 // Based on:
 // ---------
@@ -154,14 +222,38 @@
 //          Added ws_tglobe_c
 // 20250828 Added CMD_GET_WS_POSTPROC/CMD_SET_WS_POSTPROC
 // 20250905 Added module export
+// 20261016 Added CMD_GET_WAKE_TRACE
+//          Added energy accounting to CMD_GET_LW_STATUS
+//          Added payload schema generated from src/PayloadSchema.h and
+//          APP_PAYLOAD_CFG for schema based decoding of port 1
+//          Added CMD_GET_PAYLOAD_LAYOUT
+//          Added reassembly of sensor data fragments (PAYLOAD_FRAGMENT_PORT)
+//          Added decoding of sensor data delta frames (PAYLOAD_DELTA_PORT)
+//          Added decoding of batched sensor data (SAMPLE_BATCH_PORT)
+//          Added decoding of backfilled uplinks (PAYLOAD_QUEUE_PORT),
+//          replaced delta_keyframe by delta_keyframes
+//          Added CMD_MULTI
+//          Added CMD_GET_JOIN_HISTORY
+//          Added CMD_GET_ONEWIRE_RES
 //
 // ToDo:
 // -  
 //
 ///////////////////////////////////////////////////////////////////////////////
 
-function decoder(bytes, port) {
+// Fragments of sensor data messages received so far, indexed by message sequence number
+var fragment_store = {};
+
+// Recent keyframes (sensor data, port 1) for decoding of delta frames - oldest first;
+// backfilled delta frames may refer to a keyframe older than the last one
+var delta_keyframes = [];
+
+// Max. number of keyframes in delta_keyframes
+const DELTA_KEYFRAMES_MAX = 8;
+
+function decoder(bytes, port, nested) {
     // bytes is of type Buffer
+    // nested: payload restored from delta frame or batch record - not stored as keyframe
 
     // Skip signals encoded as invalid
     const SKIP_INVALID_SIGNALS = false;
@@ -172,12 +264,30 @@ function decoder(bytes, port) {
     // Enable PowerFeather specific information in LoRaWAN Node Status message
     const POWERFEATHER = false;
 
+    // Payload configuration (appPayloadCfg, 24 bytes, see CMD_GET_APP_PAYLOAD_CFG)
+    // If set, the Bresser sensor part of the sensor data payload (port 1)
+    // is decoded according to the payload schema instead of the mask below;
+    // e.g. weather sensor with all signals and lightning sensor:
+    // const APP_PAYLOAD_CFG = [0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    //                          0x00, 0x31, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    //                          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00];
+    const APP_PAYLOAD_CFG = null;
+
+    const PAYLOAD_FRAGMENT_PORT = 2;
+    const PAYLOAD_DELTA_PORT = 3;
+    const SAMPLE_BATCH_PORT = 4;
+    const PAYLOAD_QUEUE_PORT = 5;
     const CMD_GET_DATETIME = 0x20;
     const CMD_GET_LW_CONFIG = 0x36;
     const CMD_GET_LW_STATUS = 0x38;
+    const CMD_GET_WAKE_TRACE = 0x3A;
+    const CMD_MULTI = 0x3C;
+    const CMD_GET_JOIN_HISTORY = 0x3E;
     const CMD_GET_APP_STATUS_INTERVAL = 0x40;
     const CMD_GET_SENSORS_STAT = 0x42;
     const CMD_GET_APP_PAYLOAD_CFG = 0x46;
+    const CMD_GET_PAYLOAD_LAYOUT = 0x48;
+    const CMD_GET_ONEWIRE_RES = 0x4A;
     const CMD_GET_WS_TIMEOUT = 0xC0;
     const CMD_GET_WS_POSTPROC = 0xCC;
     const CMD_SCAN_SENSORS = 0xC4;
@@ -222,6 +332,20 @@ function decoder(bytes, port) {
         4: "Leakage"
     }
 
+    const wake_stages = [
+        "boot",
+        "sysctx",
+        "secrets",
+        "app_layer",
+        "gps",
+        "payload",
+        "radio",
+        "activate",
+        "uplink",
+        "uplink_delay",
+        "total"
+    ];
+
     var rtc_source = function (bytes) {
         if (bytes.length !== rtc_source.BYTES) {
             throw new Error('rtc_source must have exactly 1 byte');
@@ -397,6 +521,15 @@ function decoder(bytes, port) {
     };
     bresser_bitmaps.BYTES = 16;
 
+    var uint8_array = function (bytes) {
+        let res = [];
+        for (var i = 0; i < bytes.length; i++) {
+            res[i] = bytes[i];
+        }
+        return res;
+    };
+    uint8_array.BYTES = bytes.length;
+
     var hex16 = function (bytes) {
         let res = "0x" + byte2hex(bytes[0]) + byte2hex(bytes[1]);
         return res;
@@ -563,6 +696,109 @@ function decoder(bytes, port) {
         return res;
     }
 
+    // Wake cycle timing statistics; 6 bytes per stage, starting at bytes[1]
+    function wake_trace(bytes) {
+        let res = {};
+        let stage = bytes[0];
+        for (let i = 1; i + 6 <= bytes.length; i += 6) {
+            const min = bytesToInt(bytes.slice(i, i + 2));
+            const avg = bytesToInt(bytes.slice(i + 2, i + 4));
+            const max = bytesToInt(bytes.slice(i + 4, i + 6));
+            const name = wake_stages[stage] || stage;
+            stage++;
+            if (min === 0xFFFF) {
+                // Stage not executed in any of the recorded cycles
+                continue;
+            }
+            res[name] = {
+                'min_ms': min * 10,
+                'avg_ms': avg * 10,
+                'max_ms': max * 10
+            };
+        }
+        return res;
+    }
+
+    // Payload schema of Bresser sensors: [sensor type, flag, decoder, name]
+    // - order of fields as encoded by the firmware
+    // - flag: PAYLOAD_WS_* / PAYLOAD_LIGHTNING_*, 0: always included
+    // - '#' in name: channel
+    // Generated by scripts/gen_payload_schema.js from src/PayloadSchema.h - do not edit!
+    const payload_schema = [
+        // PAYLOAD_SCHEMA_BEGIN
+        [1, 0x00, temperature, 'ws_temp_c'],
+        [1, 0x02, uint8, 'ws_humidity'],
+        [1, 0x08, rawfloat, 'ws_rain_mm'],
+        [1, 0x04, uint16fp1, 'ws_wind_avg_ms'],
+        [1, 0x04, uint16fp1, 'ws_wind_gust_ms'],
+        [1, 0x04, uint16fp1, 'ws_wind_dir_deg'],
+        [1, 0x20, uint8fp1, 'ws_uv'],
+        [1, 0x10, uint32, 'ws_light_lux'],
+        [1, 0x40, rawfloat, 'ws_rain_hourly_mm'],
+        [1, 0x80, rawfloat, 'ws_rain_daily_mm'],
+        [1, 0x80, rawfloat, 'ws_rain_weekly_mm'],
+        [1, 0x80, rawfloat, 'ws_rain_monthly_mm'],
+        [1, 0x100, temperature, 'ws_tglobe_c'],
+        [2, 0x00, temperature, 'th#_temp_c'],
+        [2, 0x00, uint8, 'th#_humidity'],
+        [3, 0x00, temperature, 'pt#_temp_c'],
+        [4, 0x00, temperature, 'soil#_temp_c'],
+        [4, 0x00, uint8, 'soil#_moisture'],
+        [5, 0x00, uint8, 'leak#_alarm'],
+        [8, 0x00, uint16, 'pm#_pm1_0_ug_m3'],
+        [8, 0x00, uint16, 'pm#_pm2_5_ug_m3'],
+        [8, 0x00, uint16, 'pm#_pm10_ug_m3'],
+        [9, 0x10, uint8, 'lgt_storm_dist_km'],
+        [9, 0x10, uint16, 'lgt_strike_count'],
+        [9, 0x20, unixtime, 'lgt_ev_time'],
+        [9, 0x20, uint16, 'lgt_ev_events'],
+        [9, 0x20, uint8, 'lgt_ev_dist_km'],
+        [10, 0x00, uint16, 'co2#_co2_ppm'],
+        [11, 0x00, uint16, 'aq#_hcho_ppb'],
+        [11, 0x00, uint8, 'aq#_voc'],
+        // PAYLOAD_SCHEMA_END
+    ];
+
+    /**
+     * Creates mask and names for the Bresser sensor part of the sensor data
+     * payload from the payload configuration (see PayloadBresser::encodeBresser()).
+     *
+     * @param {Array} cfg - Payload configuration (appPayloadCfg)
+     * @returns {Object} - { mask, names }
+     */
+    function schema_mask(cfg) {
+        let mask = [];
+        let names = [];
+        const add = function (type, flags, ch) {
+            for (const field of payload_schema) {
+                if ((field[0] === type) && ((field[1] === 0) || (flags & field[1]))) {
+                    mask.push(field[2]);
+                    names.push(field[3].replace('#', ch));
+                }
+            }
+        };
+
+        // Weather sensor
+        const ws_flags = (cfg[13] << 8) | cfg[1];
+        if (ws_flags & 1) {
+            add(1, ws_flags, 0);
+        }
+        for (let type = 2; type < 16; type++) {
+            if (type === 9) {
+                // Lightning sensor
+                if (cfg[type] & 1) {
+                    add(type, cfg[type], 0);
+                }
+                continue;
+            }
+            for (let ch = 1; ch <= 7; ch++) {
+                if ((cfg[type] >> ch) & 1) {
+                    add(type, 0, ch);
+                }
+            }
+        }
+        return { mask: mask, names: names };
+    }
 
     /**
      * Decodes the given bytes using the provided mask and names.
@@ -635,6 +871,96 @@ function decoder(bytes, port) {
         return decodedValues;
     };
 
+    // Store fragment and reassemble payload
+    // Returns the reassembled payload if all fragments of the message have been received,
+    // otherwise null
+    var reassemble = function (bytes) {
+        const seq = bytes[0] >> 4;
+        const idx = bytes[0] & 0x07;
+        const last = (bytes[0] & 0x08) ? true : false;
+
+        // First fragment of a message replaces a stale entry with the same sequence number
+        if ((idx === 0) || !(seq in fragment_store)) {
+            fragment_store[seq] = { parts: [], count: 0 };
+        }
+        let msg = fragment_store[seq];
+        msg.parts[idx] = Array.from(bytes.slice(1));
+        if (last) {
+            msg.count = idx + 1;
+        }
+        if (msg.count === 0) {
+            return null;
+        }
+        for (let i = 0; i < msg.count; i++) {
+            if (msg.parts[i] === undefined) {
+                return null;
+            }
+        }
+        delete fragment_store[seq];
+        return [].concat.apply([], msg.parts.slice(0, msg.count));
+    };
+
+    // CRC-8 (polynomial 0x07, initial value 0x00)
+    var crc8 = function (bytes) {
+        let crc = 0;
+        for (let i = 0; i < bytes.length; i++) {
+            crc ^= bytes[i];
+            for (let bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80) ? ((crc << 1) ^ 0x07) & 0xFF : (crc << 1) & 0xFF;
+            }
+        }
+        return crc;
+    };
+
+    // Restore payload from delta frame and keyframe
+    // Returns null if the keyframe does not match
+    var delta_apply = function (bytes, keyframe) {
+        if ((keyframe === null) || (bytes[0] !== crc8(keyframe))) {
+            return null;
+        }
+        const bitmapSize = Math.ceil(keyframe.length / 8);
+        let payload = keyframe.slice();
+        let offset = 1 + bitmapSize;
+        for (let i = 0; i < keyframe.length; i++) {
+            if ((bytes[1 + (i >> 3)] >> (i & 7)) & 1) {
+                if (offset >= bytes.length) {
+                    return null;
+                }
+                payload[i] = bytes[offset++];
+            }
+        }
+        return payload;
+    };
+
+    // Split batch uplink into records
+    // Returns [{timestamp: <unix_time>, bytes: [<record>]}, ...]
+    var batch_records = function (bytes) {
+        const num = bytes[0];
+        let timestamp = bytesToInt(bytes.slice(1, 5));
+        const size = bytes[5];
+        let offset = 6 + size;
+        let prev = Array.from(bytes.slice(6, offset));
+        let records = [{ timestamp: timestamp, bytes: prev }];
+        for (let n = 1; n < num; n++) {
+            timestamp += bytes[offset] | (bytes[offset + 1] << 8);
+            offset += 2;
+            let record = prev.slice();
+            let pos = offset + Math.ceil(size / 8);
+            for (let i = 0; i < size; i++) {
+                if ((bytes[offset + (i >> 3)] >> (i & 7)) & 1) {
+                    record[i] = bytes[pos++];
+                }
+            }
+            offset = pos;
+            records.push({ timestamp: timestamp, bytes: record });
+            prev = record;
+        }
+        if (offset > bytes.length) {
+            throw new Error('Batch length is ' + offset + ' whereas input is ' + bytes.length);
+        }
+        return records;
+    };
+
     if (typeof module === 'object' && typeof module.exports !== 'undefined') {
         module.exports = {
             unixtime: unixtime,
@@ -659,13 +985,89 @@ function decoder(bytes, port) {
             uint16fp1: uint16fp1,
             rtc_source: rtc_source,
             found_sensors: found_sensors,
+            wake_trace: wake_trace,
+            schema_mask: schema_mask,
+            reassemble: reassemble,
+            crc8: crc8,
+            delta_apply: delta_apply,
+            batch_records: batch_records,
             decode: decode
         };
     }
 
 
-    if (port === 1) {
-        if (!COMPATIBILITY_MODE) {
+    if (port === PAYLOAD_FRAGMENT_PORT) {
+        const payload = reassemble(bytes);
+        if (payload === null) {
+            return {
+                'fragment': {
+                    'seq': bytes[0] >> 4,
+                    'idx': bytes[0] & 0x07,
+                    'last': (bytes[0] & 0x08) ? true : false,
+                    'data': Array.from(bytes.slice(1)).map(function (b) {
+                        return ('0' + b.toString(16)).slice(-2);
+                    }).join('')
+                }
+            };
+        }
+        return decoder(payload, 1, nested);
+    } else if (port === PAYLOAD_QUEUE_PORT) {
+        const timestamp = bytesToInt(bytes.slice(1, 5));
+        let res = decoder(bytes.slice(5), bytes[0], nested) || {};
+        res.backfill = {
+            'port': bytes[0],
+            'time': new Date(timestamp * 1000).toISOString(),
+            'timestamp': timestamp
+        };
+        return res;
+    } else if (port === SAMPLE_BATCH_PORT) {
+        const records = batch_records(bytes).map(function (record) {
+            return {
+                'time': new Date(record.timestamp * 1000).toISOString(),
+                'timestamp': record.timestamp,
+                // Records do not replace the keyframe
+                'data': decoder(record.bytes, 1, true)
+            };
+        });
+        return { 'records': records };
+    } else if (port === PAYLOAD_DELTA_PORT) {
+        // Most recent keyframe matching the CRC
+        let keyframe = null;
+        for (let i = delta_keyframes.length - 1; i >= 0; i--) {
+            if (crc8(delta_keyframes[i]) === bytes[0]) {
+                keyframe = delta_keyframes[i];
+                break;
+            }
+        }
+        const payload = delta_apply(bytes, keyframe);
+        if (payload === null) {
+            return {
+                'delta': {
+                    'keyframe_crc': bytes[0],
+                    'data': Array.from(bytes.slice(1)).map(function (b) {
+                        return ('0' + b.toString(16)).slice(-2);
+                    }).join('')
+                }
+            };
+        }
+        // Restored payload does not replace the keyframe
+        return decoder(payload, 1, true);
+    } else if (port === 1) {
+        if (!nested) {
+            delta_keyframes.push(Array.from(bytes));
+            if (delta_keyframes.length > DELTA_KEYFRAMES_MAX) {
+                delta_keyframes.shift();
+            }
+        }
+        if (APP_PAYLOAD_CFG && !COMPATIBILITY_MODE) {
+            const schema = schema_mask(APP_PAYLOAD_CFG);
+            return decode(
+                port,
+                bytes,
+                schema.mask,
+                schema.names
+            );
+        } else if (!COMPATIBILITY_MODE) {
             return decode(
                 port,
                 bytes,
@@ -780,25 +1182,49 @@ function decoder(bytes, port) {
             ]
         );
     } else if (port === CMD_GET_LW_STATUS) {
+        let mask;
+        let names;
         if (POWERFEATHER) {
-            return decode(
-                port,
-                bytes,
-                [uint16, uint8, uint16, int16, int16, uint8, uint8, uint16, int32, temperature
-                ],
-                ['ubatt_mv', 'long_sleep', 'usupply_mv', 'isupply_ma', 'ibatt_ma', 'soc', 'soh', 'batt_cycles', 'batt_time_min', 'batt_temp_c'
-                ]
-            );
+            mask = [uint16, uint8, uint16, int16, int16, uint8, uint8, uint16, int32, temperature];
+            names = ['ubatt_mv', 'long_sleep', 'usupply_mv', 'isupply_ma', 'ibatt_ma', 'soc', 'soh', 'batt_cycles', 'batt_time_min', 'batt_temp_c'];
         } else {
-            return decode(
-                port,
-                bytes,
-                [uint16, uint8
-                ],
-                ['ubatt_mv', 'long_sleep'
-                ]
-            );
+            mask = [uint16, uint8];
+            names = ['ubatt_mv', 'long_sleep'];
+        }
+        // Energy accounting (optional, appended by newer firmware)
+        let baseLength = mask.reduce(function (prev, cur) {
+            return prev + cur.BYTES;
+        }, 0);
+        if (bytes.length >= baseLength + uint16.BYTES + uint16fp1.BYTES) {
+            mask = mask.concat([uint16, uint16fp1]);
+            names = names.concat(['cycle_charge_mas', 'consumption_mah_day']);
         }
+        return decode(
+            port,
+            bytes,
+            mask,
+            names
+        );
+    } else if (port === CMD_MULTI) {
+        let res = {};
+        for (let i = 0; i + 2 <= bytes.length; i += 2 + bytes[i + 1]) {
+            Object.assign(res, decoder(bytes.slice(i + 2, i + 2 + bytes[i + 1]), bytes[i], true));
+        }
+        return res;
+    } else if (port === CMD_GET_JOIN_HISTORY) {
+        return decode(
+            port,
+            bytes,
+            [uint16, uint32, uint32, uint16, uint32, uint8
+            ],
+            ['join_attempts', 'join_duration_s', 'join_airtime_ms', 'join_max_hour_attempts', 'join_max_hour_airtime_ms', 'join_dr'
+            ]
+        );
+    } else if (port === CMD_GET_WAKE_TRACE) {
+        return {
+            'cycles': bits8(bytes.slice(0, 1)),
+            'wake_trace': wake_trace(bytes.slice(1))
+        };
     } else if (port === CMD_GET_WS_TIMEOUT) {
         return decode(
             port,
@@ -869,6 +1295,26 @@ function decoder(bytes, port) {
             ],
             ['bresser', 'onewire', 'analog', 'digital']
         );
+    } else if (port === CMD_GET_PAYLOAD_LAYOUT) {
+        let res = decode(
+            port,
+            bytes,
+            [bits8, bits8, bits8, bresser_bitmaps, hex16, hex16, hex32
+            ],
+            ['max_len', 'size', 'flags', 'bresser', 'onewire', 'analog', 'digital']
+        );
+        res.ble = (res.flags & 1) ? true : false;
+        res.dropped = (res.flags & 2) ? true : false;
+        delete res.flags;
+        return res;
+    } else if (port === CMD_GET_ONEWIRE_RES) {
+        return decode(
+            port,
+            bytes,
+            [uint8_array
+            ],
+            ['onewire_res']
+        );
     } else if (port === CMD_GET_APP_STATUS_INTERVAL) {
         return decode(
             port,
@@ -66,6 +66,15 @@
 // 20240722 Renamed STATUS_INTERVAL to APP_STATUS_INTERVAL
 // 20250318 Renamed PAYLOAD_SIZE to MAX_UPLINK_SIZE
 // 20250731 Added CMD_GET_WS_POSTPROC/CMD_SET_WS_POSTPROC
+// 20261016 Added uplink payload planner, fitPayload() and CMD_GET_PAYLOAD_LAYOUT
+//          Added PAYLOAD_FRAGMENTATION
+//          Added PAYLOAD_DELTA and CMD_RESET_PAYLOAD_DELTA
+//          Added requestKeyframe()
+//          Replaced Preferences by RAM-cached configuration image (cfgImage)
+//          Wait for concurrent BLE scan if BLE sensor is not included (BLE_SCAN_TASK)
+//          Added CMD_GET_ONEWIRE_RES/CMD_SET_ONEWIRE_RES
+//          Plan sensor data payload for MAX_SENSOR_PAYLOAD_SIZE with PAYLOAD_FRAGMENTATION
+//          Added validDownlink()
 //
 // ToDo:
 // -
@@ -98,26 +107,50 @@ void AppLayer::getPayloadStage1(uint8_t &port, LoraEncoder &encoder)
 
     log_i("--- Uplink Data ---");
 
-    encodeBresser(appPayloadCfg, appStatus, encoder);
+    // Plan payload layout - sensors which do not fit are removed from the configuration
+    uint8_t bleSensors = 0;
+#if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
+    bleSensors = knownBLEAddresses.size();
+#endif
+#if defined(PAYLOAD_FRAGMENTATION)
+    // Payload exceeding the max. size of the current data rate will be fragmented
+    payloadPlanner.plan(appPayloadCfg, bleSensors, MAX_SENSOR_PAYLOAD_SIZE);
+#else
+    payloadPlanner.plan(appPayloadCfg, bleSensors);
+#endif
+    uint8_t payloadCfg[APP_PAYLOAD_CFG_SIZE];
+    memcpy(payloadCfg, payloadPlanner.getCfg(), APP_PAYLOAD_CFG_SIZE);
+
+    encodeBresser(payloadCfg, appStatus, encoder);
 
 #ifdef ONEWIRE_EN
-    encodeOneWire(appPayloadCfg, encoder);
+    encodeOneWire(payloadCfg, encoder);
 #endif
 
     // Voltages / auxiliary analog sensor data
-    encodeAnalog(appPayloadCfg, encoder);
+    encodeAnalog(payloadCfg, encoder);
 
     // Digital Sensors (GPIO, UART, I2C, SPI, ...)
-    encodeDigital(appPayloadCfg, encoder);
+    encodeDigital(payloadCfg, encoder);
 
 #if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
     // BLE Temperature/Humidity Sensors
-    encodeBLE(appPayloadCfg, appStatus, encoder);
+    if (payloadPlanner.isBleIncluded())
+    {
+        encodeBLE(payloadCfg, appStatus, encoder);
+    }
+#if defined(BLE_SCAN_TASK)
+    else
+    {
+        // BLE scan must be finished before uplink/sleep
+        joinScan();
+    }
+#endif
 #endif
 
     // FIXME: To be removed later
     // Battery status flags for compatibility with BresserWeatherSensorTTN and ESP32-e-Paper-Weather-Display
-    if ((appPayloadCfg[0] & 1) && (encoder.getLength() <= MAX_UPLINK_SIZE - 1))
+    if ((payloadCfg[0] & 1) && (encoder.getLength() <= MAX_SENSOR_PAYLOAD_SIZE - 1))
     {
         log_i("Battery status flags: ws=%u, soil=%u, lgt=%u", appStatus[SENSOR_TYPE_WEATHER1] & 1,
               (appStatus[SENSOR_TYPE_SOIL] & 2) >> 1, appStatus[SENSOR_TYPE_LIGHTNING] & 1);
@@ -138,6 +171,40 @@ void AppLayer::getPayloadStage2(uint8_t &port, LoraEncoder &encoder)
     (void)encoder;
 }
 
+uint8_t AppLayer::fitPayload(uint8_t &port, uint8_t *payload, uint8_t size, uint8_t maxLen)
+{
+    if (port == 1)
+    {
+#if !defined(PAYLOAD_FRAGMENTATION)
+        size = payloadPlanner.trim(payload, size, maxLen);
+#endif
+#if defined(PAYLOAD_DELTA)
+        uint8_t deltaSize = payloadDelta.encode(payload, size, payloadPlanner.getCfg(), maxLen);
+        if (deltaSize > 0)
+        {
+            port = PAYLOAD_DELTA_PORT;
+            return deltaSize;
+        }
+#endif
+        // With PAYLOAD_FRAGMENTATION, the payload is fragmented by the caller
+        return size;
+    }
+
+    if (size > maxLen)
+    {
+        log_w("Payload size exceeds maximum of %u bytes - truncating", maxLen);
+        return maxLen;
+    }
+    return size;
+}
+
+#if defined(PAYLOAD_DELTA)
+void AppLayer::requestKeyframe(void)
+{
+    payloadDelta.requestKeyframe();
+}
+#endif
+
 uint8_t
 AppLayer::decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
 {
@@ -169,9 +236,7 @@ AppLayer::decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
     if ((port == CMD_SET_WS_POSTPROC) && (size == 1))
     {
         log_i("Set weather sensor post-processing update interval: %u min", payload[0]);
-        appPrefs.begin("BWS-LW-APP", false);
-        appPrefs.putUChar("ws_postproc_int", payload[0]);
-        appPrefs.end();
+        cfgImage.putUChar(E_CFG_ITEM::E_WS_POSTPROC_INT, payload[0]);
         return 0;
     }
 
@@ -180,12 +245,10 @@ AppLayer::decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
         log_i("Scan sensors - time: %u s", payload[0]);
         // 1. Set flag in Preferences to trigger sensor scan and set scan time
         // 2. If flag is set, perform sensors scan instead of normal operation in 
-        //    PayloadBresser::begin(void)
+        //    PayloadBresser::begin()
         // 3. Reset flag after scan
         // 4. Uplink scan results instead of normal sensor data
-        appPrefs.begin("BWS-LW-APP", false);
-        appPrefs.putUChar("ws_scan_t", payload[0]);
-        appPrefs.end();
+        cfgImage.putUChar(E_CFG_ITEM::E_WS_SCAN_T, payload[0]);
         return 0;
     }
 
@@ -198,9 +261,7 @@ AppLayer::decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
     if ((port == CMD_SET_WS_TIMEOUT) && (size == 1))
     {
         log_i("Set ws_timeout: %u s", payload[0]);
-        appPrefs.begin("BWS-LW-APP", false);
-        appPrefs.putUChar("ws_timeout", payload[0]);
-        appPrefs.end();
+        cfgImage.putUChar(E_CFG_ITEM::E_WS_TIMEOUT, payload[0]);
         return 0;
     }
 
@@ -213,9 +274,7 @@ AppLayer::decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
     if ((port == CMD_SET_APP_STATUS_INTERVAL) && (size == 1))
     {
         log_i("Set App status interval: %u frames", payload[0]);
-        appPrefs.begin("BWS-LW-APP", false);
-        appPrefs.putUChar("app_stat_int", payload[0]);
-        appPrefs.end();
+        cfgImage.putUChar(E_CFG_ITEM::E_APP_STAT_INT, payload[0]);
         return 0;
     }
 
@@ -225,6 +284,35 @@ AppLayer::decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
         return CMD_GET_SENSORS_STAT;
     }
 
+    if ((port == CMD_GET_PAYLOAD_LAYOUT) && (payload[0] == 0x00) && (size == 1))
+    {
+        log_i("Get payload layout");
+        return CMD_GET_PAYLOAD_LAYOUT;
+    }
+
+#ifdef ONEWIRE_EN
+    if ((port == CMD_GET_ONEWIRE_RES) && (payload[0] == 0x00) && (size == 1))
+    {
+        log_i("Get 1-Wire sensor resolution");
+        return CMD_GET_ONEWIRE_RES;
+    }
+
+    if ((port == CMD_SET_ONEWIRE_RES) && (size >= 1) && (size <= ONEWIRE_MAX_SENSORS))
+    {
+        log_i("Set 1-Wire sensor resolution");
+        setOneWireRes(payload, size);
+        return 0;
+    }
+#endif
+
+#if defined(PAYLOAD_DELTA)
+    if ((port == CMD_RESET_PAYLOAD_DELTA) && (payload[0] == 0x00) && (size == 1))
+    {
+        payloadDelta.requestKeyframe();
+        return 0;
+    }
+#endif
+
     if ((port == CMD_GET_SENSORS_INC) && (payload[0] == 0x00) && (size == 1))
     {
         log_i("Get sensors include list");
@@ -290,10 +378,8 @@ AppLayer::decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
 
     if ((port == CMD_SET_BLE_CONFIG) && (size == 2))
     {
-        appPrefs.begin("BWS-LW-APP", false);
-        appPrefs.putUChar("ble_active", payload[0]);
-        appPrefs.putUChar("ble_scantime", payload[1]);
-        appPrefs.end();
+        cfgImage.putUChar(E_CFG_ITEM::E_BLE_ACTIVE, payload[0]);
+        cfgImage.putUChar(E_CFG_ITEM::E_BLE_SCANTIME, payload[1]);
         return 0;
     }
 
@@ -348,23 +434,79 @@ AppLayer::decodeDownlink(uint8_t port, uint8_t *payload, size_t size)
     return 0;
 }
 
+bool AppLayer::validDownlink(uint8_t port, const uint8_t *payload, size_t size)
+{
+    switch (port)
+    {
+    case CMD_GET_WS_POSTPROC:
+    case CMD_GET_WS_TIMEOUT:
+    case CMD_GET_APP_STATUS_INTERVAL:
+    case CMD_GET_SENSORS_STAT:
+    case CMD_GET_PAYLOAD_LAYOUT:
+    case CMD_GET_SENSORS_INC:
+    case CMD_GET_SENSORS_EXC:
+    case CMD_GET_SENSORS_CFG:
+#ifdef ONEWIRE_EN
+    case CMD_GET_ONEWIRE_RES:
+#endif
+#if defined(PAYLOAD_DELTA)
+    case CMD_RESET_PAYLOAD_DELTA:
+#endif
+#if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
+    case CMD_GET_BLE_CONFIG:
+    case CMD_GET_BLE_ADDR:
+    case CMD_GET_APP_PAYLOAD_CFG:
+#endif
+        return (size == 1) && (payload[0] == 0x00);
+
+    case CMD_RESET_WS_POSTPROC:
+    case CMD_SET_WS_POSTPROC:
+    case CMD_SCAN_SENSORS:
+    case CMD_SET_WS_TIMEOUT:
+    case CMD_SET_APP_STATUS_INTERVAL:
+        return size == 1;
+
+#ifdef ONEWIRE_EN
+    case CMD_SET_ONEWIRE_RES:
+        return (size >= 1) && (size <= ONEWIRE_MAX_SENSORS);
+#endif
+
+    case CMD_SET_SENSORS_INC:
+    case CMD_SET_SENSORS_EXC:
+        return (size > 0) && (size % 4 == 0);
+
+    case CMD_SET_SENSORS_CFG:
+        return size == 3;
+
+#if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
+    case CMD_SET_BLE_CONFIG:
+        return size == 2;
+
+    case CMD_SET_BLE_ADDR:
+        return (size > 0) && (size % 6 == 0);
+
+    case CMD_SET_APP_PAYLOAD_CFG:
+        return size == 24;
+#endif
+
+    default:
+        return false;
+    }
+}
+
 void AppLayer::getConfigPayload(uint8_t cmd, uint8_t &port, LoraEncoder &encoder)
 {
     if (cmd == CMD_GET_WS_TIMEOUT)
     {
-        appPrefs.begin("BWS-LW-APP", false);
-        uint8_t ws_timeout = appPrefs.getUChar("ws_timeout", WEATHERSENSOR_TIMEOUT);
-        appPrefs.end();
+        uint8_t ws_timeout = cfgImage.getUChar(E_CFG_ITEM::E_WS_TIMEOUT);
         encoder.writeUint8(ws_timeout);
         port = CMD_GET_WS_TIMEOUT;
     }
 #if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
     else if (cmd == CMD_GET_BLE_CONFIG)
     {
-        appPrefs.begin("BWS-LW-APP", false);
-        uint8_t ble_active = appPrefs.getUChar("ble_active", BLE_SCAN_MODE);
-        uint8_t ble_scantime = appPrefs.getUChar("ble_scantime", BLE_SCAN_TIME);
-        appPrefs.end();
+        uint8_t ble_active = cfgImage.getUChar(E_CFG_ITEM::E_BLE_ACTIVE);
+        uint8_t ble_scantime = cfgImage.getUChar(E_CFG_ITEM::E_BLE_SCANTIME);
         encoder.writeUint8(ble_active);
         encoder.writeUint8(ble_scantime);
         port = CMD_GET_BLE_CONFIG;
@@ -424,9 +566,7 @@ void AppLayer::getConfigPayload(uint8_t cmd, uint8_t &port, LoraEncoder &encoder
     }
     else if (cmd == CMD_GET_WS_POSTPROC)
     {
-        appPrefs.begin("BWS-LW-APP", false);
-        uint8_t ws_postproc_int = appPrefs.getUChar("ws_postproc_int", 0);
-        appPrefs.end();
+        uint8_t ws_postproc_int = cfgImage.getUChar(E_CFG_ITEM::E_WS_POSTPROC_INT);
         encoder.writeUint8(ws_postproc_int);
         port = CMD_GET_WS_POSTPROC;
     }
@@ -443,6 +583,23 @@ void AppLayer::getConfigPayload(uint8_t cmd, uint8_t &port, LoraEncoder &encoder
         }
         port = CMD_GET_BLE_ADDR;
     }
+#endif
+    else if (cmd == CMD_GET_PAYLOAD_LAYOUT)
+    {
+        payloadPlanner.encodeLayout(encoder);
+        port = CMD_GET_PAYLOAD_LAYOUT;
+    }
+#ifdef ONEWIRE_EN
+    else if (cmd == CMD_GET_ONEWIRE_RES)
+    {
+        uint8_t res[ONEWIRE_MAX_SENSORS];
+        getOneWireRes(res);
+        for (size_t i = 0; i < ONEWIRE_MAX_SENSORS; i++)
+        {
+            encoder.writeUint8(res[i]);
+        }
+        port = CMD_GET_ONEWIRE_RES;
+    }
 #endif
     else if (cmd == CMD_GET_APP_PAYLOAD_CFG)
     {
@@ -458,21 +615,11 @@ void AppLayer::getConfigPayload(uint8_t cmd, uint8_t &port, LoraEncoder &encoder
 
 bool AppLayer::getAppPayloadCfg(uint8_t *bytes, uint8_t size)
 {
-    bool res = false;
-    appPrefs.begin("BWS-LW-APP", false);
-    if (appPrefs.isKey("payloadcfg"))
-    {
-        appPrefs.getBytes("payloadcfg", bytes, size);
-        res = true;
-    }
-    appPrefs.end();
-    return res;
+    return cfgImage.getBytes(E_CFG_ITEM::E_PAYLOADCFG, bytes, size) > 0;
 }
 
 void AppLayer::setAppPayloadCfg(uint8_t *bytes, uint8_t size)
 {
-    appPrefs.begin("BWS-LW-APP", false);
-    appPrefs.putBytes("payloadcfg", bytes, size);
-    appPrefs.end();
+    cfgImage.putBytes(E_CFG_ITEM::E_PAYLOADCFG, bytes, size);
     memcpy(appPayloadCfg, bytes, size);
 }
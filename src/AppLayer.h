@@ -49,6 +49,16 @@
 // 20240716 Added CMD_SCAN_SENSORS
 // 20240722 Renamed STATUS_INTERVAL to APP_STATUS_INTERVAL
 // 20250728 Replaced rtc/clocksync by sysCtx
+// 20261016 begin(): Load payload configuration before PayloadBresser::begin()
+//          Added payloadPlanner and fitPayload()
+//          Added payloadDelta
+//          Added requestKeyframe()
+//          Replaced Preferences by RAM-cached configuration image (cfgImage)
+//          begin(): Start BLE scan before 868 MHz reception (BLE_SCAN_TASK)
+//          begin(): Start 1-Wire temperature conversion before 868 MHz reception
+//          Added validDownlink()
+//          begin(): Start digital sensor measurements before 868 MHz reception
+//          Added bleScanRunning()
 //
 // ToDo:
 // -
@@ -64,7 +74,7 @@
 
 #include "WeatherSensorCfg.h"
 #include <WeatherSensor.h>
-#include <Preferences.h>
+#include "ConfigImage.h"
 #include "../BresserWeatherSensorLWCfg.h"
 #include "../BresserWeatherSensorLWCmd.h"
 #include "PayloadBresser.h"
@@ -72,6 +82,10 @@
 #include "PayloadAnalog.h"
 #include "PayloadDigital.h"
 #include "PayloadBLE.h"
+#include "PayloadPlanner.h"
+#if defined(PAYLOAD_DELTA)
+#include "PayloadDelta.h"
+#endif
 #include "SystemContext.h"
 #include <LoraMessage.h>
 
@@ -121,8 +135,8 @@ class AppLayer : public PayloadBresser, PayloadAnalog, PayloadDigital
 private:
     SystemContext *_sysCtx;
 
-    /// Preferences (stored in flash memory)
-    Preferences appPrefs;
+    /// Configuration image (cached Preferences)
+    ConfigImage cfgImage;
 
     /// AppLayer payload configuration
     uint8_t appPayloadCfg[APP_PAYLOAD_CFG_SIZE];
@@ -130,6 +144,14 @@ private:
     /// AppLayer status bits
     uint8_t appStatus[APP_STATUS_SIZE];
 
+    /// Sensor data uplink layout
+    PayloadPlanner payloadPlanner;
+
+#if defined(PAYLOAD_DELTA)
+    /// Sensor data uplink delta encoding
+    PayloadDelta payloadDelta;
+#endif
+
 public:
     /*!
      * \brief Constructor
@@ -159,7 +181,27 @@ public:
      */
     void begin(void)
     {
-        PayloadBresser::begin();
+        if (!getAppPayloadCfg(appPayloadCfg, APP_PAYLOAD_CFG_SIZE))
+        {
+            memcpy(appPayloadCfg, appPayloadCfgDef, APP_PAYLOAD_CFG_SIZE);
+        }
+
+        // Start measurements which run concurrently with 868 MHz reception - not in sensor scan mode
+        if (cfgImage.getUChar(E_CFG_ITEM::E_WS_SCAN_T) == 0)
+        {
+            PayloadDigital::begin();
+            PayloadDigital::trigger(appPayloadCfg);
+#ifdef ONEWIRE_EN
+            PayloadOneWire::startConversion(appPayloadCfg);
+#endif
+#if defined(BLE_SCAN_TASK)
+            PayloadBLE::begin();
+            PayloadBLE::startScan();
+#endif
+        }
+
+        // Reception stops as soon as all configured sensors have been received
+        PayloadBresser::begin(appPayloadCfg);
 
         // Sensor scan requested,
         // no other payload encoders will be used
@@ -168,16 +210,22 @@ public:
         }
 
         PayloadAnalog::begin();
-        PayloadDigital::begin();
-#if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
+#if (defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)) && !defined(BLE_SCAN_TASK)
         PayloadBLE::begin();
 #endif
+    };
 
-        if (!getAppPayloadCfg(appPayloadCfg, APP_PAYLOAD_CFG_SIZE))
-        {
-            memcpy(appPayloadCfg, appPayloadCfgDef, APP_PAYLOAD_CFG_SIZE);
-        }
+#if defined(BLE_SCAN_TASK)
+    /*!
+     * \brief Check if the concurrent BLE scan started by begin() is still running
+     *
+     * \returns true while the scan task is active
+     */
+    bool bleScanRunning(void)
+    {
+        return PayloadBLE::isScanRunning();
     };
+#endif
 
     /*!
      * \brief Decode app layer specific downlink messages
@@ -190,6 +238,19 @@ public:
      */
     uint8_t decodeDownlink(uint8_t port, uint8_t *payload, size_t size);
 
+    /*!
+     * \brief Check if app layer specific downlink message is valid
+     *
+     * Checks port and size as decodeDownlink() does, without executing the command.
+     *
+     * \param port downlink message port
+     * \param payload downlink message payload
+     * \param size payload size in bytes
+     *
+     * \returns true if the message would be accepted by decodeDownlink()
+     */
+    bool validDownlink(uint8_t port, const uint8_t *payload, size_t size);
+
     /*!
      * \brief Generate payload (by emulation)
      *
@@ -225,6 +286,32 @@ public:
      */
     void getPayloadStage2(uint8_t &port, LoraEncoder &encoder);
 
+    /*!
+     * \brief Fit payload to the max. payload size of the current data rate
+     *
+     * Sensor data payload: whole sensors are removed according to the
+     * priorities (PAYLOAD_PRIO_*), other payloads are truncated.
+     * With PAYLOAD_FRAGMENTATION, the sensor data payload is returned
+     * unchanged - it has to be fragmented by the caller.
+     * With PAYLOAD_DELTA, the sensor data payload is replaced by a delta frame
+     * and the port is changed to PAYLOAD_DELTA_PORT if applicable.
+     *
+     * \param port    LoRaWAN port (may be modified)
+     * \param payload payload buffer
+     * \param size    payload size in bytes
+     * \param maxLen  max. payload size (node.getMaxPayloadLen())
+     *
+     * \returns payload size in bytes
+     */
+    uint8_t fitPayload(uint8_t &port, uint8_t *payload, uint8_t size, uint8_t maxLen);
+
+#if defined(PAYLOAD_DELTA)
+    /*!
+     * \brief Request a keyframe with the next sensor data uplink
+     */
+    void requestKeyframe(void);
+#endif
+
     /*!
      * \brief Get configuration data for uplink
      *
@@ -244,10 +331,7 @@ public:
      */
     uint8_t getAppStatusUplinkInterval(void)
     {
-        appPrefs.begin("BWS-LW-APP", false);
-        uint8_t status_interval = appPrefs.getUChar("app_stat_int", APP_STATUS_INTERVAL);
-        appPrefs.end();
-        return status_interval;
+        return cfgImage.getUChar(E_CFG_ITEM::E_APP_STAT_INT);
     };
 
     /*!
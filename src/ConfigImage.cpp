@@ -0,0 +1,293 @@
+///////////////////////////////////////////////////////////////////////////////
+// ConfigImage.cpp
+//
+// RAM-cached configuration image for BresserWeatherSensorLW
+//
+// - Loads all application and system settings from Preferences (flash) once
+//   after power-on/reset into a CRC-protected image in memory which is
+//   retained during deep sleep
+// - Settings are read from the image - no flash access on a warm wake-up
+// - Modified settings are written back to flash in one commit before
+//   entering sleep mode - only if a value actually changed
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added E_ONEWIRE_RES
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file ConfigImage.cpp
+ *  \brief RAM-cached configuration image for BresserWeatherSensorLW
+ */
+
+#include <stddef.h>
+#include "ConfigImage.h"
+
+/// Marker for valid retained configuration image
+#define CONFIG_IMAGE_MAGIC 0x43464749UL
+
+#if !defined(BLE_SCAN_MODE)
+#define BLE_SCAN_MODE 1
+#endif
+#if !defined(BLE_SCAN_TIME)
+#define BLE_SCAN_TIME 31
+#endif
+
+/// Number of scalar items
+#define CFG_NUM_SCALARS static_cast<uint8_t>(E_CFG_ITEM::E_PAYLOADCFG)
+
+/// Number of byte array items
+#define CFG_NUM_BYTES (static_cast<uint8_t>(E_CFG_ITEM::E_NUM_ITEMS) - CFG_NUM_SCALARS)
+
+/// Item type
+enum class E_CFG_TYPE : uint8_t
+{
+    E_UCHAR,
+    E_USHORT,
+    E_BYTES
+};
+
+/// Item description
+struct sCfgItem
+{
+    const char *ns;  //!< Preferences namespace
+    const char *key; //!< Preferences key
+    E_CFG_TYPE type; //!< type
+    uint16_t def;    //!< default value (E_BYTES: max. size)
+};
+
+/// Item descriptions, in order of E_CFG_ITEM
+static const sCfgItem cfgItems[] = {
+    {"BWS-LW", "sleep_int", E_CFG_TYPE::E_USHORT, SLEEP_INTERVAL},
+    {"BWS-LW", "sleep_int_long", E_CFG_TYPE::E_USHORT, SLEEP_INTERVAL_LONG},
+    {"BWS-LW", "lw_stat_int", E_CFG_TYPE::E_UCHAR, LW_STATUS_INTERVAL},
+    {"BWS-LW-APP", "ws_scan_t", E_CFG_TYPE::E_UCHAR, 0},
+    {"BWS-LW-APP", "ws_timeout", E_CFG_TYPE::E_UCHAR, WEATHERSENSOR_TIMEOUT},
+    {"BWS-LW-APP", "ws_postproc_int", E_CFG_TYPE::E_UCHAR, 0},
+    {"BWS-LW-APP", "app_stat_int", E_CFG_TYPE::E_UCHAR, APP_STATUS_INTERVAL},
+    {"BWS-LW-APP", "ble_active", E_CFG_TYPE::E_UCHAR, BLE_SCAN_MODE},
+    {"BWS-LW-APP", "ble_scantime", E_CFG_TYPE::E_UCHAR, BLE_SCAN_TIME},
+    {"BWS-LW-APP", "payloadcfg", E_CFG_TYPE::E_BYTES, APP_PAYLOAD_CFG_SIZE},
+    {"BWS-LW-APP", "ble", E_CFG_TYPE::E_BYTES, CFG_BYTES_MAX},
+    {"BWS-LW-APP", "ow_res", E_CFG_TYPE::E_BYTES, APP_PAYLOAD_BYTES_ONEWIRE * 8}};
+
+/// Preferences namespaces
+static const char *cfgNamespaces[] = {"BWS-LW", "BWS-LW-APP"};
+
+/// Byte array setting
+struct sCfgBytes
+{
+    uint8_t size;                //!< size in bytes, 0: not available
+    uint8_t data[CFG_BYTES_MAX]; //!< data
+};
+
+/// Configuration image
+struct sConfigImage
+{
+    uint32_t magic;                   //!< CONFIG_IMAGE_MAGIC if valid
+    uint16_t dirty;                   //!< bit n set: item n modified, not written to flash yet
+    uint16_t values[CFG_NUM_SCALARS]; //!< scalar settings
+    sCfgBytes bytes[CFG_NUM_BYTES];   //!< byte array settings
+    uint8_t crc;                      //!< CRC-8 of all preceding bytes
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sConfigImage configImage = {0}; //!< configuration image
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sConfigImage configImage __attribute__((section(".uninitialized_data"))); //!< configuration image
+#endif
+
+/*!
+ * \brief Calculate CRC-8 (polynomial 0x07, initial value 0x00)
+ *
+ * \param buf  data buffer
+ * \param size data size in bytes
+ *
+ * \returns CRC-8
+ */
+static uint8_t crc8(const uint8_t *buf, size_t size)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= buf[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+void ConfigImage::load(void)
+{
+    if ((configImage.magic == CONFIG_IMAGE_MAGIC) &&
+        (configImage.crc == crc8(reinterpret_cast<const uint8_t *>(&configImage), offsetof(sConfigImage, crc))))
+    {
+        return;
+    }
+
+    // Uninitialized after power-on/HW reset or corrupted
+    log_d("Loading configuration from flash");
+    memset(&configImage, 0, sizeof(configImage));
+    configImage.magic = CONFIG_IMAGE_MAGIC;
+
+    Preferences prefs;
+    for (const char *ns : cfgNamespaces)
+    {
+        bool ok = prefs.begin(ns, true);
+        for (uint8_t i = 0; i < static_cast<uint8_t>(E_CFG_ITEM::E_NUM_ITEMS); i++)
+        {
+            const sCfgItem &item = cfgItems[i];
+            if (strcmp(item.ns, ns) != 0)
+                continue;
+
+            if (item.type == E_CFG_TYPE::E_BYTES)
+            {
+                sCfgBytes &bytes = configImage.bytes[i - CFG_NUM_SCALARS];
+                if (ok && prefs.isKey(item.key))
+                {
+                    bytes.size = min(prefs.getBytesLength(item.key), static_cast<size_t>(item.def));
+                    prefs.getBytes(item.key, bytes.data, bytes.size);
+                }
+            }
+            else if (!ok)
+            {
+                // Namespace does not exist yet
+                configImage.values[i] = item.def;
+            }
+            else if (item.type == E_CFG_TYPE::E_USHORT)
+            {
+                configImage.values[i] = prefs.getUShort(item.key, item.def);
+            }
+            else
+            {
+                configImage.values[i] = prefs.getUChar(item.key, item.def);
+            }
+        }
+        if (ok)
+            prefs.end();
+    }
+    seal();
+}
+
+uint16_t ConfigImage::get(E_CFG_ITEM item)
+{
+    load();
+    return configImage.values[static_cast<uint8_t>(item)];
+}
+
+void ConfigImage::put(E_CFG_ITEM item, uint16_t value)
+{
+    load();
+    uint8_t i = static_cast<uint8_t>(item);
+    if (configImage.values[i] == value)
+        return;
+
+    configImage.values[i] = value;
+    configImage.dirty |= 1 << i;
+    seal();
+}
+
+uint8_t ConfigImage::getBytes(E_CFG_ITEM item, uint8_t *buf, uint8_t size)
+{
+    load();
+    const sCfgBytes &bytes = configImage.bytes[static_cast<uint8_t>(item) - CFG_NUM_SCALARS];
+    memcpy(buf, bytes.data, min(size, bytes.size));
+    return bytes.size;
+}
+
+void ConfigImage::putBytes(E_CFG_ITEM item, const uint8_t *buf, uint8_t size)
+{
+    load();
+    uint8_t i = static_cast<uint8_t>(item);
+    sCfgBytes &bytes = configImage.bytes[i - CFG_NUM_SCALARS];
+    size = min(size, static_cast<uint8_t>(cfgItems[i].def));
+    if ((bytes.size == size) && (memcmp(bytes.data, buf, size) == 0))
+        return;
+
+    bytes.size = size;
+    memcpy(bytes.data, buf, size);
+    configImage.dirty |= 1 << i;
+    seal();
+}
+
+void ConfigImage::commit(void)
+{
+    if ((configImage.magic != CONFIG_IMAGE_MAGIC) || (configImage.dirty == 0))
+        return;
+
+    Preferences prefs;
+    for (const char *ns : cfgNamespaces)
+    {
+        bool open = false;
+        for (uint8_t i = 0; i < static_cast<uint8_t>(E_CFG_ITEM::E_NUM_ITEMS); i++)
+        {
+            const sCfgItem &item = cfgItems[i];
+            if (!(configImage.dirty & (1 << i)) || (strcmp(item.ns, ns) != 0))
+                continue;
+
+            if (!open)
+            {
+                prefs.begin(ns, false);
+                open = true;
+            }
+            log_d("Saving %s/%s", ns, item.key);
+            if (item.type == E_CFG_TYPE::E_BYTES)
+            {
+                const sCfgBytes &bytes = configImage.bytes[i - CFG_NUM_SCALARS];
+                prefs.putBytes(item.key, bytes.data, bytes.size);
+            }
+            else if (item.type == E_CFG_TYPE::E_USHORT)
+            {
+                prefs.putUShort(item.key, configImage.values[i]);
+            }
+            else
+            {
+                prefs.putUChar(item.key, configImage.values[i]);
+            }
+        }
+        if (open)
+            prefs.end();
+    }
+    configImage.dirty = 0;
+    seal();
+}
+
+void ConfigImage::seal(void)
+{
+    configImage.crc = crc8(reinterpret_cast<const uint8_t *>(&configImage), offsetof(sConfigImage, crc));
+}
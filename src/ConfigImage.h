@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////////////
+// ConfigImage.h
+//
+// RAM-cached configuration image for BresserWeatherSensorLW
+//
+// - Loads all application and system settings from Preferences (flash) once
+//   after power-on/reset into a CRC-protected image in memory which is
+//   retained during deep sleep
+// - Settings are read from the image - no flash access on a warm wake-up
+// - Modified settings are written back to flash in one commit before
+//   entering sleep mode - only if a value actually changed
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added E_ONEWIRE_RES
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file ConfigImage.h
+ *  \brief RAM-cached configuration image for BresserWeatherSensorLW
+ */
+
+#if !defined(_CONFIG_IMAGE_H)
+#define _CONFIG_IMAGE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "logging.h"
+
+/// Max. size of byte array settings
+#define CFG_BYTES_MAX 48
+
+/*!
+ * \brief Configuration items
+ *
+ * Each item is stored in Preferences with the same namespace/key as before
+ * - existing settings remain valid.
+ */
+enum class E_CFG_ITEM : uint8_t
+{
+    E_SLEEP_INT = 0,       //!< "BWS-LW"/"sleep_int": sleep interval in s
+    E_SLEEP_INT_LONG = 1,  //!< "BWS-LW"/"sleep_int_long": long sleep interval in s
+    E_LW_STAT_INT = 2,     //!< "BWS-LW"/"lw_stat_int": LoRaWAN node status uplink interval
+    E_WS_SCAN_T = 3,       //!< "BWS-LW-APP"/"ws_scan_t": sensor scan time in s (0: no scan)
+    E_WS_TIMEOUT = 4,      //!< "BWS-LW-APP"/"ws_timeout": weather sensor receive timeout in s
+    E_WS_POSTPROC_INT = 5, //!< "BWS-LW-APP"/"ws_postproc_int": post-processing update interval in min
+    E_APP_STAT_INT = 6,    //!< "BWS-LW-APP"/"app_stat_int": AppLayer status uplink interval
+    E_BLE_ACTIVE = 7,      //!< "BWS-LW-APP"/"ble_active": BLE scan mode
+    E_BLE_SCANTIME = 8,    //!< "BWS-LW-APP"/"ble_scantime": BLE scan time in s
+    E_PAYLOADCFG = 9,      //!< "BWS-LW-APP"/"payloadcfg": AppLayer payload configuration
+    E_BLE = 10,            //!< "BWS-LW-APP"/"ble": BLE sensor addresses
+    E_ONEWIRE_RES = 11,    //!< "BWS-LW-APP"/"ow_res": 1-Wire sensor resolution per index
+    E_NUM_ITEMS = 12       //!< number of items
+};
+
+/*!
+ * \brief RAM-cached configuration image
+ *
+ * All instances share the same image.
+ */
+class ConfigImage
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    ConfigImage() {};
+
+    /*!
+     * \brief Get 8-bit setting
+     *
+     * \param item configuration item
+     *
+     * \returns value
+     */
+    uint8_t getUChar(E_CFG_ITEM item)
+    {
+        return static_cast<uint8_t>(get(item));
+    };
+
+    /*!
+     * \brief Get 16-bit setting
+     *
+     * \param item configuration item
+     *
+     * \returns value
+     */
+    uint16_t getUShort(E_CFG_ITEM item)
+    {
+        return get(item);
+    };
+
+    /*!
+     * \brief Set 8-bit setting
+     *
+     * \param item  configuration item
+     * \param value value
+     */
+    void putUChar(E_CFG_ITEM item, uint8_t value)
+    {
+        put(item, value);
+    };
+
+    /*!
+     * \brief Set 16-bit setting
+     *
+     * \param item  configuration item
+     * \param value value
+     */
+    void putUShort(E_CFG_ITEM item, uint16_t value)
+    {
+        put(item, value);
+    };
+
+    /*!
+     * \brief Get byte array setting
+     *
+     * \param item configuration item
+     * \param buf  buffer
+     * \param size buffer size in bytes
+     *
+     * \returns size of stored setting in bytes, 0 if not available
+     */
+    uint8_t getBytes(E_CFG_ITEM item, uint8_t *buf, uint8_t size);
+
+    /*!
+     * \brief Set byte array setting
+     *
+     * \param item configuration item
+     * \param buf  buffer
+     * \param size size in bytes (max. CFG_BYTES_MAX)
+     */
+    void putBytes(E_CFG_ITEM item, const uint8_t *buf, uint8_t size);
+
+    /*!
+     * \brief Write modified settings to flash
+     *
+     * Has to be called before entering sleep mode.
+     */
+    void commit(void);
+
+private:
+    /*!
+     * \brief Load settings from flash if image is not valid
+     */
+    void load(void);
+
+    /*!
+     * \brief Get scalar setting
+     *
+     * \param item configuration item
+     *
+     * \returns value
+     */
+    uint16_t get(E_CFG_ITEM item);
+
+    /*!
+     * \brief Set scalar setting
+     *
+     * \param item  configuration item
+     * \param value value
+     */
+    void put(E_CFG_ITEM item, uint16_t value);
+
+    /*!
+     * \brief Update CRC of image
+     */
+    void seal(void);
+};
+
+#endif // _CONFIG_IMAGE_H
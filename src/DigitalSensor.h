@@ -32,6 +32,7 @@
 // History:
 //
 // 20260210 Created
+// 20261016 Added trigger()
 //
 // ToDo:
 // -
@@ -65,6 +66,14 @@ public:
      */
     virtual void begin(void) = 0;
 
+    /*!
+     * \brief Start measurement (e.g. power on sensor)
+     *
+     * Called early in the wake cycle - the sensor can use the time until read()
+     * for warm-up/measurement. Default: nothing to do.
+     */
+    virtual void trigger(void) {}
+
     /*!
      * \brief Read sensor data
      * 
@@ -32,6 +32,8 @@
 // History:
 //
 // 20260210 Created from PayloadDigital.cpp
+// 20261016 Added trigger() (power-on at start of wake cycle),
+//          read() returns median of consecutive agreeing readings
 //
 // ToDo:
 // -
@@ -39,16 +41,18 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "DistanceSensor.h"
+#include <algorithm>
 
 #ifdef A02YYUW_EN
 
 DistanceSensor::DistanceSensor()
 {
 #if defined(ESP32)
-    m_sensor = new DistanceSensor_A02YYUW(&Serial2);
+    m_serial = &Serial2;
 #else
-    m_sensor = new DistanceSensor_A02YYUW(&Serial1);
+    m_serial = &Serial1;
 #endif
+    m_sensor = new DistanceSensor_A02YYUW(m_serial);
 }
 
 DistanceSensor::~DistanceSensor()
@@ -71,38 +75,87 @@ void DistanceSensor::begin(void)
 #endif
 }
 
-uint16_t DistanceSensor::read(void)
+void DistanceSensor::trigger(void)
 {
+    if (m_powered)
+        return;
+
     // Sensor power on
     digitalWrite(A02YYUW_PWR, HIGH);
-    delay(500);
+    m_powerOnMs = millis();
+    m_powered = true;
+}
+
+uint16_t DistanceSensor::read(void)
+{
+    trigger();
 
-    int retries = 0;
-    DistanceSensor_A02YYUW_MEASSUREMENT_STATUS dstStatus;
+    // Wait for remainder of warm-up time
+    uint32_t elapsed = millis() - m_powerOnMs;
+    if (elapsed < A02YYUW_WARMUP_MS)
+    {
+        delay(A02YYUW_WARMUP_MS - elapsed);
+    }
+
+    // Discard data received during warm-up
+    while (m_serial->available())
+    {
+        m_serial->read();
+    }
+
+    // Window of consecutive readings within tolerance
+    uint16_t samples[A02YYUW_SAMPLES];
+    uint8_t count = 0;
+    int attempts = 0;
     do
     {
-        dstStatus = m_sensor->meassure();
+        attempts++;
+        DistanceSensor_A02YYUW_MEASSUREMENT_STATUS dstStatus = m_sensor->meassure();
 
         if (dstStatus != DistanceSensor_A02YYUW_MEASSUREMENT_STATUS_OK)
         {
             log_e("Distance Sensor Error: %d", dstStatus);
+            continue;
         }
-    } while (
-        (dstStatus != DistanceSensor_A02YYUW_MEASSUREMENT_STATUS_OK) &&
-        (++retries < A02YYUW_RETRIES));
 
-    uint16_t distance_mm;
-    if (dstStatus == DistanceSensor_A02YYUW_MEASSUREMENT_STATUS_OK)
-    {
-        distance_mm = m_sensor->getDistance();
-    }
-    else
-    {
-        distance_mm = 0;
-    }
+        // Drop oldest readings until the new one agrees with the remaining
+        uint16_t distance = m_sensor->getDistance();
+        bool agree;
+        do
+        {
+            agree = true;
+            for (uint8_t i = 0; i < count; i++)
+            {
+                if (abs(static_cast<int>(samples[i]) - static_cast<int>(distance)) > A02YYUW_TOLERANCE)
+                {
+                    agree = false;
+                    break;
+                }
+            }
+            if (!agree)
+            {
+                memmove(&samples[0], &samples[1], (count - 1) * sizeof(samples[0]));
+                count--;
+            }
+        } while (!agree);
+        samples[count++] = distance;
+    } while ((count < A02YYUW_SAMPLES) && (attempts < A02YYUW_SAMPLES + A02YYUW_RETRIES));
 
     // Sensor power off
     digitalWrite(A02YYUW_PWR, LOW);
+    m_powered = false;
+
+    if (count == 0)
+    {
+        m_spread = 0xFFFF;
+        return 0;
+    }
+
+    // Median of readings
+    std::sort(samples, samples + count);
+    uint16_t distance_mm = samples[count / 2];
+    m_spread = (count == A02YYUW_SAMPLES) ? samples[count - 1] - samples[0] : 0xFFFF;
+    log_d("Distance Sensor: %u readings in %d attempts, spread: %u mm", count, attempts, m_spread);
 
     return distance_mm;
 }
@@ -32,6 +32,8 @@
 // History:
 //
 // 20260210 Created from PayloadDigital.cpp
+// 20261016 Added trigger() (power-on at start of wake cycle),
+//          read() returns median of consecutive agreeing readings
 //
 // ToDo:
 // -
@@ -78,15 +80,40 @@ public:
      */
     void begin(void) override;
 
+    /*!
+     * \brief Power on sensor
+     *
+     * The sensor warms up while other tasks are performed.
+     */
+    void trigger(void) override;
+
     /*!
      * \brief Read ultrasonic distance sensor data
+     *
+     * Waits for the remainder of the warm-up time, then samples until
+     * A02YYUW_SAMPLES consecutive readings agree within A02YYUW_TOLERANCE
+     * (max. A02YYUW_SAMPLES + A02YYUW_RETRIES attempts) and powers off the sensor.
      * 
-     * \returns distance in mm (0 if invalid)
+     * \returns median distance in mm (0 if invalid)
      */
     uint16_t read(void) override;
 
+    /*!
+     * \brief Get spread of readings used by last read()
+     *
+     * \returns max. - min. distance in mm; 0xFFFF if the readings did not agree
+     */
+    uint16_t getSpread(void)
+    {
+        return m_spread;
+    };
+
 private:
     DistanceSensor_A02YYUW *m_sensor; //!< Pointer to sensor object
+    Stream *m_serial;                 //!< Sensor UART
+    bool m_powered = false;           //!< Sensor is powered on
+    uint32_t m_powerOnMs = 0;         //!< Time of power-on (millis())
+    uint16_t m_spread = 0;            //!< Spread of readings used by last read()
 };
 
 #endif // A02YYUW_EN
@@ -32,6 +32,8 @@
 // History:
 //
 // 20260210 Created
+// 20261016 Added trigger() - separate ranging trigger and result collection
+//          Added configurable I2C clock (DYP_R01CW_I2C_CLOCK)
 //
 // ToDo:
 // -
@@ -42,6 +44,15 @@
 
 #ifdef DYP_R01CW_EN
 
+/// Command register
+#define DYP_R01CW_REG_CMD 0x10
+
+/// Command: start ranging
+#define DYP_R01CW_CMD_RANGE 0xB0
+
+/// Distance register (16 bits, big endian)
+#define DYP_R01CW_REG_DIST 0x02
+
 DypR01cw::DypR01cw(uint8_t addr)
     : m_addr(addr)
 {
@@ -72,6 +83,7 @@ void DypR01cw::begin(void)
 #else
         Wire.begin();
 #endif
+        Wire.setClock(DYP_R01CW_I2C_CLOCK);
         wireInitialized = true;
     }
 
@@ -86,9 +98,55 @@ void DypR01cw::begin(void)
     }
 }
 
+void DypR01cw::trigger(void)
+{
+    Wire.beginTransmission(m_addr >> 1);
+    Wire.write(DYP_R01CW_REG_CMD);
+    Wire.write(DYP_R01CW_CMD_RANGE);
+    m_triggered = (Wire.endTransmission() == 0);
+    m_triggerMs = millis();
+
+    if (!m_triggered)
+    {
+        log_e("DYP-R01CW sensor (0x%02X) trigger error", m_addr);
+    }
+}
+
+int32_t DypR01cw::collect(void)
+{
+    Wire.beginTransmission(m_addr >> 1);
+    Wire.write(DYP_R01CW_REG_DIST);
+    if (Wire.endTransmission() != 0)
+        return -1;
+
+    if (Wire.requestFrom(static_cast<uint8_t>(m_addr >> 1), static_cast<uint8_t>(2)) != 2)
+        return -1;
+
+    uint16_t distance = Wire.read() << 8;
+    distance |= Wire.read();
+
+    return distance;
+}
+
 uint16_t DypR01cw::read(void)
 {
-    int16_t distance = m_sensor->readDistance();
+    int32_t distance;
+
+    if (m_triggered)
+    {
+        // Wait for remainder of ranging time
+        uint32_t elapsed = millis() - m_triggerMs;
+        if (elapsed < DYP_R01CW_RANGING_MS)
+        {
+            delay(DYP_R01CW_RANGING_MS - elapsed);
+        }
+        m_triggered = false;
+        distance = collect();
+    }
+    else
+    {
+        distance = m_sensor->readDistance();
+    }
 
     if (distance < 0)
     {
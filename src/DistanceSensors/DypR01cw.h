@@ -32,6 +32,7 @@
 // History:
 //
 // 20260210 Created
+// 20261016 Added trigger() - separate ranging trigger and result collection
 //
 // ToDo:
 // -
@@ -81,16 +82,36 @@ public:
      */
     void begin(void) override;
 
+    /*!
+     * \brief Start ranging
+     *
+     * The result is collected by read().
+     */
+    void trigger(void) override;
+
     /*!
      * \brief Read DYP-R01CW laser distance sensor data
+     *
+     * If ranging was started by trigger(), waits for the remainder of
+     * DYP_R01CW_RANGING_MS and collects the result; otherwise performs
+     * a complete (blocking) measurement.
      * 
      * \returns distance in mm (0 if invalid)
      */
     uint16_t read(void) override;
 
 private:
-    DYP_R01CW *m_sensor; //!< Pointer to sensor object
-    uint8_t m_addr;      //!< I2C address
+    DYP_R01CW *m_sensor;      //!< Pointer to sensor object
+    uint8_t m_addr;           //!< I2C address
+    bool m_triggered = false; //!< Ranging started by trigger()
+    uint32_t m_triggerMs = 0; //!< Time of trigger (millis())
+
+    /*!
+     * \brief Read result of ranging from distance register
+     *
+     * \returns distance in mm, -1 on error
+     */
+    int32_t collect(void);
 };
 
 #endif // DYP_R01CW_EN
@@ -0,0 +1,238 @@
+///////////////////////////////////////////////////////////////////////////////
+// EnergyAccount.cpp
+//
+// Energy accounting for BresserWeatherSensorLW
+//
+// - Estimates the charge used per wake cycle from the stage durations
+//   (see WakeTrace) and a per-board current model
+// - Adds LoRa transmit charge from time-on-air and output power
+// - Keeps running totals in memory which is retained during deep sleep
+//   and provides the average consumption in mAh/day
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added suspend() and resume() (deep sleep between uplinks of a wake cycle)
+//          E_UPLINK is charged at CPU active current plus radio receive current
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file EnergyAccount.cpp
+ *  \brief Energy accounting for BresserWeatherSensorLW
+ */
+
+#include "EnergyAccount.h"
+
+/// Marker for valid retained totals
+#define ENERGY_ACCOUNT_MAGIC 0x454E5247UL
+
+/// Length of the averaging window in seconds
+#define ENERGY_WINDOW_SECONDS (24UL * 60UL * 60UL)
+
+/// Running totals of energy accounting
+struct sEnergyTotals
+{
+    uint32_t magic;        //!< ENERGY_ACCOUNT_MAGIC if valid
+    uint32_t cycleMas;     //!< charge of the last committed cycle in mAs
+    uint64_t windowUas;    //!< charge accumulated in the current window in µAs
+    uint32_t windowS;      //!< time accumulated in the current window in s
+    uint16_t dayMahX10;    //!< consumption of the last complete window in 0.1 mAh
+    bool suspended;        //!< wake cycle suspended
+    uint64_t suspTxUas;    //!< transmit charge of suspended wake cycle in µAs
+    uint32_t suspSleepS;   //!< sleep duration after suspended wake cycle in s
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sEnergyTotals energyTotals = {0}; //!< energy accounting totals
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sEnergyTotals energyTotals __attribute__((section(".uninitialized_data"))); //!< energy accounting totals
+#endif
+
+void EnergyAccount::begin(void)
+{
+    // Uninitialized after power-on/HW reset
+    if (energyTotals.magic != ENERGY_ACCOUNT_MAGIC)
+    {
+        log_d("Energy accounting reset");
+        memset(&energyTotals, 0, sizeof(energyTotals));
+        energyTotals.magic = ENERGY_ACCOUNT_MAGIC;
+        energyTotals.cycleMas = INV_UINT16;
+        energyTotals.dayMahX10 = INV_UINT16;
+    }
+    txChargeUas = 0;
+    sleepBaseS = 0;
+}
+
+void EnergyAccount::suspend(uint32_t sleepSeconds)
+{
+    energyTotals.suspended = true;
+    energyTotals.suspTxUas = txChargeUas;
+    energyTotals.suspSleepS = sleepSeconds;
+}
+
+void EnergyAccount::resume(void)
+{
+    if (!energyTotals.suspended)
+    {
+        return;
+    }
+    txChargeUas += energyTotals.suspTxUas;
+    sleepBaseS = energyTotals.suspSleepS;
+    energyTotals.suspended = false;
+}
+
+void EnergyAccount::addUplink(uint32_t toaMs, int16_t powerDbm)
+{
+    uint32_t currentUa = CURRENT_LORA_TX_0DBM_UA + max(powerDbm, static_cast<int16_t>(0)) * CURRENT_LORA_TX_PER_DBM_UA;
+    uint64_t uas = charge(toaMs, currentUa);
+
+    log_d("Uplink: %lu ms @ %d dBm -> %lu mAs", static_cast<unsigned long>(toaMs), powerDbm,
+          static_cast<unsigned long>(uas / 1000));
+    txChargeUas += uas;
+}
+
+void EnergyAccount::commit(WakeTrace &trace, uint32_t sleepSeconds)
+{
+    uint32_t accountedMs = 0;
+    uint64_t cycleUas = 0;
+
+    for (uint8_t i = 0; i < WAKE_TRACE_STAGES; i++)
+    {
+        E_WAKE_STAGE stage = static_cast<E_WAKE_STAGE>(i);
+        uint32_t ms = trace.duration(stage);
+        uint32_t currentUa;
+
+        switch (stage)
+        {
+        case E_WAKE_STAGE::E_TOTAL:
+            continue;
+
+        case E_WAKE_STAGE::E_APPLAYER:
+            // 868 MHz sensor data reception
+            currentUa = CURRENT_CPU_ACTIVE_UA + CURRENT_RADIO_RX_UA;
+#if defined(BLE_SCAN_TASK)
+            // BLE scan running concurrently
+            currentUa += CURRENT_BLE_SCAN_UA;
+#endif
+            break;
+
+        case E_WAKE_STAGE::E_PAYLOAD:
+#if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
+            // Dominated by BLE scan (BLE_SCAN_TASK: remainder of BLE scan)
+            currentUa = CURRENT_CPU_ACTIVE_UA + CURRENT_BLE_SCAN_UA;
+#else
+            currentUa = CURRENT_CPU_ACTIVE_UA;
+#endif
+            break;
+
+#if defined(GPS_EN)
+        case E_WAKE_STAGE::E_GPS:
+            currentUa = CURRENT_CPU_ACTIVE_UA + CURRENT_GPS_UA;
+            break;
+#endif
+
+        case E_WAKE_STAGE::E_UPLINK:
+            // CPU active while RadioLib handles transmission and receive windows,
+            // radio receiving in RX1/RX2 (conservative: light sleep before the
+            // receive windows is not taken into account);
+            // transmit charge is added separately
+            currentUa = CURRENT_CPU_ACTIVE_UA + CURRENT_RADIO_RX_UA;
+            break;
+
+        case E_WAKE_STAGE::E_UPLINK_DELAY:
+            // Waiting for duty cycle/uplink interval in light sleep
+            currentUa = CURRENT_LIGHT_SLEEP_UA;
+            break;
+
+        default:
+            currentUa = CURRENT_CPU_ACTIVE_UA;
+            break;
+        }
+        uint64_t uas = charge(ms, currentUa);
+        log_d("Stage %2u: %6lu ms -> %6lu mAs", i, static_cast<unsigned long>(ms), static_cast<unsigned long>(uas / 1000));
+        accountedMs += ms;
+        cycleUas += uas;
+    }
+
+    // Remaining awake time not covered by any stage
+    uint32_t totalMs = trace.duration(E_WAKE_STAGE::E_TOTAL);
+    if (totalMs > accountedMs)
+    {
+        cycleUas += charge(totalMs - accountedMs, CURRENT_CPU_ACTIVE_UA);
+    }
+
+    // Sleep between suspended and resumed part of the cycle (if any)
+    sleepSeconds += sleepBaseS;
+    energyTotals.suspended = false;
+
+    cycleUas += txChargeUas;
+    cycleUas += charge(sleepSeconds * 1000UL, CURRENT_DEEP_SLEEP_UA);
+
+    energyTotals.cycleMas = min(static_cast<uint32_t>(cycleUas / 1000), static_cast<uint32_t>(INV_UINT16 - 1));
+    energyTotals.windowUas += cycleUas;
+    energyTotals.windowS += (totalMs / 1000) + sleepSeconds;
+
+    if (energyTotals.windowS >= ENERGY_WINDOW_SECONDS)
+    {
+        // Close window; scale to exactly 24h
+        uint64_t mahX10 = energyTotals.windowUas * 10 * ENERGY_WINDOW_SECONDS / energyTotals.windowS / 3600000ULL;
+        energyTotals.dayMahX10 = min(static_cast<uint32_t>(mahX10), static_cast<uint32_t>(INV_UINT16 - 1));
+        energyTotals.windowUas = 0;
+        energyTotals.windowS = 0;
+    }
+    log_i("Cycle charge: %lu mAs, consumption: %u x 0.1 mAh/day", static_cast<unsigned long>(energyTotals.cycleMas),
+          getDailyConsumption());
+}
+
+uint16_t EnergyAccount::getCycleCharge(void)
+{
+    return energyTotals.cycleMas;
+}
+
+uint16_t EnergyAccount::getDailyConsumption(void)
+{
+    if (energyTotals.dayMahX10 != INV_UINT16)
+    {
+        return energyTotals.dayMahX10;
+    }
+    if (energyTotals.windowS == 0)
+    {
+        return INV_UINT16;
+    }
+
+    // Extrapolate from current (incomplete) window
+    uint64_t mahX10 = energyTotals.windowUas * 10 * ENERGY_WINDOW_SECONDS / energyTotals.windowS / 3600000ULL;
+    return min(static_cast<uint32_t>(mahX10), static_cast<uint32_t>(INV_UINT16 - 1));
+}
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// EnergyAccount.h
+//
+// Energy accounting for BresserWeatherSensorLW
+//
+// - Estimates the charge used per wake cycle from the stage durations
+//   (see WakeTrace) and a per-board current model
+// - Adds LoRa transmit charge from time-on-air and output power
+// - Keeps running totals in memory which is retained during deep sleep
+//   and provides the average consumption in mAh/day
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added suspend() and resume() (deep sleep between uplinks of a wake cycle)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file EnergyAccount.h
+ *  \brief Energy accounting for BresserWeatherSensorLW
+ */
+
+#if !defined(_ENERGY_ACCOUNT_H)
+#define _ENERGY_ACCOUNT_H
+
+#include <Arduino.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "WakeTrace.h"
+#include "logging.h"
+
+/*!
+ * \brief Energy accounting
+ *
+ * The charge of each wake cycle is estimated when the cycle is committed,
+ * i.e. immediately before entering sleep mode. The sleep duration which
+ * follows is accounted for in the same cycle.
+ *
+ * The current model is defined by the CURRENT_* settings in
+ * BresserWeatherSensorLWCfg.h and should be adjusted to measurements
+ * of the actual hardware.
+ */
+class EnergyAccount
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    EnergyAccount() {};
+
+    /*!
+     * \brief Initialize energy accounting
+     *
+     * Validates the retained totals.
+     */
+    void begin(void);
+
+    /*!
+     * \brief Account for a LoRaWAN uplink transmission
+     *
+     * \param toaMs     time-on-air in ms (node.getLastToA())
+     * \param powerDbm  transmit output power in dBm
+     */
+    void addUplink(uint32_t toaMs, int16_t powerDbm);
+
+    /*!
+     * \brief Account for the current wake cycle and the following sleep interval
+     *
+     * \param trace         wake cycle timing trace (stage durations)
+     * \param sleepSeconds  sleep duration in seconds
+     */
+    void commit(WakeTrace &trace, uint32_t sleepSeconds);
+
+    /*!
+     * \brief Suspend accounting of the current wake cycle
+     *
+     * The transmit charge and the following sleep duration are saved to
+     * retained memory and added to the wake cycle continued by resume().
+     *
+     * \param sleepSeconds  sleep duration in seconds
+     */
+    void suspend(uint32_t sleepSeconds);
+
+    /*!
+     * \brief Continue accounting of the wake cycle suspended before deep sleep
+     */
+    void resume(void);
+
+    /*!
+     * \brief Get charge used in the last committed wake cycle
+     *
+     * \returns charge in mAs (INV_UINT16 if not available)
+     */
+    uint16_t getCycleCharge(void);
+
+    /*!
+     * \brief Get average consumption
+     *
+     * The value of the last complete 24h window is returned, if available.
+     * Otherwise, the value is extrapolated from the current window.
+     *
+     * \returns consumption in 0.1 mAh/day (INV_UINT16 if not available)
+     */
+    uint16_t getDailyConsumption(void);
+
+private:
+    uint64_t txChargeUas = 0; //!< transmit charge of the current cycle in µAs
+    uint32_t sleepBaseS = 0;  //!< sleep duration within the current cycle (after suspend) in s
+
+    /*!
+     * \brief Charge of a stage
+     *
+     * \param ms        duration in ms
+     * \param currentUa current in µA
+     *
+     * \returns charge in µAs
+     */
+    uint64_t charge(uint32_t ms, uint32_t currentUa)
+    {
+        return static_cast<uint64_t>(ms) * currentUa / 1000;
+    };
+};
+
+#endif // _ENERGY_ACCOUNT_H
@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////////////////////////
+// JoinBackoff.cpp
+//
+// Join backoff scheduler for BresserWeatherSensorLW
+//
+// - Schedules join attempts with jittered exponential delays
+// - Limits the aggregated join airtime according to LoRaWAN TS001 section 7
+//   (Retransmissions back-off)
+// - Optionally lowers the data rate with the number of failed attempts
+// - Tracks join attempts and airtime in memory which is retained during
+//   deep sleep and provides the join history for a LoRaWAN uplink
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file JoinBackoff.cpp
+ *  \brief Join backoff scheduler for BresserWeatherSensorLW
+ */
+
+#include "JoinBackoff.h"
+
+/// Marker for valid retained state
+#define JOIN_BACKOFF_MAGIC 0x4A4F494EUL
+
+/// Default data rate (RADIOLIB_LORAWAN_DATA_RATE_UNUSED)
+#define JOIN_DR_DEFAULT 0xFF
+
+/// Join airtime limit (LoRaWAN TS001 section 7)
+struct sJoinDutyCycle
+{
+    uint32_t since;    //!< start of phase in s after first attempt
+    uint32_t period;   //!< period in s
+    uint32_t budgetMs; //!< max. airtime per period in ms
+};
+
+/// Join airtime limits, in order of phases
+static const sJoinDutyCycle joinDutyCycle[] = {
+    {0, 3600UL, 36000UL},
+    {3600UL, 36000UL, 36000UL},
+    {39600UL, 86400UL, 8700UL}};
+
+/// Number of join airtime limit phases
+static constexpr size_t JOIN_DUTY_CYCLE_PHASES = sizeof(joinDutyCycle) / sizeof(joinDutyCycle[0]);
+
+/// Retained state
+struct sJoinBackoffState
+{
+    uint32_t magic;           //!< JOIN_BACKOFF_MAGIC if valid
+    bool active;              //!< joining in progress
+    bool reportPending;       //!< join history not reported yet
+    uint16_t attempts;        //!< join attempts (including successful one)
+    uint8_t lastDr;           //!< data rate of last attempt
+    uint32_t firstAttempt;    //!< time of first attempt
+    uint32_t lastAttempt;     //!< time of last attempt
+    uint32_t airtimeMs;       //!< total airtime in ms
+    uint32_t lastAirtimeMs;   //!< airtime of last attempt in ms
+    uint32_t periodStart;     //!< start of current duty cycle period
+    uint32_t periodAirtimeMs; //!< airtime in current duty cycle period in ms
+    uint32_t hourStart;       //!< start of current hour
+    uint16_t hourAttempts;    //!< attempts in current hour
+    uint32_t hourAirtimeMs;   //!< airtime in current hour in ms
+    uint16_t maxHourAttempts; //!< max. attempts per hour
+    uint32_t maxHourAirtimeMs; //!< max. airtime per hour in ms
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sJoinBackoffState joinBackoffState = {0}; //!< join backoff state
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sJoinBackoffState joinBackoffState __attribute__((section(".uninitialized_data"))); //!< join backoff state
+#endif
+
+/*!
+ * \brief Get duty cycle limit for time since first attempt
+ *
+ * \param elapsed time since first attempt in s
+ *
+ * \returns duty cycle limit
+ */
+static const sJoinDutyCycle &dutyCycle(uint32_t elapsed)
+{
+    size_t phase = 0;
+    while ((phase + 1 < JOIN_DUTY_CYCLE_PHASES) && (elapsed >= joinDutyCycle[phase + 1].since))
+    {
+        phase++;
+    }
+    return joinDutyCycle[phase];
+}
+
+/*!
+ * \brief Check if duty cycle period has expired at time t
+ *
+ * The period expires after its duration or at the start of the next phase.
+ *
+ * \param t time
+ *
+ * \returns true if expired
+ */
+static bool periodExpired(uint32_t t)
+{
+    const sJoinDutyCycle &dc = dutyCycle(t - joinBackoffState.firstAttempt);
+    const sJoinDutyCycle &dcStart = dutyCycle(joinBackoffState.periodStart - joinBackoffState.firstAttempt);
+    return (&dc != &dcStart) || (t - joinBackoffState.periodStart >= dc.period);
+}
+
+void JoinBackoff::init(void)
+{
+    if (joinBackoffState.magic == JOIN_BACKOFF_MAGIC)
+        return;
+
+    // Uninitialized after power-on/HW reset
+    memset(&joinBackoffState, 0, sizeof(joinBackoffState));
+    joinBackoffState.magic = JOIN_BACKOFF_MAGIC;
+    joinBackoffState.lastDr = JOIN_DR_DEFAULT;
+}
+
+uint8_t JoinBackoff::dataRate(void)
+{
+    init();
+#if defined(JOIN_DR_RAMP)
+    uint16_t failed = joinBackoffState.active ? joinBackoffState.attempts : 0;
+    if (failed >= JOIN_DR_START - JOIN_DR_END)
+        return JOIN_DR_END;
+    return JOIN_DR_START - failed;
+#else
+    return JOIN_DR_DEFAULT;
+#endif
+}
+
+void JoinBackoff::attempt(uint32_t airtimeMs, bool joined)
+{
+    init();
+    uint32_t now = static_cast<uint32_t>(time(nullptr));
+
+    if (!joinBackoffState.active)
+    {
+        // First attempt of a new join sequence
+        uint8_t lastDr = dataRate();
+        memset(&joinBackoffState, 0, sizeof(joinBackoffState));
+        joinBackoffState.magic = JOIN_BACKOFF_MAGIC;
+        joinBackoffState.active = true;
+        joinBackoffState.firstAttempt = now;
+        joinBackoffState.periodStart = now;
+        joinBackoffState.hourStart = now;
+        joinBackoffState.lastDr = lastDr;
+    }
+    else
+    {
+        joinBackoffState.lastDr = dataRate();
+    }
+
+    // Start new duty cycle period / hour if required
+    if (periodExpired(now))
+    {
+        joinBackoffState.periodStart = now;
+        joinBackoffState.periodAirtimeMs = 0;
+    }
+    if (now - joinBackoffState.hourStart >= 3600UL)
+    {
+        joinBackoffState.hourStart = now;
+        joinBackoffState.hourAttempts = 0;
+        joinBackoffState.hourAirtimeMs = 0;
+    }
+
+    joinBackoffState.attempts++;
+    joinBackoffState.lastAttempt = now;
+    joinBackoffState.airtimeMs += airtimeMs;
+    joinBackoffState.lastAirtimeMs = airtimeMs;
+    joinBackoffState.periodAirtimeMs += airtimeMs;
+    joinBackoffState.hourAttempts++;
+    joinBackoffState.hourAirtimeMs += airtimeMs;
+    joinBackoffState.maxHourAttempts = max(joinBackoffState.maxHourAttempts, joinBackoffState.hourAttempts);
+    joinBackoffState.maxHourAirtimeMs = max(joinBackoffState.maxHourAirtimeMs, joinBackoffState.hourAirtimeMs);
+
+    log_d("Join attempt %u, airtime %u ms (total %u ms)", joinBackoffState.attempts, airtimeMs,
+          joinBackoffState.airtimeMs);
+
+    if (joined)
+    {
+        joinBackoffState.active = false;
+        joinBackoffState.reportPending = true;
+    }
+}
+
+uint32_t JoinBackoff::delay(void)
+{
+    init();
+    uint16_t failed = max(joinBackoffState.attempts, static_cast<uint16_t>(1));
+    uint32_t delaySec = JOIN_BACKOFF_MAX;
+    if (failed - 1 < 16)
+    {
+        delaySec = min(static_cast<uint32_t>(JOIN_BACKOFF_MIN) << (failed - 1), static_cast<uint32_t>(JOIN_BACKOFF_MAX));
+    }
+
+    // Jitter: 50%...100% of delay
+    delaySec = delaySec / 2 + rand(delaySec / 2 + 1);
+
+    // Airtime limit
+    uint32_t now = static_cast<uint32_t>(time(nullptr));
+    uint32_t next = now + delaySec;
+    const sJoinDutyCycle &dc = dutyCycle(joinBackoffState.periodStart - joinBackoffState.firstAttempt);
+    if (!periodExpired(next) &&
+        (joinBackoffState.periodAirtimeMs + joinBackoffState.lastAirtimeMs > dc.budgetMs))
+    {
+        // Postpone to end of period (or start of next phase),
+        // spread attempts over the first minutes of the next period
+        uint32_t periodEnd = joinBackoffState.periodStart + dc.period;
+        const sJoinDutyCycle *phaseNext = &dc + 1;
+        if ((phaseNext < joinDutyCycle + JOIN_DUTY_CYCLE_PHASES) &&
+            (joinBackoffState.firstAttempt + phaseNext->since < periodEnd))
+        {
+            periodEnd = joinBackoffState.firstAttempt + phaseNext->since;
+        }
+        log_d("Join airtime limit reached (%u ms)", joinBackoffState.periodAirtimeMs);
+        delaySec = periodEnd - now + rand(JOIN_BACKOFF_MIN);
+    }
+
+    return max(delaySec, static_cast<uint32_t>(1));
+}
+
+bool JoinBackoff::reportPending(void)
+{
+    init();
+    return joinBackoffState.reportPending;
+}
+
+void JoinBackoff::encodeHistory(LoraEncoder &encoder)
+{
+    init();
+    uint32_t duration = joinBackoffState.lastAttempt - joinBackoffState.firstAttempt;
+    encoder.writeUint16(joinBackoffState.attempts);
+    encoder.writeUint32(duration);
+    encoder.writeUint32(joinBackoffState.airtimeMs);
+    encoder.writeUint16(joinBackoffState.maxHourAttempts);
+    encoder.writeUint32(joinBackoffState.maxHourAirtimeMs);
+    encoder.writeUint8(joinBackoffState.lastDr);
+    joinBackoffState.reportPending = false;
+}
+
+uint32_t JoinBackoff::rand(uint32_t max)
+{
+    if (max == 0)
+        return 0;
+#if defined(ESP32)
+    return esp_random() % max;
+#else
+    return rp2040.hwrand32() % max;
+#endif
+}
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+// JoinBackoff.h
+//
+// Join backoff scheduler for BresserWeatherSensorLW
+//
+// - Schedules join attempts with jittered exponential delays
+// - Limits the aggregated join airtime according to LoRaWAN TS001 section 7
+//   (Retransmissions back-off)
+// - Optionally lowers the data rate with the number of failed attempts
+// - Tracks join attempts and airtime in memory which is retained during
+//   deep sleep and provides the join history for a LoRaWAN uplink
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file JoinBackoff.h
+ *  \brief Join backoff scheduler for BresserWeatherSensorLW
+ */
+
+#if !defined(_JOIN_BACKOFF_H)
+#define _JOIN_BACKOFF_H
+
+#include <Arduino.h>
+#include <LoraEncoder.h>
+#include <time.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "logging.h"
+
+/*!
+ * \brief Join backoff scheduler
+ *
+ * The delay after the n-th failed attempt is a random value between 50% and
+ * 100% of min(JOIN_BACKOFF_MIN * 2^(n-1), JOIN_BACKOFF_MAX) seconds.
+ * Additionally, the aggregated airtime of join requests is limited to
+ * (T0: first attempt):
+ *
+ * T0      ... T0+1h:  36 s per hour
+ * T0+1h   ... T0+11h: 36 s per 10 hours
+ * T0+11h  ... :       8.7 s per 24 hours
+ *
+ * If the next attempt would exceed the limit, it is postponed to the end of
+ * the current period.
+ */
+class JoinBackoff
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    JoinBackoff() {};
+
+    /*!
+     * \brief Get data rate for next join attempt
+     *
+     * With JOIN_DR_RAMP, the data rate is decreased from JOIN_DR_START
+     * by one step per failed attempt down to JOIN_DR_END.
+     *
+     * \returns data rate, RADIOLIB_LORAWAN_DATA_RATE_UNUSED (0xFF): default
+     */
+    uint8_t dataRate(void);
+
+    /*!
+     * \brief Record join attempt
+     *
+     * \param airtimeMs time-on-air of join request in ms
+     * \param joined    true if join was successful
+     */
+    void attempt(uint32_t airtimeMs, bool joined);
+
+    /*!
+     * \brief Get delay until next join attempt
+     *
+     * \returns delay in seconds
+     */
+    uint32_t delay(void);
+
+    /*!
+     * \brief Check if join history has not been reported yet
+     *
+     * \returns true if a join was successful and the history has not been encoded yet
+     */
+    bool reportPending(void);
+
+    /*!
+     * \brief Encode join history for uplink
+     *
+     * \param encoder uplink data encoder object
+     */
+    void encodeHistory(LoraEncoder &encoder);
+
+private:
+    /*!
+     * \brief Initialize retained state after power-on/reset
+     */
+    void init(void);
+
+    /*!
+     * \brief Get random number
+     *
+     * \param max upper limit (exclusive)
+     *
+     * \returns random number 0...max-1
+     */
+    uint32_t rand(uint32_t max);
+};
+
+#endif // _JOIN_BACKOFF_H
@@ -37,6 +37,10 @@
 // 20240613 Fixed using BLE addresses from preferences
 // 20250318 Renamed PAYLOAD_SIZE to MAX_UPLINK_SIZE
 // 20250728 Fixed using ATC_MiThermometer library
+// 20261016 Replaced appPrefs by cfgImage
+//          Added startScan()/joinScan() for concurrent BLE scan (BLE_SCAN_TASK)
+//          Added isScanRunning()
+//          Payload size limited by MAX_SENSOR_PAYLOAD_SIZE
 //
 // ToDo:
 // -
@@ -47,19 +51,29 @@
 
 #if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
 
+#if defined(BLE_SCAN_TASK)
+/// BLE scan task stack size in bytes
+#define BLE_SCAN_TASK_STACK 8192
+
+/// BLE scan task priority
+#define BLE_SCAN_TASK_PRIO 1
+
+/// BLE scan task core - the core not running the Arduino loop task, if available
+#if CONFIG_FREERTOS_UNICORE
+#define BLE_SCAN_TASK_CORE 0
+#else
+#define BLE_SCAN_TASK_CORE ((ARDUINO_RUNNING_CORE == 0) ? 1 : 0)
+#endif
+#endif
+
 void PayloadBLE::setBleAddr(uint8_t *bytes, uint8_t size)
 {
-    appPrefs.begin("BWS-LW-APP", false);
-    appPrefs.putBytes("ble", bytes, size);
-    appPrefs.end();
+    cfgImage.putBytes(E_CFG_ITEM::E_BLE, bytes, size);
 }
 
 uint8_t PayloadBLE::getBleAddr(uint8_t *payload)
 {
-    appPrefs.begin("BWS-LW-APP", false);
-    uint8_t size = appPrefs.getBytesLength("ble");
-    appPrefs.getBytes("ble", payload, size);
-    appPrefs.end();
+    uint8_t size = cfgImage.getBytes(E_CFG_ITEM::E_BLE, payload, CFG_BYTES_MAX);
 
     return size;
 }
@@ -68,11 +82,8 @@ std::vector<std::string> PayloadBLE::getBleAddr(void)
 {
     std::vector<std::string> bleAddr;
 
-    appPrefs.begin("BWS-LW-APP", false);
-    uint8_t size = appPrefs.getBytesLength("ble");
-    uint8_t addrBytes[48];
-    appPrefs.getBytes("ble", addrBytes, size);
-    appPrefs.end();
+    uint8_t addrBytes[CFG_BYTES_MAX];
+    uint8_t size = cfgImage.getBytes(E_CFG_ITEM::E_BLE, addrBytes, CFG_BYTES_MAX);
 
     if (size < 6)
     {
@@ -134,14 +145,89 @@ void PayloadBLE::bleAddrInit(void)
     }
 };
 
+#if defined(BLE_SCAN_TASK)
+void PayloadBLE::scanTask(void *param)
+{
+    PayloadBLE *self = static_cast<PayloadBLE *>(param);
+
+    // Get sensor data - run BLE scan for <ble_scantime>
+    self->bleSensors.getData(self->scanTime, self->scanActive);
+
+    xSemaphoreGive(self->scanDone);
+    vTaskDelete(NULL);
+}
+
+/*
+ * Start BLE scan in a separate task
+ */
+void PayloadBLE::startScan(void)
+{
+    if ((knownBLEAddresses.size() == 0) || scanDone)
+        return;
+
+    scanActive = cfgImage.getUChar(E_CFG_ITEM::E_BLE_ACTIVE);
+    scanTime = cfgImage.getUChar(E_CFG_ITEM::E_BLE_SCANTIME);
+    log_d("Preferences: ble_active: %u", scanActive);
+    log_d("Preferences: ble_scantime: %u s", scanTime);
+
+    // Set sensor data invalid
+    bleSensors.resetData();
+
+    scanDone = xSemaphoreCreateBinary();
+    if (scanDone == nullptr)
+    {
+        log_e("Creating BLE scan semaphore failed");
+        return;
+    }
+
+    if (xTaskCreatePinnedToCore(scanTask, "ble_scan", BLE_SCAN_TASK_STACK, this, BLE_SCAN_TASK_PRIO,
+                                NULL, BLE_SCAN_TASK_CORE) != pdPASS)
+    {
+        log_e("Creating BLE scan task failed");
+        vSemaphoreDelete(scanDone);
+        scanDone = nullptr;
+        return;
+    }
+    log_d("BLE scan started on core %u", BLE_SCAN_TASK_CORE);
+}
+
+/*
+ * Wait until the BLE scan started by startScan() is finished
+ */
+void PayloadBLE::joinScan(void)
+{
+    if (scanDone == nullptr)
+        return;
+
+    log_d("Waiting for BLE scan");
+    xSemaphoreTake(scanDone, portMAX_DELAY);
+    vSemaphoreDelete(scanDone);
+    scanDone = nullptr;
+}
+
+/*
+ * Check if the BLE scan started by startScan() is still running
+ */
+bool PayloadBLE::isScanRunning(void)
+{
+    // scanDone is given by the scan task when finished
+    return (scanDone != nullptr) && (uxSemaphoreGetCount(scanDone) == 0);
+}
+#endif
+
 /*
  * Encode BLE temperature/humidity sensor values for LoRaWAN transmission
  */
 void PayloadBLE::encodeBLE(uint8_t *appPayloadCfg, uint8_t *appStatus, LoraEncoder &encoder)
 {
     // No BLE sensor defined or not enough space left in uplink payload?
-    if ((knownBLEAddresses.size() == 0) || (encoder.getLength() > MAX_UPLINK_SIZE - 3))
+    if ((knownBLEAddresses.size() == 0) || (encoder.getLength() > MAX_SENSOR_PAYLOAD_SIZE - 3))
+    {
+#if defined(BLE_SCAN_TASK)
+        joinScan();
+#endif
         return;
+    }
 
     float indoor_temp_c;
     float indoor_humidity;
@@ -153,19 +239,27 @@ void PayloadBLE::encodeBLE(uint8_t *appPayloadCfg, uint8_t *appStatus, LoraEncod
     float div = 1.0;
 #endif
 
-    appPrefs.begin("BWS-LW-APP", false);
-    uint8_t ble_active = appPrefs.getUChar("ble_active", BLE_SCAN_MODE);
-    uint8_t ble_scantime = appPrefs.getUChar("ble_scantime", BLE_SCAN_TIME);
+    uint8_t ble_active = cfgImage.getUChar(E_CFG_ITEM::E_BLE_ACTIVE);
+    uint8_t ble_scantime = cfgImage.getUChar(E_CFG_ITEM::E_BLE_SCANTIME);
     log_d("Preferences: ble_active: %u", ble_active);
     log_d("Preferences: ble_scantime: %u s", ble_scantime);
-    appPrefs.end();
 
 #if defined(THEENGSDECODER_EN)
-    // Set sensor data invalid
-    bleSensors.resetData();
+#if defined(BLE_SCAN_TASK)
+    if (scanDone)
+    {
+        // Collect results of BLE scan started by startScan()
+        joinScan();
+    }
+    else
+#endif
+    {
+        // Set sensor data invalid
+        bleSensors.resetData();
 
-    // Get sensor data - run BLE scan for <bleScanTime>
-    bleSensors.getData(ble_scantime, ble_active);
+        // Get sensor data - run BLE scan for <bleScanTime>
+        bleSensors.getData(ble_scantime, ble_active);
+    }
 
     if (bleSensors.data[0].valid)
     {
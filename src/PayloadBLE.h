@@ -34,6 +34,9 @@
 // 20240531 Moved from AppLayer.h
 // 20240603 encodeBLE(): added appStatus parameter
 // 20250728 Fixed using ATC_MiThermometer library
+// 20261016 Replaced appPrefs by cfgImage
+//          Added startScan()/joinScan() for concurrent BLE scan (BLE_SCAN_TASK)
+//          Added isScanRunning()
 //
 // ToDo:
 // -
@@ -51,7 +54,7 @@
 
 #if defined(MITHERMOMETER_EN) || defined(THEENGSDECODER_EN)
 
-#include <Preferences.h>
+#include "ConfigImage.h"
 
 #if defined(MITHERMOMETER_EN)
 // BLE Temperature/Humidity Sensor
@@ -73,8 +76,8 @@
 class PayloadBLE
 {
 private:
-    /// Preferences (stored in flash memory)
-    Preferences appPrefs;
+    /// Configuration image (cached Preferences)
+    ConfigImage cfgImage;
 
 #ifdef THEENGSDECODER_EN
     /// Bluetooth Low Energy sensors
@@ -84,6 +87,26 @@ private:
     /// Default BLE MAC addresses
     std::vector<std::string> knownBLEAddressesDef;
 
+#if defined(BLE_SCAN_TASK)
+    /// Signalled by the BLE scan task when the scan is finished; nullptr if no scan is running
+    SemaphoreHandle_t scanDone = nullptr;
+
+    /// BLE scan mode (0: passive / 1: active) used by the BLE scan task
+    uint8_t scanActive;
+
+    /// BLE scan time in seconds used by the BLE scan task
+    uint8_t scanTime;
+
+    /*!
+     * \brief BLE scan task
+     *
+     * Runs the BLE scan and signals scanDone when finished.
+     *
+     * \param param pointer to PayloadBLE object
+     */
+    static void scanTask(void *param);
+#endif
+
 public:
     /// Actual BLE MAC addresses; either from Preferences or from defaults
     std::vector<std::string> knownBLEAddresses;
@@ -138,6 +161,31 @@ public:
      */
     void bleAddrInit(void);
 
+#if defined(BLE_SCAN_TASK)
+    /*!
+     * \brief Start BLE scan in a separate task
+     *
+     * The scan runs concurrently with the 868 MHz sensor data reception
+     * (BLE uses a separate radio). The results are collected by encodeBLE().
+     * Requires bleAddrInit() to be called before.
+     */
+    void startScan(void);
+
+    /*!
+     * \brief Wait until the BLE scan started by startScan() is finished
+     *
+     * Returns immediately if no scan is running.
+     */
+    void joinScan(void);
+
+    /*!
+     * \brief Check if the BLE scan started by startScan() is still running
+     *
+     * \returns true while the scan task is active
+     */
+    bool isScanRunning(void);
+#endif
+
     /*!
      * \brief Encode BLE temperature/humidity sensor values for LoRaWAN transmission
      *
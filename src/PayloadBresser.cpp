@@ -55,22 +55,27 @@
 // 20251222 Updated sensor types defined in BresserWeatherSensorReceiver
 // 20260430 Fix: Add check for enable bit in APP_PAYLOAD_CFG_TYPE09
 // 20260501 Fix: Changed setUpdateRate() parameter from seconds to minutes
+// 20261016 begin(): Stop reception as soon as all sensors required by
+//          appPayloadCfg have been received
+//          Added transmit-phase scheduling (sensorSchedule)
+//          Replaced findType() in encodeBresser() by lookup table sensorIdx[][]
+//          Replaced encode<Sensor>() by table-driven encodeSchema()
+//          Fix: invalid light intensity was encoded as float
+//          Replaced appPrefs by cfgImage; ws_scan_t is only written if set
 //
 //
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "PayloadBresser.h"
 
-void PayloadBresser::begin(void)
+void PayloadBresser::begin(const uint8_t *appPayloadCfg)
 {
 
-    appPrefs.begin("BWS-LW-APP", false);
-    ws_scantime = appPrefs.getUChar("ws_scan_t", 0);
+    ws_scantime = cfgImage.getUChar(E_CFG_ITEM::E_WS_SCAN_T);
 
     // Clear scan time in Preferences set in previous run
     // (additionally used as scan request flag)
-    appPrefs.putUChar("ws_scan_t", 0);
-    appPrefs.end();
+    cfgImage.putUChar(E_CFG_ITEM::E_WS_SCAN_T, 0);
     if (ws_scantime > 0)
     {
         log_d("ws_scantime: %u s", ws_scantime);
@@ -85,16 +90,217 @@ void PayloadBresser::begin(void)
         return;
     
     weatherSensor.clearSlots();
-    appPrefs.begin("BWS-LW-APP", false);
-    uint8_t ws_timeout = appPrefs.getUChar("ws_timeout", WEATHERSENSOR_TIMEOUT);
+    uint8_t ws_timeout = cfgImage.getUChar(E_CFG_ITEM::E_WS_TIMEOUT);
     log_d("Preferences: weathersensor_timeout: %u s", ws_timeout);
-    ws_postproc_interval = appPrefs.getUChar("ws_postproc_int", 0);
-    appPrefs.end();
+    ws_postproc_interval = cfgImage.getUChar(E_CFG_ITEM::E_WS_POSTPROC_INT);
 
-    log_i("Waiting for Weather Sensor Data; timeout %u s", ws_timeout);
-    bool decode_ok = weatherSensor.getData(ws_timeout * 1000, weatherSensor.rxFlags);
-    (void)decode_ok;
-    log_i("Receiving Weather Sensor Data %s", decode_ok ? "o.k." : "failed");
+    if (!setRxRequired(appPayloadCfg))
+    {
+        log_i("No Weather Sensor Data required");
+        buildSensorIdx();
+        return;
+    }
+
+    sensorSchedule.begin(rxRequired);
+
+    // Receive window predicted from learned transmit schedule (0: unknown)
+    uint32_t rx_window = sensorSchedule.rxWindow();
+    uint32_t timeout = ws_timeout * 1000UL;
+    if (rx_window && (rx_window < timeout))
+    {
+        log_i("Waiting for Weather Sensor Data; expected within %lu ms, timeout %u s", static_cast<unsigned long>(rx_window), ws_timeout);
+    }
+    else
+    {
+        log_i("Waiting for Weather Sensor Data; timeout %u s", ws_timeout);
+        rx_window = 0;
+    }
+
+    // Sensors received in this window
+    uint8_t rxDone[16] = {0};
+
+    // Data of sensors which are received again for learning their period
+    decltype(weatherSensor.sensor) rxBackup;
+
+    bool decode_ok = false;
+    uint32_t timestamp = millis();
+    while (millis() - timestamp < timeout)
+    {
+        if (rx_window && (millis() - timestamp >= rx_window))
+        {
+            // Prediction missed - fall back to full receive window
+            for (uint8_t type = 0; type < 16; type++)
+            {
+                for (uint8_t ch = 0; ch <= 7; ch++)
+                {
+                    if (((rxRequired[type] & ~rxDone[type]) >> ch) & 1)
+                        sensorSchedule.miss(type, ch);
+                }
+            }
+            rx_window = 0;
+        }
+
+        if (weatherSensor.getMessage() != DECODE_OK)
+            continue;
+
+        bool complete = true;
+        for (uint8_t type = 0; type < 16; type++)
+        {
+            for (uint8_t ch = 0; ch <= 7; ch++)
+            {
+                if (!(((rxRequired[type] & ~rxDone[type]) >> ch) & 1))
+                    continue;
+
+                if (!isRxComplete(type, ch))
+                {
+                    complete = false;
+                    continue;
+                }
+
+                sensorSchedule.update(type, ch);
+                if (sensorSchedule.isLearned(type, ch))
+                {
+                    rxDone[type] |= (1 << ch);
+                    continue;
+                }
+
+                // Learning - invalidate sensor data to detect next reception
+                for (size_t i = 0; i < weatherSensor.sensor.size(); i++)
+                {
+                    if (isRxComplete(i, type, ch))
+                    {
+                        rxBackup.push_back(weatherSensor.sensor[i]);
+                        weatherSensor.sensor[i].valid = false;
+                        weatherSensor.sensor[i].complete = false;
+                    }
+                }
+                complete = false;
+            }
+        }
+
+        if (complete)
+        {
+            decode_ok = true;
+            break;
+        }
+    }
+
+    // Restore (latest) data of sensors which have not been received again
+    for (auto backup = rxBackup.rbegin(); backup != rxBackup.rend(); ++backup)
+    {
+        if (isRxComplete(backup->s_type, backup->chan))
+            continue;
+
+        for (size_t i = 0; i < weatherSensor.sensor.size(); i++)
+        {
+            if (!weatherSensor.sensor[i].valid)
+            {
+                weatherSensor.sensor[i] = *backup;
+                break;
+            }
+        }
+    }
+    decode_ok |= isRxComplete();
+    log_i("Receiving Weather Sensor Data %s (%lu ms)", decode_ok ? "o.k." : "failed", millis() - timestamp);
+    buildSensorIdx();
+}
+
+void PayloadBresser::buildSensorIdx(void)
+{
+    memset(sensorIdx, SENSOR_IDX_NONE, sizeof(sensorIdx));
+
+    // First valid slot per (type, channel) and per type (any channel)
+    for (size_t i = 0; (i < weatherSensor.sensor.size()) && (i < SENSOR_IDX_NONE); i++)
+    {
+        const auto &sensor = weatherSensor.sensor[i];
+        if (!sensor.valid || (sensor.s_type > 15) || (sensor.chan > 7))
+            continue;
+
+        if (sensorIdx[sensor.s_type][sensor.chan] == SENSOR_IDX_NONE)
+            sensorIdx[sensor.s_type][sensor.chan] = i;
+
+        if (sensorIdx[sensor.s_type][SENSOR_IDX_ANY_CH] == SENSOR_IDX_NONE)
+            sensorIdx[sensor.s_type][SENSOR_IDX_ANY_CH] = i;
+    }
+}
+
+bool PayloadBresser::setRxRequired(const uint8_t *appPayloadCfg)
+{
+    bool required = false;
+
+    memset(rxRequired, 0, sizeof(rxRequired));
+
+    // Any weather sensor type on channel 0, see encodeBresser() and isRxComplete()
+    if (appPayloadCfg[1] & 1)
+    {
+        rxRequired[SENSOR_TYPE_WEATHER1] = 1;
+        required = true;
+    }
+
+#ifdef LIGHTNINGSENSOR_EN
+    // Lightning sensor has fixed channel (0)
+    if (appPayloadCfg[SENSOR_TYPE_LIGHTNING] & 1)
+    {
+        rxRequired[SENSOR_TYPE_LIGHTNING] = 1;
+        required = true;
+    }
+#endif
+
+    // Sensors with channel selection (channels 1...7)
+    for (uint8_t type : {SENSOR_TYPE_THERMO_HYGRO, SENSOR_TYPE_POOL_THERMO, SENSOR_TYPE_SOIL,
+                         SENSOR_TYPE_LEAKAGE, SENSOR_TYPE_AIR_PM, SENSOR_TYPE_CO2, SENSOR_TYPE_HCHO_VOC})
+    {
+        rxRequired[type] = appPayloadCfg[type] & 0xFE;
+        required |= (rxRequired[type] != 0);
+    }
+
+    return required;
+}
+
+bool PayloadBresser::isRxComplete(void)
+{
+    for (uint8_t type = 0; type < 16; type++)
+    {
+        for (uint8_t ch = 0; ch <= 7; ch++)
+        {
+            if (((rxRequired[type] >> ch) & 1) && !isRxComplete(type, ch))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool PayloadBresser::isRxComplete(uint8_t type, uint8_t ch)
+{
+    for (size_t i = 0; i < weatherSensor.sensor.size(); i++)
+    {
+        if (isRxComplete(i, type, ch))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PayloadBresser::isRxComplete(size_t idx, uint8_t type, uint8_t ch)
+{
+    const auto &sensor = weatherSensor.sensor[idx];
+
+    if (!sensor.valid || (sensor.chan != ch))
+        return false;
+
+    if (sensor.s_type != type)
+    {
+        // SENSOR_TYPE_WEATHER1 (ch 0) represents any type of weather sensor
+        if ((type != SENSOR_TYPE_WEATHER1) ||
+            ((sensor.s_type != SENSOR_TYPE_WEATHER0) &&
+             (sensor.s_type != SENSOR_TYPE_WEATHER3) &&
+             (sensor.s_type != SENSOR_TYPE_WEATHER8)))
+            return false;
+    }
+    return sensor.complete || !(weatherSensor.rxFlags & DATA_COMPLETE);
 }
 
 void PayloadBresser::scanBresser(uint8_t ws_scantime, LoraEncoder &encoder)
@@ -107,7 +313,7 @@ void PayloadBresser::scanBresser(uint8_t ws_scantime, LoraEncoder &encoder)
     // Enable all decoders
     weatherSensor.enDecoders = 0xFF;
 
-    log_i("Scanning for 868 MHz sensors (max.: %u); timeout %u s", weatherSensor.sensor.size(), ws_scantime);
+    log_i("Scanning for 868 MHz sensors (max.: %u); timeout %u s", static_cast<unsigned>(weatherSensor.sensor.size()), ws_scantime);
     weatherSensor.getData(ws_scantime * 1000, DATA_ALL_SLOTS | DATA_COMPLETE);
 
     for (size_t i = 0; i < weatherSensor.sensor.size(); i++)
@@ -176,16 +382,16 @@ void PayloadBresser::encodeBresser(uint8_t *appPayloadCfg, uint8_t *appStatus, L
     if (flags & 1)
     {
         // Try to find SENSOR_TYPE_WEATHER1
-        int idx = weatherSensor.findType(SENSOR_TYPE_WEATHER1);
+        int idx = findSensor(SENSOR_TYPE_WEATHER1);
         if (idx == -1) 
         {
             // Try to find SENSOR_TYPE_WEATHER3
-            idx = weatherSensor.findType(SENSOR_TYPE_WEATHER3);
+            idx = findSensor(SENSOR_TYPE_WEATHER3);
         }
         if (idx == -1)
         {
             // Try to find SENSOR_TYPE_WEATHER8
-            idx = weatherSensor.findType(SENSOR_TYPE_WEATHER8);
+            idx = findSensor(SENSOR_TYPE_WEATHER8);
         }
         if (idx > -1)
         {
@@ -194,7 +400,7 @@ void PayloadBresser::encodeBresser(uint8_t *appPayloadCfg, uint8_t *appStatus, L
         else
         {
             // Try to find SENSOR_TYPE_WEATHER0
-            idx = weatherSensor.findType(SENSOR_TYPE_WEATHER0);
+            idx = findSensor(SENSOR_TYPE_WEATHER0);
             rainGauge.set_max(1000);
         }
 
@@ -226,7 +432,11 @@ void PayloadBresser::encodeBresser(uint8_t *appPayloadCfg, uint8_t *appStatus, L
         {
             appStatus[1] |= 1;
         }
-        encodeWeatherSensor(idx, flags, encoder);
+        if (idx == -1)
+        {
+            log_i("-- Weather Sensor Failure");
+        }
+        encodeSchema(SENSOR_TYPE_WEATHER1, flags, idx, encoder);
     }
 
     for (int type = 2; type < 16; type++)
@@ -260,7 +470,7 @@ void PayloadBresser::encodeBresser(uint8_t *appPayloadCfg, uint8_t *appStatus, L
             if ((appPayloadCfg[SENSOR_TYPE_LIGHTNING] & 0x1) == 0)
                continue;
             
-            int idx = weatherSensor.findType(type, 0);
+            int idx = findSensor(type, 0);
             if ((idx > -1) && weatherSensor.sensor[idx].battery_ok)
             {
                 appStatus[type] |= 1;
@@ -283,7 +493,7 @@ void PayloadBresser::encodeBresser(uint8_t *appPayloadCfg, uint8_t *appStatus, L
                 }
             }
 
-            encodeLightningSensor(idx, appPayloadCfg[type], encoder);
+            encodeSchema(type, appPayloadCfg[type], idx, encoder);
             continue;
         }
 #endif
@@ -299,7 +509,7 @@ void PayloadBresser::encodeBresser(uint8_t *appPayloadCfg, uint8_t *appStatus, L
                 break;
 
             log_i("%s Sensor Ch %u", sensorTypes[type], ch);
-            int idx = weatherSensor.findType(type, ch);
+            int idx = findSensor(type, ch);
             if (idx == -1)
             {
                 log_i("-- Failure");
@@ -309,453 +519,67 @@ void PayloadBresser::encodeBresser(uint8_t *appPayloadCfg, uint8_t *appStatus, L
                 appStatus[type] |= (1 << ch);
             }
 
-            if (type == SENSOR_TYPE_THERMO_HYGRO)
-            {
-                encodeThermoHygroSensor(idx, encoder);
-            }
-            else if (type == SENSOR_TYPE_POOL_THERMO)
-            {
-                encodePoolThermometer(idx, encoder);
-            }
-            else if (type == SENSOR_TYPE_SOIL)
-            {
-                encodeSoilSensor(idx, encoder);
-            }
-            else if (type == SENSOR_TYPE_LEAKAGE)
-            {
-                encodeLeakageSensor(idx, encoder);
-            }
-            else if (type == SENSOR_TYPE_AIR_PM)
-            {
-                encodeAirPmSensor(idx, encoder);
-            }
-            else if (type == SENSOR_TYPE_CO2)
-            {
-                encodeCo2Sensor(idx, encoder);
-            }
-            else if (type == SENSOR_TYPE_HCHO_VOC)
-            {
-                encodeHchoVocSensor(idx, encoder);
-            }
+            encodeSchema(type, 0, idx, encoder);
         }
     }
 }
 
-// Payload size: 2...19 bytes (ENCODE_AS_FLOAT == false) / 2...25 bytes (ENCODE_AS_FLOAT == true)
-void PayloadBresser::encodeWeatherSensor(int idx, uint16_t flags, LoraEncoder &encoder)
+void PayloadBresser::encodeSchema(uint8_t type, uint16_t flags, int idx, LoraEncoder &encoder)
 {
-    //                    Weather Stations                  Professional  3-in-1 Professional
-    //                 5-in-1  6-in-1  7-in-1  8-in-1        Rain Gauge       Wind Gauge
-    //
-    // Temperature       X       X       X       X              X                 X
-    // Humidity          X       X       X       X                                X
-    // Wind              X       X       X       X                                X
-    // Rain              X       X       X       X              X
-    // UV                        X       X       X
-    // Light Intensity                   X       X
-    // Globe Thermometer                         X
-
-    if (idx == -1)
-    {
-        log_i("-- Weather Sensor Failure");
-        // Invalidate
-        encoder.writeTemperature(INV_TEMP); // Temperature
-        if (flags & PAYLOAD_WS_HUMIDITY)
-            encoder.writeUint8(INV_UINT8); // Humidity
-        if (flags & PAYLOAD_WS_RAINGAUGE)
-            encoder.writeRawFloat(INV_FLOAT); // Rain
-        if (flags & PAYLOAD_WS_WIND)
-        {
-#ifdef ENCODE_AS_FLOAT
-            encoder.writeRawFloat(INV_FLOAT); // Wind gust
-            encoder.writeRawFloat(INV_FLOAT); // Wind avg
-            encoder.writeRawFloat(INV_FLOAT); // Wind dir
-#else
-            encoder.writeUint16(INV_UINT16); // Wind gust
-            encoder.writeUint16(INV_UINT16); // Wind avg
-            encoder.writeUint16(INV_UINT16); // Wind dir
-#endif
-        }
-        if (flags & PAYLOAD_WS_UV)
-            encoder.writeUint8(INV_UINT8); // UV
-        if (flags & PAYLOAD_WS_LIGHT)
-            encoder.writeRawFloat(INV_UINT32); // Light
-    }
-    else
-    {
-        if (weatherSensor.sensor[idx].w.temp_ok)
-        {
-            log_i("Air Temperature:    %3.1f °C", weatherSensor.sensor[idx].w.temp_c);
-            encoder.writeTemperature(weatherSensor.sensor[idx].w.temp_c);
-        }
-        else
-        {
-            log_i("Air Temperature:     --.- °C");
-            encoder.writeTemperature(INV_TEMP);
-        }
-        if (flags & PAYLOAD_WS_HUMIDITY)
-        {
-            if (weatherSensor.sensor[idx].w.humidity_ok)
-            {
-                log_i("Humidity:            %2d   %%", weatherSensor.sensor[idx].w.humidity);
-                encoder.writeUint8(weatherSensor.sensor[idx].w.humidity);
-            }
-            else
-            {
-                log_i("Humidity:            --   %%");
-                encoder.writeUint8(INV_UINT8);
-            }
-        }
-        if (flags & PAYLOAD_WS_RAINGAUGE)
-        {
-            if (weatherSensor.sensor[idx].w.rain_ok)
-            {
-                log_i("Rain Gauge:       %7.1f mm", weatherSensor.sensor[idx].w.rain_mm);
-                encoder.writeRawFloat(weatherSensor.sensor[idx].w.rain_mm);
-            }
-            else
-            {
-                log_i("Rain Gauge:       ---.- mm");
-                encoder.writeRawFloat(INV_FLOAT);
-            }
-        }
-        if (flags & PAYLOAD_WS_WIND)
-        {
-            if (weatherSensor.sensor[idx].w.wind_ok)
-            {
-                log_i("Wind Speed (avg.):    %3.1f m/s", weatherSensor.sensor[idx].w.wind_avg_meter_sec_fp1 / 10.0);
-                log_i("Wind Speed (max.):    %3.1f m/s", weatherSensor.sensor[idx].w.wind_gust_meter_sec_fp1 / 10.0);
-                log_i("Wind Direction:     %4.1f °", weatherSensor.sensor[idx].w.wind_direction_deg_fp1 / 10.0);
-                encoder.writeUint16(weatherSensor.sensor[idx].w.wind_avg_meter_sec_fp1);
-                encoder.writeUint16(weatherSensor.sensor[idx].w.wind_gust_meter_sec_fp1);
-                encoder.writeUint16(weatherSensor.sensor[idx].w.wind_direction_deg_fp1);
-            }
-            else
-            {
-                log_i("Wind Speed (avg.):     --.- m/s");
-                log_i("Wind Speed (max.):     --.- m/s");
-                log_i("Wind Direction:     ---.- °");
-                encoder.writeUint16(INV_UINT16);
-                encoder.writeUint16(INV_UINT16);
-                encoder.writeUint16(INV_UINT16);
-            }
-        }
-        if (flags & PAYLOAD_WS_UV)
-        {
-            if (weatherSensor.sensor[idx].w.uv_ok)
-            {
-                log_i("UV Index:            %3.1f", weatherSensor.sensor[idx].w.uv);
-                encoder.writeUint8(static_cast<uint8_t>(weatherSensor.sensor[idx].w.uv * 10));
-            }
-            else
-            {
-                log_i("UV Index:            --.-");
-                encoder.writeUint8(INV_UINT8);
-            }
-        }
-        if (flags & PAYLOAD_WS_LIGHT)
-        {
-            if (weatherSensor.sensor[idx].w.light_ok)
-            {
-                log_i("Light intensity:  %06f lx", weatherSensor.sensor[idx].w.light_lux);
-                encoder.writeUint32(static_cast<uint32_t>(weatherSensor.sensor[idx].w.light_lux));
-            }
-            else
-            {
-                log_i("Light intensity:   ------ lx");
-                encoder.writeUint32(INV_UINT32);
-            }
-        }
-    }
-
-    // Rain data statistics
+    sPayloadCtx ctx = {};
+    ctx.sensor = (idx > -1) ? &weatherSensor.sensor[idx] : nullptr;
 #ifdef RAINDATA_EN
-    if ((idx > -1) && weatherSensor.sensor[idx].valid && weatherSensor.sensor[idx].w.rain_ok)
-    {
-        if (flags & PAYLOAD_WS_RAIN_H)
-        {
-            bool valid = false;
-            float rainPasthour = rainGauge.pastHour(&valid);
-            log_i("Rain past 60min:  %7.1f mm", rainPasthour);
-            if (!valid)
-            {
-                rainPasthour = INV_FLOAT;
-            }
-            encoder.writeRawFloat(rainPasthour);
-        }
-        if (flags & PAYLOAD_WS_RAIN_DWM)
-        {
-            float rain = rainGauge.currentDay();
-            log_i("Rain curr. day:   %7.1f mm", rain);
-            if (rain == -1)
-            {
-                rain = INV_FLOAT;
-            }
-            encoder.writeRawFloat(rain);
-
-            rain = rainGauge.currentWeek();
-            log_i("Rain curr. week:  %7.1f mm", rain);
-            if (rain == -1)
-            {
-                rain = INV_FLOAT;
-            }
-            encoder.writeRawFloat(rain);
-
-            rain = rainGauge.currentMonth();
-            log_i("Rain curr. month: %7.1f mm", rain);
-            if (rain == -1)
-            {
-                rain = INV_FLOAT;
-            }
-            encoder.writeRawFloat(rain);
-        }
-    }
-    else
-    {
-        log_i("Current rain gauge statistics not valid.");
-        if (flags & PAYLOAD_WS_RAIN_H)
-            encoder.writeRawFloat(INV_FLOAT);
-        if (flags & PAYLOAD_WS_RAIN_DWM)
-        {
-            encoder.writeRawFloat(INV_FLOAT);
-            encoder.writeRawFloat(INV_FLOAT);
-            encoder.writeRawFloat(INV_FLOAT);
-        }
-    }
+    ctx.rainGauge = &rainGauge;
 #endif
-
-    // Additional sensor (8-in-1)
-    if (idx == -1)
-    {
-        if (flags & PAYLOAD_WS_TGLOBE)
-            encoder.writeTemperature(INV_TEMP); // Globe Thermometer
-    }
-    else
-    {
-        if (flags & PAYLOAD_WS_TGLOBE)
-        {
-            if (weatherSensor.sensor[idx].w.tglobe_ok)
-            {
-                log_i("Globe Thermometer:   %3.1f °C", weatherSensor.sensor[idx].w.tglobe_c);
-                encoder.writeTemperature(weatherSensor.sensor[idx].w.tglobe_c);
-            }
-            else
-            {
-                log_i("Globe Thermometer:    --.- °C");
-                encoder.writeTemperature(INV_TEMP);
-            }
-        }
-    }
-}
-
-void PayloadBresser::encodeThermoHygroSensor(int idx, LoraEncoder &encoder)
-{
-    if (idx == -1)
-    {
-        // Invalidate
-        encoder.writeTemperature(INV_TEMP);
-        encoder.writeUint8(INV_UINT8);
-    }
-    else
-    {
-        log_i("Temperature: %3.1f °C", weatherSensor.sensor[idx].w.temp_c);
-        log_i("Humidity:     %2d   %%", weatherSensor.sensor[idx].w.humidity);
-        encoder.writeTemperature(weatherSensor.sensor[idx].w.temp_c);
-        encoder.writeUint8(weatherSensor.sensor[idx].w.humidity);
-    }
-}
-
-void PayloadBresser::encodePoolThermometer(int idx, LoraEncoder &encoder)
-{
-    if (idx == -1)
-    {
-        // Invalidate
-        encoder.writeTemperature(INV_TEMP);
-    }
-    else
-    {
-        log_i("Temperature: %3.1f °C", weatherSensor.sensor[idx].w.temp_c);
-        encoder.writeTemperature(weatherSensor.sensor[idx].w.temp_c);
-    }
-}
-
-void PayloadBresser::encodeSoilSensor(int idx, LoraEncoder &encoder)
-{
-    if (idx == -1)
-    {
-        // Invalidate
-        encoder.writeTemperature(INV_TEMP);
-        encoder.writeUint8(INV_UINT8);
-    }
-    else
-    {
-        log_i("Soil Temperature: %3.1f °C", weatherSensor.sensor[idx].soil.temp_c);
-        log_i("Soil Moisture:     %2d   %%", weatherSensor.sensor[idx].soil.moisture);
-        encoder.writeTemperature(weatherSensor.sensor[idx].soil.temp_c);
-        encoder.writeUint8(weatherSensor.sensor[idx].soil.moisture);
-    }
-}
-
-void PayloadBresser::encodeLeakageSensor(int idx, LoraEncoder &encoder)
-{
-    if (idx == -1)
-    {
-        // Invalidate
-        encoder.writeUint8(INV_UINT8);
-    }
-    else
-    {
-        log_i("Leakage Alarm:      %u", weatherSensor.sensor[idx].leak.alarm);
-        encoder.writeUint8(weatherSensor.sensor[idx].leak.alarm ? 1 : 0);
-    }
-}
-
-void PayloadBresser::encodeAirPmSensor(int idx, LoraEncoder &encoder)
-{
-    if (idx == -1)
-    {
-        // Invalidate
-        encoder.writeUint16(INV_UINT16);
-        encoder.writeUint16(INV_UINT16);
-        encoder.writeUint16(INV_UINT16);
-    }
-    else
-    {
-        if (weatherSensor.sensor[idx].pm.pm_1_0_init)
-        {
-            log_i("PM1.0: init");
-            encoder.writeUint16(INV_UINT16);
-        }
-        else
-        {
-            log_i("PM1.0: %u µg/m³", weatherSensor.sensor[idx].pm.pm_1_0);
-            encoder.writeUint16(weatherSensor.sensor[idx].pm.pm_1_0);
-        }
-        if (weatherSensor.sensor[idx].pm.pm_2_5_init)
-        {
-            log_i("PM2.5: init");
-            encoder.writeUint16(INV_UINT16);
-        }
-        else
-        {
-            log_i("PM2.5: %u µg/m³", weatherSensor.sensor[idx].pm.pm_2_5);
-            encoder.writeUint16(weatherSensor.sensor[idx].pm.pm_2_5);
-        }
-        if (weatherSensor.sensor[idx].pm.pm_10_init)
-        {
-            log_i("PM10: init");
-            encoder.writeUint16(INV_UINT16);
-        }
-        else
-        {
-            log_i("PM10: %u µg/m³", weatherSensor.sensor[idx].pm.pm_10);
-            encoder.writeUint16(weatherSensor.sensor[idx].pm.pm_10);
-        }
-    }
-}
-
 #ifdef LIGHTNINGSENSOR_EN
-// Payload size: 3 bytes (raw) / 7 bytes (pre-processed) / 10 bytes (both)
-void PayloadBresser::encodeLightningSensor(int idx, uint8_t flags, LoraEncoder &encoder)
-{
-    if (flags & PAYLOAD_LIGHTNING_RAW)
+    if ((type == SENSOR_TYPE_LIGHTNING) && (flags & PAYLOAD_LIGHTNING_PROC))
     {
-        // Raw sensor values
-        if (idx == -1)
-        {
-            // Invalidate
-            encoder.writeUint8(INV_UINT8);
-            encoder.writeUint16(INV_UINT16);
-        }
-        else
-        {
-            log_i("Lightning Distance:      %2u km", weatherSensor.sensor[idx].lgt.distance_km);
-            log_i("Lightning Strike Count %4u", weatherSensor.sensor[idx].lgt.strike_count);
-            encoder.writeUint8(weatherSensor.sensor[idx].lgt.distance_km);
-            encoder.writeUint16(weatherSensor.sensor[idx].lgt.strike_count);
-        }
-    }
-
-    if (flags & PAYLOAD_LIGHTNING_PROC)
-    {
-        // Post-processed sensor values
-        if (lightningProc.lastEvent(lightn_ts, lightn_events, lightn_distance))
-        {
-#if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
-            struct tm timeinfo;
-            char tbuf[25];
-
-            localtime_r(&lightn_ts, &timeinfo);
-            strftime(tbuf, 25, "%Y-%m-%d %H:%M:%S", &timeinfo);
-#endif
-            log_i("Last lightning event @%s: %d events, %d km", tbuf, lightn_events, lightn_distance);
-            encoder.writeUnixtime(lightn_ts);
-            encoder.writeUint16(lightn_events);
-            encoder.writeUint8(lightn_distance);
-        }
-        else
-        {
-            log_i("-- No Lightning Event Data Available");
-            encoder.writeUint32(INV_UINT32);
-            encoder.writeUint16(INV_UINT16);
-            encoder.writeUint8(INV_UINT8);
-        }
+        ctx.lgtEvValid = lightningProc.lastEvent(ctx.lgtEvTs, ctx.lgtEvEvents, ctx.lgtEvDistance);
     }
-}
 #endif
 
-void PayloadBresser::encodeCo2Sensor(int idx, LoraEncoder &encoder)
-{
-    if (idx == -1)
-    {
-        // Invalidate
-        encoder.writeUint16(INV_UINT16);
-    }
-    else
-    {
-        if (weatherSensor.sensor[idx].co2.co2_init)
-        {
-            log_i("CO2: init");
-            encoder.writeUint16(INV_UINT16);
-        }
-        else
-        {
-            log_i("CO2: %4u", weatherSensor.sensor[idx].co2.co2_ppm);
-            encoder.writeUint16(weatherSensor.sensor[idx].co2.co2_ppm);
-        }
-    }
-}
-
-void PayloadBresser::encodeHchoVocSensor(int idx, LoraEncoder &encoder)
-{
-    if (idx == -1)
+    for (const auto &field : payloadSchema)
     {
-        // Invalidate
-        encoder.writeUint16(INV_UINT16);
-        encoder.writeUint8(INV_UINT8);
-    }
-    else
-    {
-        if (weatherSensor.sensor[idx].voc.hcho_init)
-        {
-            log_i("HCHO: init");
-            encoder.writeUint16(INV_UINT16);
-        }
-        else
-        {
-            log_i("HCHO: %u", weatherSensor.sensor[idx].voc.hcho_ppb);
-            encoder.writeUint16(weatherSensor.sensor[idx].voc.hcho_ppb);
-        }
+        if ((field.type != type) || ((field.flag != 0) && !(flags & field.flag)))
+            continue;
 
-        if (weatherSensor.sensor[idx].voc.voc_init)
+        double value = 0;
+        bool valid = field.get(ctx, value);
+        if (valid)
         {
-            log_i("VOC: init");
-            encoder.writeUint8(INV_UINT8);
+            log_i("%-20s %.1f", field.name, value);
         }
         else
         {
-            log_i("VOC: %u", weatherSensor.sensor[idx].voc.voc_level);
-            encoder.writeUint8(weatherSensor.sensor[idx].voc.voc_level);
+            log_i("%-20s ---", field.name);
+        }
+
+        switch (field.enc)
+        {
+        case E_PAYLOAD_ENC::E_TEMPERATURE:
+            encoder.writeTemperature(valid ? static_cast<float>(value) : INV_TEMP);
+            break;
+        case E_PAYLOAD_ENC::E_UINT8:
+            encoder.writeUint8(valid ? static_cast<uint8_t>(value) : INV_UINT8);
+            break;
+        case E_PAYLOAD_ENC::E_UINT8FP1:
+            encoder.writeUint8(valid ? static_cast<uint8_t>(lround(value * 10)) : INV_UINT8);
+            break;
+        case E_PAYLOAD_ENC::E_UINT16:
+            encoder.writeUint16(valid ? static_cast<uint16_t>(value) : INV_UINT16);
+            break;
+        case E_PAYLOAD_ENC::E_UINT16FP1:
+            encoder.writeUint16(valid ? static_cast<uint16_t>(lround(value * 10)) : INV_UINT16);
+            break;
+        case E_PAYLOAD_ENC::E_UINT32:
+            encoder.writeUint32(valid ? static_cast<uint32_t>(value) : INV_UINT32);
+            break;
+        case E_PAYLOAD_ENC::E_RAWFLOAT:
+            encoder.writeRawFloat(valid ? static_cast<float>(value) : INV_FLOAT);
+            break;
+        case E_PAYLOAD_ENC::E_UNIXTIME:
+            encoder.writeUnixtime(valid ? static_cast<uint32_t>(value) : INV_UINT32);
+            break;
         }
     }
 }
@@ -45,6 +45,14 @@
 // 20250318 Renamed PAYLOAD_SIZE to MAX_UPLINK_SIZE
 // 20250828 Changed time functions to POSIX, added SystemContext
 //          Added ws_postproc_int
+// 20261016 Added rxRequired[], setRxRequired() and isRxComplete()
+//          begin(): added appPayloadCfg parameter
+//          Added sensorSchedule
+//          Added sensorIdx[][], buildSensorIdx() and findSensor()
+//          Replaced encode<Sensor>() and payloadSize[] by encodeSchema()
+//          and payload schema (PayloadSchema.h)
+//          Replaced appPrefs by cfgImage
+//          Payload size limited by MAX_SENSOR_PAYLOAD_SIZE
 //
 // ToDo:
 // -
@@ -62,7 +70,7 @@
 #include "WeatherSensorCfg.h"
 #include <WeatherSensor.h>
 #include <time.h>
-#include <Preferences.h>
+#include "ConfigImage.h"
 
 #ifdef RAINDATA_EN
 #include "RainGauge.h"
@@ -70,12 +78,20 @@
 #ifdef LIGHTNINGSENSOR_EN
 #include "Lightning.h"
 #endif
+#include "PayloadSchema.h"
 
 #include <LoraMessage.h>
 #include "SystemContext.h"
+#include "SensorSchedule.h"
 #include "logging.h"
 
 
+/// Sensor index lookup table: no sensor
+#define SENSOR_IDX_NONE 0xFF
+
+/// Sensor index lookup table: column for any channel
+#define SENSOR_IDX_ANY_CH 8
+
 /*!
  * \brief LoRaWAN node application layer - Bresser sensors
  *
@@ -93,25 +109,8 @@ public:
     /// Weather Sensor Post-Processing Update Rate (0: auto, 1..255: minutes)
     uint8_t ws_postproc_interval = 0;
 
-    /// Payload size in bytes per sensor type
-    const uint8_t payloadSize[16] = {
-        0,
-        25, // SENSOR_TYPE_WEATHER<0|1|2> (max.)
-        3, // SENSOR_TYPE_THERMO_HYGRO
-        2, // SENSOR_TYPE_POOL_THERMO
-        3, // SENSOR_TYPE_SOIL
-        1, // SENSOR_TYPE_LEAKAGE
-        0, // reserved
-        0, // reserved
-        6, // SENSOR_TYPE_AIR_PM
-        3, // SENSOR_TYPE_LIGHTNING (min.)
-        2, // SENSOR_TYPE_CO2
-        3, // SENSOR_TYPE_HCHO_VOC
-        0, // reserved
-        0, // (Weather Station 8-in-1, included in [1])
-        0, // reserved
-        0 // reserved
-    };
+    /// Transmit-phase schedule of required sensors
+    SensorSchedule sensorSchedule;
 
 #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
     /// Map sensor type ID to name
@@ -139,9 +138,16 @@ private:
     /// System context
     SystemContext *_sysCtx;
 
-    /// Preferences (stored in flash memory)
-    Preferences appPrefs;
+    /// Configuration image (cached Preferences)
+    ConfigImage cfgImage;
+
 
+    /// Sensor data slot index per sensor type and channel (column 8: any channel)
+    uint8_t sensorIdx[16][9];
+
+    /// Required sensors (bitmap of channels per sensor type, see appPayloadCfg)
+    /// SENSOR_TYPE_WEATHER1 (ch 0) represents any type of weather sensor
+    uint8_t rxRequired[16] = {0};
 
 #ifdef RAINDATA_EN
 public:
@@ -153,11 +159,6 @@ public:
 public:
     /// Lightning sensor post-processing
     Lightning lightningProc;
-
-private:
-    time_t lightn_ts;
-    int lightn_events;
-    uint8_t lightn_distance;
 #endif
 
 public:
@@ -167,12 +168,18 @@ public:
     PayloadBresser(SystemContext* sysCtx)
     {
         _sysCtx = sysCtx;
+        memset(sensorIdx, SENSOR_IDX_NONE, sizeof(sensorIdx));
     };
 
     /*!
      * \brief Bresser sensors startup code
+     *
+     * Receives sensor data until all sensors required by appPayloadCfg
+     * have been received or the timeout has expired.
+     *
+     * \param appPayloadCfg LoRaWAN payload configuration bitmaps
      */
-    void begin(void);
+    void begin(const uint8_t *appPayloadCfg);
 
     /*!
      * \brief Scan for Bresser sensors
@@ -192,21 +199,92 @@ public:
     void encodeBresser(uint8_t *appPayloadCfg, uint8_t *appStatus, LoraEncoder &encoder);
 
 private:
-    void encodeWeatherSensor(int idx, uint16_t flags, LoraEncoder &encoder);
-    void encodeThermoHygroSensor(int idx, LoraEncoder &encoder);
-    void encodePoolThermometer(int idx, LoraEncoder &encoder);
-    void encodeSoilSensor(int idx, LoraEncoder &encoder);
-    void encodeLeakageSensor(int idx, LoraEncoder &encoder);
-    void encodeAirPmSensor(int idx, LoraEncoder &encoder);
-#ifdef LIGHTNINGSENSOR_EN
-    void encodeLightningSensor(int idx, uint8_t flags, LoraEncoder &encoder);
-#endif
-    void encodeCo2Sensor(int idx, LoraEncoder &encoder);
-    void encodeHchoVocSensor(int idx, LoraEncoder &encoder);
+    /*!
+     * \brief Set required sensors from payload configuration
+     *
+     * Reflects the selection of sensors in encodeBresser().
+     *
+     * \param appPayloadCfg LoRaWAN payload configuration bitmaps
+     *
+     * \returns true if any sensor is required
+     */
+    bool setRxRequired(const uint8_t *appPayloadCfg);
+
+    /*!
+     * \brief Check if data of all required sensors has been received
+     *
+     * \returns true if all required sensors have been received
+     */
+    bool isRxComplete(void);
 
-    bool isSpaceLeft(LoraEncoder &encoder, uint8_t type)
+    /*!
+     * \brief Check if data of a sensor has been received
+     *
+     * \param type sensor type
+     * \param ch   channel
+     *
+     * \returns true if sensor data has been received
+     */
+    bool isRxComplete(uint8_t type, uint8_t ch);
+
+    /*!
+     * \brief Check if a sensor data slot contains data of a sensor
+     *
+     * \param idx  sensor data slot index
+     * \param type sensor type
+     * \param ch   channel
+     *
+     * \returns true if slot contains (complete) sensor data
+     */
+    bool isRxComplete(size_t idx, uint8_t type, uint8_t ch);
+
+    /*!
+     * \brief Build sensor index lookup table from received sensor data
+     *
+     * Must be called after reception, before encodeBresser().
+     */
+    void buildSensorIdx(void);
+
+    /*!
+     * \brief Find sensor data slot by sensor type and channel
+     *
+     * Lookup table based replacement for WeatherSensor::findType().
+     *
+     * \param type sensor type
+     * \param ch   channel (0xFF: any channel)
+     *
+     * \returns sensor data slot index or -1 if not found
+     */
+    int findSensor(uint8_t type, uint8_t ch = 0xFF)
+    {
+        uint8_t idx = sensorIdx[type & 0xF][(ch == 0xFF) ? SENSOR_IDX_ANY_CH : (ch & 0x7)];
+        return (idx == SENSOR_IDX_NONE) ? -1 : idx;
+    };
+
+    /*!
+     * \brief Encode sensor data according to payload schema
+     *
+     * Invalid or missing values are encoded as INV_*.
+     *
+     * \param type    sensor type (SENSOR_TYPE_*)
+     * \param flags   configuration flags (PAYLOAD_WS_* / PAYLOAD_LIGHTNING_*)
+     * \param idx     sensor data slot index or -1 if not received
+     * \param encoder LoRaWAN payload encoder object
+     */
+    void encodeSchema(uint8_t type, uint16_t flags, int idx, LoraEncoder &encoder);
+
+    /*!
+     * \brief Check if sensor data fits into uplink payload
+     *
+     * \param encoder LoRaWAN payload encoder object
+     * \param type    sensor type (SENSOR_TYPE_*)
+     * \param flags   configuration flags (PAYLOAD_WS_* / PAYLOAD_LIGHTNING_*)
+     *
+     * \returns true if space is left
+     */
+    bool isSpaceLeft(LoraEncoder &encoder, uint8_t type, uint16_t flags = 0)
     {
-        return (encoder.getLength() + payloadSize[type] <= MAX_UPLINK_SIZE); 
+        return (encoder.getLength() + payloadBytes(type, flags) <= MAX_SENSOR_PAYLOAD_SIZE);
     };
 };
 #endif //_PAYLOAD_BRESSER
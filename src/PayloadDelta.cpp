@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadDelta.cpp
+//
+// Delta encoding of the sensor data uplink for BresserWeatherSensorLW
+//
+// - Keeps the last keyframe (complete sensor data payload) in memory which
+//   is retained during deep sleep
+// - Encodes the sensor data as bitmap of changed bytes plus the changed
+//   bytes if this is shorter than the complete payload
+// - Sends a keyframe every PAYLOAD_DELTA_KEYFRAME_INTERVAL frames, if the
+//   payload layout has changed or if requested via downlink
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added diff() for use by SampleBatch
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file PayloadDelta.cpp
+ *  \brief Delta encoding of the sensor data uplink for BresserWeatherSensorLW
+ */
+
+#include "PayloadDelta.h"
+
+/// Marker for valid retained keyframe
+#define PAYLOAD_DELTA_MAGIC 0x44454C54UL
+
+/// Keyframe
+struct sPayloadKeyframe
+{
+    uint32_t magic;                    //!< PAYLOAD_DELTA_MAGIC if valid
+    bool request;                      //!< keyframe requested
+    uint8_t frames;                    //!< delta frames sent since keyframe
+    uint8_t size;                      //!< keyframe size in bytes
+    uint8_t cfg[APP_PAYLOAD_CFG_SIZE]; //!< effective payload configuration of keyframe
+    uint8_t payload[MAX_UPLINK_SIZE];  //!< keyframe payload
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sPayloadKeyframe payloadKeyframe = {0}; //!< last keyframe
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sPayloadKeyframe payloadKeyframe __attribute__((section(".uninitialized_data"))); //!< last keyframe
+#endif
+
+void PayloadDelta::requestKeyframe(void)
+{
+    log_i("Keyframe requested");
+    payloadKeyframe.request = true;
+}
+
+uint8_t PayloadDelta::encode(uint8_t *payload, uint8_t size, const uint8_t *cfg, uint8_t maxLen)
+{
+    bool keyframe = false;
+
+    if (payloadKeyframe.magic != PAYLOAD_DELTA_MAGIC)
+    {
+        // Uninitialized after power-on/HW reset
+        keyframe = true;
+    }
+    else if (payloadKeyframe.request)
+    {
+        keyframe = true;
+    }
+    else if (payloadKeyframe.frames + 1 >= PAYLOAD_DELTA_KEYFRAME_INTERVAL)
+    {
+        keyframe = true;
+    }
+    else if ((size != payloadKeyframe.size) || (memcmp(cfg, payloadKeyframe.cfg, APP_PAYLOAD_CFG_SIZE) != 0))
+    {
+        log_d("Payload layout changed");
+        keyframe = true;
+    }
+
+    uint8_t delta[MAX_UPLINK_SIZE + 1 + (MAX_UPLINK_SIZE + 7) / 8];
+    uint8_t deltaSize = 0;
+    if (!keyframe)
+    {
+        delta[0] = crc8(payloadKeyframe.payload, payloadKeyframe.size);
+        deltaSize = 1 + diff(payloadKeyframe.payload, payload, size, &delta[1]);
+
+        // Delta frame is only used if it is shorter and does not require fragmentation
+        if ((deltaSize >= size) || (deltaSize > maxLen))
+        {
+            log_d("Delta frame (%u bytes) not shorter than payload (%u bytes)", deltaSize, size);
+            keyframe = true;
+        }
+    }
+
+    if (keyframe)
+    {
+        log_i("Sending keyframe (%u bytes)", size);
+        payloadKeyframe.magic = PAYLOAD_DELTA_MAGIC;
+        payloadKeyframe.request = false;
+        payloadKeyframe.frames = 0;
+        payloadKeyframe.size = min(size, MAX_UPLINK_SIZE);
+        memcpy(payloadKeyframe.cfg, cfg, APP_PAYLOAD_CFG_SIZE);
+        memcpy(payloadKeyframe.payload, payload, payloadKeyframe.size);
+        return 0;
+    }
+
+    log_i("Sending delta frame (%u bytes instead of %u)", deltaSize, size);
+    payloadKeyframe.frames++;
+    memcpy(payload, delta, deltaSize);
+    return deltaSize;
+}
+
+uint8_t PayloadDelta::diff(const uint8_t *ref, const uint8_t *payload, uint8_t size, uint8_t *out)
+{
+    uint8_t bitmapSize = (size + 7) / 8;
+    uint8_t len = bitmapSize;
+
+    memset(out, 0, bitmapSize);
+    for (uint8_t i = 0; i < size; i++)
+    {
+        if (payload[i] != ref[i])
+        {
+            out[i / 8] |= 1 << (i % 8);
+            out[len++] = payload[i];
+        }
+    }
+    return len;
+}
+
+uint8_t PayloadDelta::crc8(const uint8_t *buf, uint8_t size)
+{
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < size; i++)
+    {
+        crc ^= buf[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadDelta.h
+//
+// Delta encoding of the sensor data uplink for BresserWeatherSensorLW
+//
+// - Keeps the last keyframe (complete sensor data payload) in memory which
+//   is retained during deep sleep
+// - Encodes the sensor data as bitmap of changed bytes plus the changed
+//   bytes if this is shorter than the complete payload
+// - Sends a keyframe every PAYLOAD_DELTA_KEYFRAME_INTERVAL frames, if the
+//   payload layout has changed or if requested via downlink
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added diff() for use by SampleBatch
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file PayloadDelta.h
+ *  \brief Delta encoding of the sensor data uplink for BresserWeatherSensorLW
+ */
+
+#if !defined(_PAYLOAD_DELTA_H)
+#define _PAYLOAD_DELTA_H
+
+#include <Arduino.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "logging.h"
+
+/*!
+ * \brief Delta encoding of the sensor data uplink
+ *
+ * Delta frame (PAYLOAD_DELTA_PORT):
+ *
+ * byte 0:      CRC-8 of the keyframe
+ * byte 1...n:  bitmap of changed bytes (bit i of byte i/8 set: keyframe byte i changed)
+ * byte n+1...: changed bytes in order of their position
+ *
+ * The delta always refers to the keyframe, not to the previous frame -
+ * a lost delta frame does not affect the following ones. A lost keyframe
+ * is detected by the decoder from the CRC.
+ *
+ * Multi-byte values which change only slightly typically differ in their
+ * least significant byte only, i.e. only this byte is sent.
+ */
+class PayloadDelta
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    PayloadDelta() {};
+
+    /*!
+     * \brief Request a keyframe with the next sensor data uplink
+     */
+    void requestKeyframe(void);
+
+    /*!
+     * \brief Encode sensor data payload
+     *
+     * If a keyframe is due or the delta frame is not shorter than the
+     * payload, the payload is stored as keyframe and left unchanged.
+     * Otherwise, the payload is replaced by the delta frame.
+     *
+     * \param payload payload buffer (sensor data, port 1)
+     * \param size    payload size in bytes
+     * \param cfg     effective payload configuration
+     * \param maxLen  max. payload size (node.getMaxPayloadLen())
+     *
+     * \returns size of delta frame, 0 if payload is sent as keyframe
+     */
+    uint8_t encode(uint8_t *payload, uint8_t size, const uint8_t *cfg, uint8_t maxLen);
+
+    /*!
+     * \brief Encode difference between two payloads of the same size
+     *
+     * Writes a bitmap of changed bytes ((size + 7) / 8 bytes; bit i of
+     * byte i/8 set: byte i changed), followed by the changed bytes.
+     *
+     * \param ref     reference payload
+     * \param payload payload
+     * \param size    payload size in bytes
+     * \param out     output buffer (at least size + (size + 7) / 8 bytes)
+     *
+     * \returns number of bytes written
+     */
+    static uint8_t diff(const uint8_t *ref, const uint8_t *payload, uint8_t size, uint8_t *out);
+
+private:
+    /*!
+     * \brief Calculate CRC-8 (polynomial 0x07, initial value 0x00)
+     *
+     * \param buf  data buffer
+     * \param size data size in bytes
+     *
+     * \returns CRC-8
+     */
+    uint8_t crc8(const uint8_t *buf, uint8_t size);
+};
+
+#endif // _PAYLOAD_DELTA_H
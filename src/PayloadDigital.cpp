@@ -35,6 +35,9 @@
 // 20240524 Added payload size check, changed bitmap order
 // 20250318 Renamed PAYLOAD_SIZE to MAX_UPLINK_SIZE
 // 20260210 Refactored sensor integration for cleaner separation
+// 20261016 Added trigger(), log spread of distance sensor readings
+//          Trigger all DYP-R01CW sensors at once
+//          Payload size limited by MAX_SENSOR_PAYLOAD_SIZE
 //
 // ToDo:
 // -
@@ -65,6 +68,42 @@ void PayloadDigital::begin(void)
 #endif
 }
 
+bool PayloadDigital::isEnabled(uint8_t *appPayloadCfg, unsigned ch)
+{
+    // Channels are counted downwards, starting with bit 0 of the last byte
+    unsigned pos = (APP_PAYLOAD_BYTES_DIGITAL * 8) - 1 - ch;
+    uint8_t i = APP_PAYLOAD_BYTES_DIGITAL - 1 - (pos / 8);
+
+    return (appPayloadCfg[APP_PAYLOAD_OFFS_DIGITAL + i] >> (pos % 8)) & 0x1;
+}
+
+void PayloadDigital::trigger(uint8_t *appPayloadCfg)
+{
+    (void)appPayloadCfg;
+#ifdef A02YYUW_EN
+    if (m_distanceSensor && isEnabled(appPayloadCfg, A02YYUW_CH))
+    {
+        m_distanceSensor->trigger();
+    }
+#endif
+
+#ifdef DYP_R01CW_EN
+    // Trigger all DYP-R01CW sensors with enabled channels at once -
+    // the results are collected after a single ranging time (see encodeDigital())
+    size_t dypSensorIdx = 0;
+    for (int ch = (APP_PAYLOAD_BYTES_DIGITAL * 8) - 1; ch >= 0; ch--)
+    {
+        if (dypSensorIdx >= m_dypR01cwSensors.size())
+            break;
+
+        if (isEnabled(appPayloadCfg, ch))
+        {
+            m_dypR01cwSensors[dypSensorIdx++]->trigger();
+        }
+    }
+#endif
+}
+
 void PayloadDigital::encodeDigital(uint8_t *appPayloadCfg, LoraEncoder &encoder)
 {
     unsigned ch = (APP_PAYLOAD_BYTES_DIGITAL * 8) - 1;
@@ -79,12 +118,13 @@ void PayloadDigital::encodeDigital(uint8_t *appPayloadCfg, LoraEncoder &encoder)
             {
 #ifdef A02YYUW_EN
                 // Check if channel is enabled
-                if ((ch == A02YYUW_CH) && (encoder.getLength() <= MAX_UPLINK_SIZE - 2))
+                if ((ch == A02YYUW_CH) && (encoder.getLength() <= MAX_SENSOR_PAYLOAD_SIZE - 2))
                 {
                     uint16_t distance_mm = m_distanceSensor->read();
                     if (distance_mm > 0)
                     {
-                        log_i("ch %02u: Distance:          %4d mm", ch, distance_mm);
+                        log_i("ch %02u: Distance:          %4d mm (spread: %u mm)", ch, distance_mm,
+                              m_distanceSensor->getSpread());
                     }
                     else
                     {
@@ -96,7 +136,7 @@ void PayloadDigital::encodeDigital(uint8_t *appPayloadCfg, LoraEncoder &encoder)
 #ifdef DYP_R01CW_EN
                 // DYP-R01CW sensors - consecutive channels starting from highest digital channel
                 // Each enabled channel corresponds to a sensor from the address list
-                if ((dypSensorIdx < m_dypR01cwSensors.size()) && (encoder.getLength() <= MAX_UPLINK_SIZE - 2))
+                if ((dypSensorIdx < m_dypR01cwSensors.size()) && (encoder.getLength() <= MAX_SENSOR_PAYLOAD_SIZE - 2))
                 {
                     uint16_t distance_mm = m_dypR01cwSensors[dypSensorIdx]->read();
                     if (distance_mm > 0)
@@ -32,6 +32,7 @@
 // History:
 //
 // 20240520 Created
+// 20261016 Added trigger()
 //
 // ToDo:
 // -
@@ -99,6 +100,16 @@ public:
      */
     void begin(void);
 
+    /*!
+     * \brief Start measurements of enabled sensors
+     *
+     * Called at the start of the wake cycle - the sensors warm up/measure
+     * while other tasks are performed.
+     *
+     * \param appPayloadCfg LoRaWAN payload configuration bitmaps
+     */
+    void trigger(uint8_t *appPayloadCfg);
+
     /*!
      * \brief Encode digital data channels for LoRaWAN transmission
      *
@@ -109,10 +120,20 @@ public:
 
 private:
 #ifdef A02YYUW_EN
-    DigitalSensor *m_distanceSensor; //!< Distance sensor instance
+    DistanceSensor *m_distanceSensor; //!< Distance sensor instance
 #endif
 #ifdef DYP_R01CW_EN
     std::vector<DigitalSensor *> m_dypR01cwSensors; //!< DYP-R01CW sensor instances
 #endif
+
+    /*!
+     * \brief Check if digital channel is enabled
+     *
+     * \param appPayloadCfg LoRaWAN payload configuration bitmaps
+     * \param ch channel (see encodeDigital())
+     *
+     * \returns true if enabled
+     */
+    static bool isEnabled(uint8_t *appPayloadCfg, unsigned ch);
 };
 #endif //_PAYLOAD_DIGITAL
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadFragmenter.cpp
+//
+// Uplink payload fragmentation for BresserWeatherSensorLW
+//
+// - Splits a sensor data payload which exceeds the maximum payload size of
+//   the current data rate into sequence-numbered fragments
+// - The fragments are sent in consecutive uplinks (PAYLOAD_FRAGMENT_PORT)
+//   and reassembled by the uplink formatter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Payload size limited by MAX_SENSOR_PAYLOAD_SIZE instead of MAX_UPLINK_SIZE
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file PayloadFragmenter.cpp
+ *  \brief Uplink payload fragmentation for BresserWeatherSensorLW
+ */
+
+#include "PayloadFragmenter.h"
+
+// Variables which must retain their values after deep sleep
+// (any initial value of the sequence number is valid)
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR uint8_t fragmentSeq; //!< message sequence number
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+uint8_t fragmentSeq __attribute__((section(".uninitialized_data"))); //!< message sequence number
+#endif
+
+void PayloadFragmenter::begin(const uint8_t *payload, uint8_t size)
+{
+    this->size = min(size, MAX_SENSOR_PAYLOAD_SIZE);
+    memcpy(buf, payload, this->size);
+    offset = 0;
+    idx = 0;
+    seq = fragmentSeq++ & 0x0F;
+    log_i("Fragmenting payload; seq %u, size %u", seq, this->size);
+}
+
+uint8_t PayloadFragmenter::next(uint8_t *frag, uint8_t maxLen)
+{
+    if (!pending() || (maxLen < 2))
+        return 0;
+
+    uint8_t len = min(static_cast<uint8_t>(size - offset), static_cast<uint8_t>(maxLen - 1));
+    if ((idx == FRAGMENT_IDX_MASK) && (offset + len < size))
+    {
+        // Only if the max. payload size is much smaller than MAX_UPLINK_SIZE (e.g. US915 DR0: 11 bytes)
+        log_w("Too many fragments - discarding %u bytes", size - offset - len);
+        size = offset + len;
+    }
+
+    bool last = (offset + len == size);
+    frag[0] = (seq << FRAGMENT_SEQ_SHIFT) | (last ? FRAGMENT_LAST : 0) | idx;
+    memcpy(&frag[1], &buf[offset], len);
+    log_d("Fragment %u%s: %u bytes", idx, last ? " (last)" : "", len);
+
+    offset += len;
+    idx++;
+
+    return len + 1;
+}
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadFragmenter.h
+//
+// Uplink payload fragmentation for BresserWeatherSensorLW
+//
+// - Splits a sensor data payload which exceeds the maximum payload size of
+//   the current data rate into sequence-numbered fragments
+// - The fragments are sent in consecutive uplinks (PAYLOAD_FRAGMENT_PORT)
+//   and reassembled by the uplink formatter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Payload buffer sized for MAX_SENSOR_PAYLOAD_SIZE
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file PayloadFragmenter.h
+ *  \brief Uplink payload fragmentation for BresserWeatherSensorLW
+ */
+
+#if !defined(_PAYLOAD_FRAGMENTER_H)
+#define _PAYLOAD_FRAGMENTER_H
+
+#include <Arduino.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "logging.h"
+
+/// Fragment header: message sequence number (bits 7..4)
+#define FRAGMENT_SEQ_SHIFT 4
+
+/// Fragment header: last fragment flag (bit 3)
+#define FRAGMENT_LAST 0x08
+
+/// Fragment header: fragment index (bits 2..0)
+#define FRAGMENT_IDX_MASK 0x07
+
+/// Max. number of fragments per message
+#define FRAGMENT_MAX_NUM (FRAGMENT_IDX_MASK + 1)
+
+/*!
+ * \brief Uplink payload fragmentation
+ *
+ * Each fragment starts with a header byte, followed by the next part of the
+ * payload:
+ *
+ * bit 7..4: message sequence number (modulo 16)
+ * bit 3:    last fragment
+ * bit 2..0: fragment index
+ *
+ * The fragment size is determined when the fragment is sent - i.e. the
+ * data rate may change between fragments. The payload is reassembled by
+ * concatenating the fragments of a message in order of their index.
+ */
+class PayloadFragmenter
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    PayloadFragmenter() {};
+
+    /*!
+     * \brief Start fragmentation of a payload
+     *
+     * The payload is copied; the message sequence number is incremented.
+     *
+     * \param payload payload buffer
+     * \param size    payload size in bytes (max. MAX_SENSOR_PAYLOAD_SIZE)
+     */
+    void begin(const uint8_t *payload, uint8_t size);
+
+    /*!
+     * \brief Check if fragments are pending
+     *
+     * \returns true if not all fragments have been provided by next()
+     */
+    bool pending(void)
+    {
+        return offset < size;
+    };
+
+    /*!
+     * \brief Get next fragment
+     *
+     * \param frag   fragment buffer (at least maxLen bytes)
+     * \param maxLen max. payload size (node.getMaxPayloadLen())
+     *
+     * \returns fragment size in bytes (0 if no fragment is pending)
+     */
+    uint8_t next(uint8_t *frag, uint8_t maxLen);
+
+private:
+    uint8_t buf[MAX_SENSOR_PAYLOAD_SIZE]; //!< payload
+    uint8_t size = 0;                     //!< payload size
+    uint8_t offset = 0;                   //!< offset of next fragment in payload
+    uint8_t idx = 0;                      //!< index of next fragment
+    uint8_t seq = 0;                      //!< message sequence number
+};
+
+#endif // _PAYLOAD_FRAGMENTER_H
@@ -38,6 +38,10 @@
 // 20250625 Added missing call to owTempSensors.begin() 
 //          for DallasTemperature v4.0.3
 // 20250720 Fixed missing function call for temperature conversion
+// 20261016 Added startConversion(): one non-blocking conversion overlapped with
+//          868 MHz reception, sensors are read by ROM address cached in retained memory
+//          Added resolution per sensor index (setOneWireRes()/getOneWireRes())
+//          Payload size limited by MAX_SENSOR_PAYLOAD_SIZE
 //
 // ToDo:
 // -
@@ -54,15 +58,162 @@ static OneWire oneWire(PIN_ONEWIRE_BUS); //!< OneWire bus
 // Pass our oneWire reference to Dallas Temperature.
 static DallasTemperature owTempSensors(&oneWire); //!< Dallas temperature sensors connected to OneWire bus
 
+/// Marker for valid retained sensor ROM addresses
+#define ONEWIRE_STATE_MAGIC 0x4F4E4557UL
+
+/// 1-Wire sensor ROM addresses and bus properties
+struct sOneWireState
+{
+    uint32_t magic;                             //!< ONEWIRE_STATE_MAGIC if valid
+    uint8_t count;                              //!< number of sensors found
+    bool parasite;                              //!< at least one sensor uses parasite power
+    uint8_t res[ONEWIRE_MAX_SENSORS];           //!< resolution of sensors in bits (0: unknown)
+    DeviceAddress addr[ONEWIRE_MAX_SENSORS];    //!< ROM addresses in bus search order (index)
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sOneWireState owState = {0}; //!< 1-Wire sensor ROM addresses
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sOneWireState owState __attribute__((section(".uninitialized_data"))); //!< 1-Wire sensor ROM addresses
+#endif
+
+/*!
+ * \brief Get DS18B20 conversion time
+ *
+ * \param resolution resolution in bits (9...12)
+ *
+ * \returns conversion time in ms
+ */
+static uint16_t conversionTime(uint8_t resolution)
+{
+    static const uint16_t convTime[] = {94, 188, 375, 750};
+
+    if (resolution < 9)
+        resolution = 9;
+    else if (resolution > 12)
+        resolution = 12;
+
+    return convTime[resolution - 9];
+}
+
+// Search bus for sensors and store their ROM addresses
+void PayloadOneWire::scanBus(void)
+{
+    // Initialize the Dallas Temperature library - searches the bus
+    owTempSensors.begin();
+
+    owState.count = 0;
+    for (uint8_t i = 0; i < min(owTempSensors.getDeviceCount(), static_cast<uint8_t>(ONEWIRE_MAX_SENSORS)); i++)
+    {
+        if (!owTempSensors.getAddress(owState.addr[i], i))
+            break;
+        owState.res[i] = owTempSensors.getResolution(owState.addr[i]);
+        owState.count++;
+    }
+    owState.parasite = owTempSensors.isParasitePowerMode();
+    owState.magic = ONEWIRE_STATE_MAGIC;
+    log_d("1-Wire sensors found: %u", owState.count);
+}
+
+// Set resolution per sensor index in Preferences
+void PayloadOneWire::setOneWireRes(uint8_t *bytes, uint8_t size)
+{
+    cfgImage.putBytes(E_CFG_ITEM::E_ONEWIRE_RES, bytes, min(size, static_cast<uint8_t>(ONEWIRE_MAX_SENSORS)));
+}
+
+// Get resolution per sensor index from Preferences
+void PayloadOneWire::getOneWireRes(uint8_t *bytes)
+{
+    uint8_t size = cfgImage.getBytes(E_CFG_ITEM::E_ONEWIRE_RES, bytes, ONEWIRE_MAX_SENSORS);
+
+    for (uint8_t i = 0; i < ONEWIRE_MAX_SENSORS; i++)
+    {
+        if ((i >= size) || (bytes[i] < 9) || (bytes[i] > 12))
+            bytes[i] = 12;
+    }
+}
+
+// Start temperature conversion of all sensors (non-blocking)
+void PayloadOneWire::startConversion(uint8_t *appPayloadCfg)
+{
+    // Bitmap of enabled sensors, bit n corresponds to index n
+    uint32_t enabled = 0;
+    for (int i = 0; i < APP_PAYLOAD_BYTES_ONEWIRE; i++)
+    {
+        enabled = (enabled << 8) | appPayloadCfg[APP_PAYLOAD_OFFS_ONEWIRE + i];
+    }
+    if (!enabled)
+        return;
+
+    if (owState.magic != ONEWIRE_STATE_MAGIC)
+    {
+        scanBus();
+    }
+    else if (owState.parasite)
+    {
+        // The library handles the strong pull-up and conversion time
+        // for parasite powered sensors only after begin()
+        owTempSensors.begin();
+    }
+
+    if (owState.count == 0)
+        return;
+
+    // Apply configured resolution (stored in the sensor's EEPROM - only written if changed);
+    // the conversion time of the slowest enabled sensor determines the wait time
+    uint8_t res[ONEWIRE_MAX_SENSORS];
+    getOneWireRes(res);
+    convTime = 0;
+    for (uint8_t i = 0; i < owState.count; i++)
+    {
+        if (!((enabled >> i) & 1))
+            continue;
+
+        if (owState.res[i] != res[i])
+        {
+            log_d("Set resolution[%u]: %u bits", i, res[i]);
+            owState.res[i] = owTempSensors.setResolution(owState.addr[i], res[i]) ? res[i] : 0;
+        }
+        convTime = max(convTime, conversionTime(owState.res[i] ? owState.res[i] : 12));
+    }
+
+    // Parasite powered sensors must not be accessed during conversion - blocking
+    owTempSensors.setWaitForConversion(owState.parasite);
+
+    // Issue a global temperature request to all devices on the bus
+    owTempSensors.requestTemperatures();
+    convStart = millis();
+    convPending = true;
+}
+
+// Wait until the conversion started by startConversion() is completed
+void PayloadOneWire::waitConversion(void)
+{
+    if (!convPending)
+        return;
+
+    uint32_t elapsed = millis() - convStart;
+    if (elapsed < convTime)
+    {
+        log_d("Waiting %lu ms for 1-Wire conversion", static_cast<unsigned long>(convTime - elapsed));
+        delay(convTime - elapsed);
+    }
+    convPending = false;
+}
+
 // Get temperature from Maxim OneWire Sensor
 float PayloadOneWire::getOneWireTemperature(uint8_t index)
 {
-    // Call sensors.requestTemperatures() to issue a global temperature
-    // request to all devices on the bus
-    owTempSensors.requestTemperatures();
+    float tempC = DEVICE_DISCONNECTED_C;
 
-    // Get temperature by index
-    float tempC = owTempSensors.getTempCByIndex(index);
+    // Get temperature by ROM address
+    if ((owState.magic == ONEWIRE_STATE_MAGIC) && (index < owState.count))
+    {
+        tempC = owTempSensors.getTempC(owState.addr[index]);
+    }
 
     // Check if reading was successful
     if (tempC != DEVICE_DISCONNECTED_C)
@@ -72,6 +223,9 @@ float PayloadOneWire::getOneWireTemperature(uint8_t index)
     else
     {
         log_i("Error: Could not read temperature data");
+
+        // Sensor removed/replaced/added - search bus again in next cycle
+        owState.magic = 0;
     }
 
     return tempC;
@@ -80,8 +234,12 @@ float PayloadOneWire::getOneWireTemperature(uint8_t index)
 // Encode 1-Wire temperature sensor values for LoRaWAN transmission
 void PayloadOneWire::encodeOneWire(uint8_t *appPayloadCfg, LoraEncoder &encoder)
 {
-    // Initialize the Dallas Temperature library
-    owTempSensors.begin();
+    if (!convPending)
+    {
+        // Conversion not started by AppLayer::begin()
+        startConversion(appPayloadCfg);
+    }
+    waitConversion();
 
     unsigned index = 0;
     for (int i = APP_PAYLOAD_BYTES_ONEWIRE - 1; i >= 0; i--)
@@ -89,7 +247,7 @@ void PayloadOneWire::encodeOneWire(uint8_t *appPayloadCfg, LoraEncoder &encoder)
         for (uint8_t ch = 0; ch <= 7; ch++)
         {
             // Check if enough space is left in payload buffer
-            if (encoder.getLength() > MAX_UPLINK_SIZE - 2)
+            if (encoder.getLength() > MAX_SENSOR_PAYLOAD_SIZE - 2)
                 return;
             
             // Check if sensor with given index is enabled
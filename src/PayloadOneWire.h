@@ -32,6 +32,9 @@
 // History:
 //
 // 20240520 Created
+// 20261016 Added startConversion(): one non-blocking conversion overlapped with
+//          868 MHz reception, sensors are read by ROM address cached in retained memory
+//          Added resolution per sensor index (setOneWireRes()/getOneWireRes())
 //
 // ToDo:
 // -
@@ -53,12 +56,23 @@
 #include <DallasTemperature.h>
 
 #include <LoraMessage.h>
+#include "ConfigImage.h"
 #include "logging.h"
 
+/// Max. number of 1-Wire temperature sensors
+#define ONEWIRE_MAX_SENSORS (APP_PAYLOAD_BYTES_ONEWIRE * 8)
+
 /*!
  * \brief LoRaWAN node application layer - 1-Wire sensors
  *
  * Encodes data from 1-Wire sensors as LoRaWAN payload
+ *
+ * The ROM addresses of the sensors are determined by a bus search once and kept in
+ * memory which is retained during deep sleep. A global temperature conversion is
+ * started by startConversion() and runs while the 868 MHz receiver is active;
+ * encodeOneWire() waits only for the remainder of the conversion time of the
+ * slowest enabled sensor - the resolution (and thus the conversion time) can be
+ * configured per sensor index.
  */
 class PayloadOneWire
 {
@@ -68,9 +82,20 @@ public:
      */
     PayloadOneWire(){};
 
+    /*!
+     * \brief Start temperature conversion of all sensors (non-blocking)
+     *
+     * The bus is only searched if no valid ROM addresses are available.
+     *
+     * \param appPayloadCfg LoRaWAN payload configuration bitmaps
+     */
+    void startConversion(uint8_t *appPayloadCfg);
+
     /*!
      * \brief Get temperature from Maxim OneWire Sensor
      *
+     * The conversion must have been completed before.
+     *
      * \param index sensor index
      *
      * \returns temperature in degrees Celsius or DEVICE_DISCONNECTED_C
@@ -84,6 +109,44 @@ public:
      * \param encoder LoRaWAN payload encoder object
      */
     void encodeOneWire(uint8_t *appPayloadCfg, LoraEncoder &encoder);
+
+    /*!
+     * \brief Set resolution per sensor index in Preferences
+     *
+     * \param bytes resolution in bits (9...12) per index; other values: 12 bits
+     * \param size size in bytes (max. ONEWIRE_MAX_SENSORS)
+     */
+    void setOneWireRes(uint8_t *bytes, uint8_t size);
+
+    /*!
+     * \brief Get resolution per sensor index from Preferences
+     *
+     * \param bytes buffer for resolution in bits per index (ONEWIRE_MAX_SENSORS bytes)
+     */
+    void getOneWireRes(uint8_t *bytes);
+
+private:
+    /// Configuration image (cached Preferences)
+    ConfigImage cfgImage;
+
+    /// Conversion started by startConversion() and not completed yet
+    bool convPending = false;
+
+    /// Start time of conversion (millis())
+    uint32_t convStart;
+
+    /// Conversion time of slowest enabled sensor in ms
+    uint16_t convTime;
+
+    /*!
+     * \brief Search bus for sensors and store their ROM addresses
+     */
+    void scanBus(void);
+
+    /*!
+     * \brief Wait until the conversion started by startConversion() is completed
+     */
+    void waitConversion(void);
 };
 #endif // ONEWIRE_EN
 #endif //_PAYLOAD_ONE_WIRE
\ No newline at end of file
@@ -0,0 +1,330 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadPlanner.cpp
+//
+// Uplink payload planner for BresserWeatherSensorLW
+//
+// - Computes the exact byte layout of the sensor data uplink for the
+//   active payload configuration
+// - Drops whole sensors by priority if the layout exceeds the maximum
+//   payload size of the current data rate
+// - Provides the effective payload configuration for the encoders and
+//   for the backend (CMD_GET_PAYLOAD_LAYOUT)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Limit planned payload to MAX_SENSOR_PAYLOAD_SIZE
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file PayloadPlanner.cpp
+ *  \brief Uplink payload planner for BresserWeatherSensorLW
+ */
+
+#include "PayloadPlanner.h"
+
+/// Marker for valid retained max. payload size
+#define PAYLOAD_PLANNER_MAGIC 0x504C414EUL
+
+/// Max. payload size of previous uplink
+struct sPayloadMaxLen
+{
+    uint32_t magic; //!< PAYLOAD_PLANNER_MAGIC if valid
+    uint8_t maxLen; //!< max. payload size in bytes
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sPayloadMaxLen payloadMaxLen = {0}; //!< max. payload size of previous uplink
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sPayloadMaxLen payloadMaxLen __attribute__((section(".uninitialized_data"))); //!< max. payload size of previous uplink
+#endif
+
+void PayloadPlanner::addBlock(uint8_t prio, uint8_t cfgIdx, uint8_t cfgMask, uint8_t size)
+{
+    if (size == 0)
+        return;
+
+    if (numBlocks == PAYLOAD_PLAN_BLOCKS)
+    {
+        log_w("Payload layout full");
+        return;
+    }
+    blocks[numBlocks++] = {prio, cfgIdx, cfgMask, size, true};
+}
+
+uint8_t PayloadPlanner::plan(const uint8_t *appPayloadCfg, uint8_t bleSensors, uint8_t maxLen)
+{
+    if (maxLen == 0)
+    {
+        // Uninitialized after power-on/HW reset
+        if ((payloadMaxLen.magic != PAYLOAD_PLANNER_MAGIC) || (payloadMaxLen.maxLen == 0))
+        {
+            payloadMaxLen.magic = PAYLOAD_PLANNER_MAGIC;
+            payloadMaxLen.maxLen = MAX_UPLINK_SIZE;
+        }
+        maxLen = payloadMaxLen.maxLen;
+    }
+
+    memcpy(cfg, appPayloadCfg, APP_PAYLOAD_CFG_SIZE);
+    numBlocks = 0;
+
+    // Bresser sensors - see PayloadBresser::encodeBresser()
+    uint16_t flags = (cfg[13] << 8) | cfg[1];
+    if (flags & 1)
+    {
+        addBlock(PAYLOAD_PRIO_WEATHER, 1, 0x01, payloadBytes(SENSOR_TYPE_WEATHER1, flags));
+    }
+    for (uint8_t type = 2; type < 16; type++)
+    {
+        if ((cfg[type] == 0) || (type == SENSOR_TYPE_WEATHER3) || (type == SENSOR_TYPE_WEATHER8))
+            continue;
+
+#ifdef LIGHTNINGSENSOR_EN
+        if (type == SENSOR_TYPE_LIGHTNING)
+        {
+            if (cfg[type] & 1)
+            {
+                addBlock(PAYLOAD_PRIO_LIGHTNING, type, 0x01, payloadBytes(type, cfg[type]));
+            }
+            continue;
+        }
+#endif
+        for (uint8_t ch = 1; ch <= 7; ch++)
+        {
+            if ((cfg[type] >> ch) & 1)
+            {
+                addBlock(PAYLOAD_PRIO_BRESSER, type, 1 << ch, payloadBytes(type, 0));
+            }
+        }
+    }
+
+#ifdef ONEWIRE_EN
+    // 1-Wire temperature sensors - see PayloadOneWire::encodeOneWire()
+    for (int i = APP_PAYLOAD_BYTES_ONEWIRE - 1; i >= 0; i--)
+    {
+        for (uint8_t bit = 0; bit <= 7; bit++)
+        {
+            if ((cfg[APP_PAYLOAD_OFFS_ONEWIRE + i] >> bit) & 1)
+            {
+                addBlock(PAYLOAD_PRIO_ONEWIRE, APP_PAYLOAD_OFFS_ONEWIRE + i, 1 << bit, 2);
+            }
+        }
+    }
+#endif
+
+    // Analog channels - see PayloadAnalog::encodeAnalog()
+    unsigned ch = 0;
+    for (int i = APP_PAYLOAD_BYTES_ANALOG - 1; i >= 0; i--)
+    {
+        for (uint8_t bit = 0; bit <= 7; bit++)
+        {
+            if ((cfg[APP_PAYLOAD_OFFS_ANALOG + i] >> bit) & 1)
+            {
+                uint8_t size = 0;
+#if defined(UBATT_CH)
+                if (ch == UBATT_CH)
+                    size += 2;
+#endif
+#if defined(USUPPLY_CH)
+                if (ch == USUPPLY_CH)
+                    size += 2;
+#endif
+                addBlock(PAYLOAD_PRIO_ANALOG, APP_PAYLOAD_OFFS_ANALOG + i, 1 << bit, size);
+            }
+            ch++;
+        }
+    }
+
+    // Digital sensors - see PayloadDigital::encodeDigital()
+    ch = (APP_PAYLOAD_BYTES_DIGITAL * 8) - 1;
+#ifdef DYP_R01CW_EN
+    const uint8_t dypR01cwAddresses[] = DYP_R01CW_ADDRESSES;
+    size_t dypSensorIdx = 0;
+#endif
+    for (int i = APP_PAYLOAD_BYTES_DIGITAL - 1; i >= 0; i--)
+    {
+        for (uint8_t bit = 0; bit <= 7; bit++)
+        {
+            if ((cfg[APP_PAYLOAD_OFFS_DIGITAL + i] >> bit) & 1)
+            {
+                uint8_t size = 0;
+#ifdef A02YYUW_EN
+                if (ch == A02YYUW_CH)
+                    size += 2;
+#endif
+#ifdef DYP_R01CW_EN
+                if (dypSensorIdx < sizeof(dypR01cwAddresses))
+                {
+                    size += 2;
+                    dypSensorIdx++;
+                }
+#endif
+                addBlock(PAYLOAD_PRIO_DIGITAL, APP_PAYLOAD_OFFS_DIGITAL + i, 1 << bit, size);
+            }
+            ch--;
+        }
+    }
+
+    // BLE temperature/humidity sensor - see PayloadBLE::encodeBLE()
+    addBlock(PAYLOAD_PRIO_BLE, PAYLOAD_CFG_NONE, 0, (bleSensors > 0) ? 3 : 0);
+
+    // Battery status flags - see AppLayer::getPayloadStage1()
+    addBlock(PAYLOAD_PRIO_STATUS, 0, 0x01, cfg[0] & 1);
+
+    bleIncluded = (bleSensors > 0);
+    dropped = false;
+    fit(min(maxLen, MAX_SENSOR_PAYLOAD_SIZE));
+    planMaxLen = maxLen;
+
+    return planSize;
+}
+
+void PayloadPlanner::fit(uint8_t maxLen)
+{
+    planSize = 0;
+    for (uint8_t i = 0; i < numBlocks; i++)
+    {
+        if (blocks[i].included)
+            planSize += blocks[i].size;
+    }
+
+    bool droppedNow[PAYLOAD_PLAN_BLOCKS] = {false};
+    while (planSize > maxLen)
+    {
+        // Lowest priority, last block in payload
+        int drop = -1;
+        for (uint8_t i = 0; i < numBlocks; i++)
+        {
+            if (blocks[i].included && ((drop < 0) || (blocks[i].prio >= blocks[drop].prio)))
+                drop = i;
+        }
+        if (drop < 0)
+            break;
+
+        sPayloadBlock &block = blocks[drop];
+        log_w("Payload exceeds %u bytes - dropping cfg[%u] & 0x%02X (%u bytes)", maxLen, block.cfgIdx, block.cfgMask, block.size);
+        block.included = false;
+        droppedNow[drop] = true;
+        planSize -= block.size;
+        dropped = true;
+    }
+
+    // Dropping a large block may have freed space for smaller blocks of lower priority;
+    // re-include them in order of priority, first block in payload on ties
+    while (true)
+    {
+        int add = -1;
+        for (uint8_t i = 0; i < numBlocks; i++)
+        {
+            if (droppedNow[i] && (planSize + blocks[i].size <= maxLen) && ((add < 0) || (blocks[i].prio < blocks[add].prio)))
+                add = i;
+        }
+        if (add < 0)
+            break;
+
+        log_d("Payload fits - re-including cfg[%u] & 0x%02X (%u bytes)", blocks[add].cfgIdx, blocks[add].cfgMask, blocks[add].size);
+        blocks[add].included = true;
+        droppedNow[add] = false;
+        planSize += blocks[add].size;
+    }
+
+    for (uint8_t i = 0; i < numBlocks; i++)
+    {
+        if (!droppedNow[i])
+            continue;
+
+        if (blocks[i].cfgIdx == PAYLOAD_CFG_NONE)
+        {
+            bleIncluded = false;
+        }
+        else
+        {
+            cfg[blocks[i].cfgIdx] &= ~blocks[i].cfgMask;
+        }
+    }
+    log_d("Payload layout: %u blocks, %u bytes (max. %u)", numBlocks, planSize, maxLen);
+}
+
+uint8_t PayloadPlanner::trim(uint8_t *payload, uint8_t size, uint8_t maxLen)
+{
+    payloadMaxLen.magic = PAYLOAD_PLANNER_MAGIC;
+    payloadMaxLen.maxLen = maxLen;
+
+    if (size <= maxLen)
+        return size;
+
+    if (size != planSize)
+    {
+        // Layout does not match payload - should not happen
+        log_w("Payload size %u does not match layout (%u bytes) - truncating", size, planSize);
+        return maxLen;
+    }
+
+    bool included[PAYLOAD_PLAN_BLOCKS];
+    for (uint8_t i = 0; i < numBlocks; i++)
+    {
+        included[i] = blocks[i].included;
+    }
+    fit(maxLen);
+    planMaxLen = maxLen;
+
+    // Remove dropped blocks
+    uint8_t src = 0;
+    uint8_t dst = 0;
+    for (uint8_t i = 0; i < numBlocks; i++)
+    {
+        if (!included[i])
+            continue;
+
+        if (blocks[i].included)
+        {
+            memmove(&payload[dst], &payload[src], blocks[i].size);
+            dst += blocks[i].size;
+        }
+        src += blocks[i].size;
+    }
+    return dst;
+}
+
+void PayloadPlanner::encodeLayout(LoraEncoder &encoder)
+{
+    encoder.writeUint8(planMaxLen);
+    encoder.writeUint8(planSize);
+    encoder.writeUint8((bleIncluded ? 1 : 0) | (dropped ? 2 : 0));
+    for (size_t i = 0; i < APP_PAYLOAD_CFG_SIZE; i++)
+    {
+        encoder.writeUint8(cfg[i]);
+    }
+}
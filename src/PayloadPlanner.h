@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadPlanner.h
+//
+// Uplink payload planner for BresserWeatherSensorLW
+//
+// - Computes the exact byte layout of the sensor data uplink for the
+//   active payload configuration
+// - Drops whole sensors by priority if the layout exceeds the maximum
+//   payload size of the current data rate
+// - Provides the effective payload configuration for the encoders and
+//   for the backend (CMD_GET_PAYLOAD_LAYOUT)
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file PayloadPlanner.h
+ *  \brief Uplink payload planner for BresserWeatherSensorLW
+ */
+
+#if !defined(_PAYLOAD_PLANNER_H)
+#define _PAYLOAD_PLANNER_H
+
+#include <Arduino.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "PayloadSchema.h"
+#include <LoraMessage.h>
+#include "logging.h"
+
+/// Max. number of blocks in a payload layout
+#define PAYLOAD_PLAN_BLOCKS 192
+
+/// Payload block: no configuration bit (BLE sensor)
+#define PAYLOAD_CFG_NONE 0xFF
+
+/*!
+ * \brief Uplink payload planner
+ *
+ * The sensor data uplink consists of blocks - one per sensor, channel or
+ * interface - in the order of encoding (see AppLayer::getPayloadStage1()).
+ * Each block is enabled by a bit in the payload configuration and contains
+ * only complete fields.
+ *
+ * If the planned size exceeds the maximum payload size, blocks are dropped
+ * by clearing their configuration bits - the encoders then skip these
+ * sensors. The plan is deterministic for a given payload configuration and
+ * maximum payload size, i.e. the backend can decode the uplink from the
+ * effective configuration reported by CMD_GET_PAYLOAD_LAYOUT.
+ *
+ * The payload is encoded before the LoRaWAN node is activated; therefore the
+ * maximum payload size of the previous uplink (retained during deep sleep) is
+ * used for planning. If the actual maximum is smaller, the encoded payload is
+ * trimmed by removing whole blocks (see trim()).
+ */
+class PayloadPlanner
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    PayloadPlanner() {};
+
+    /*!
+     * \brief Plan payload layout
+     *
+     * \param appPayloadCfg payload configuration
+     * \param bleSensors    number of BLE sensors (0: none)
+     * \param maxLen        max. payload size, 0: use size of previous uplink
+     *
+     * \returns planned payload size in bytes
+     */
+    uint8_t plan(const uint8_t *appPayloadCfg, uint8_t bleSensors, uint8_t maxLen = 0);
+
+    /*!
+     * \brief Trim encoded payload to the actual max. payload size
+     *
+     * Removes whole blocks from the payload according to the priorities.
+     * The max. payload size is retained for planning of the next uplink.
+     *
+     * \param payload payload buffer
+     * \param size    encoded payload size in bytes
+     * \param maxLen  max. payload size (node.getMaxPayloadLen())
+     *
+     * \returns payload size after trimming
+     */
+    uint8_t trim(uint8_t *payload, uint8_t size, uint8_t maxLen);
+
+    /*!
+     * \brief Get effective payload configuration
+     *
+     * \returns payload configuration with bits of dropped sensors cleared
+     */
+    const uint8_t *getCfg(void)
+    {
+        return cfg;
+    };
+
+    /*!
+     * \brief Check if the BLE sensor is included in the payload
+     *
+     * \returns true if included
+     */
+    bool isBleIncluded(void)
+    {
+        return bleIncluded;
+    };
+
+    /*!
+     * \brief Encode payload layout (CMD_GET_PAYLOAD_LAYOUT response)
+     *
+     * \param encoder uplink data encoder object
+     */
+    void encodeLayout(LoraEncoder &encoder);
+
+private:
+    /// Payload block
+    struct sPayloadBlock
+    {
+        uint8_t prio;    //!< priority (PAYLOAD_PRIO_*)
+        uint8_t cfgIdx;  //!< index in payload configuration (PAYLOAD_CFG_NONE: BLE)
+        uint8_t cfgMask; //!< configuration bit(s)
+        uint8_t size;    //!< size in bytes
+        bool included;   //!< block is included in payload
+    };
+
+    sPayloadBlock blocks[PAYLOAD_PLAN_BLOCKS]; //!< payload layout
+    uint8_t numBlocks = 0;                     //!< number of blocks
+    uint8_t cfg[APP_PAYLOAD_CFG_SIZE] = {0};   //!< effective payload configuration
+    bool bleIncluded = false;                  //!< BLE sensor included
+    uint16_t planSize = 0;                     //!< planned payload size
+    uint8_t planMaxLen = 0;                    //!< max. payload size used for planning
+    bool dropped = false;                      //!< blocks have been dropped
+
+    /*!
+     * \brief Add block to layout
+     *
+     * \param prio    priority
+     * \param cfgIdx  index in payload configuration
+     * \param cfgMask configuration bit(s)
+     * \param size    size in bytes (blocks of size 0 are ignored)
+     */
+    void addBlock(uint8_t prio, uint8_t cfgIdx, uint8_t cfgMask, uint8_t size);
+
+    /*!
+     * \brief Drop blocks until the payload fits
+     *
+     * Blocks are dropped in order of priority; afterwards, smaller blocks
+     * dropped in the same pass are re-included if they fit into the space
+     * freed by a larger block.
+     *
+     * \param maxLen max. payload size
+     */
+    void fit(uint8_t maxLen);
+};
+
+#endif // _PAYLOAD_PLANNER_H
@@ -0,0 +1,359 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadQueue.cpp
+//
+// Store-and-forward queue for sensor data uplinks of BresserWeatherSensorLW
+//
+// - Persists sensor data uplinks which could not be sent (uplink failed or
+//   join failed) with timestamp and port in a ring of slots in a file on
+//   LittleFS (which provides wear levelling)
+// - Provides the oldest queued uplink as backfill frame for sending on
+//   PAYLOAD_QUEUE_PORT in a later wake cycle
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          peek(): Skip queued uplinks which do not fit at the current data rate
+//          push(): Write to empty slot; overwrite oldest entry only if queue is full
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file PayloadQueue.cpp
+ *  \brief Store-and-forward queue for sensor data uplinks of BresserWeatherSensorLW
+ */
+
+#include "PayloadQueue.h"
+
+/// Marker for valid retained queue state
+#define PAYLOAD_QUEUE_MAGIC 0x51554555UL
+
+/// Queue file
+#define PAYLOAD_QUEUE_FILE "/uplink_queue.bin"
+
+/// Slot state: uplink queued
+#define SLOT_PENDING 0xA5
+
+/// Slot state: empty
+#define SLOT_EMPTY 0x00
+
+/// Queue file slot
+struct __attribute__((packed)) sQueueEntry
+{
+    uint8_t state;                    //!< SLOT_PENDING or SLOT_EMPTY
+    uint32_t seq;                     //!< sequence number (order of queueing)
+    uint32_t time;                    //!< timestamp (unix time)
+    uint8_t port;                     //!< LoRaWAN port
+    uint8_t size;                     //!< payload size in bytes
+    uint8_t payload[MAX_UPLINK_SIZE]; //!< payload
+};
+
+/// Queue state
+struct sQueueState
+{
+    uint32_t magic;   //!< PAYLOAD_QUEUE_MAGIC if valid
+    uint8_t count;    //!< number of queued uplinks
+    uint8_t writeIdx; //!< index of next slot to be written
+    uint32_t seq;     //!< next sequence number
+    uint8_t minFrame; //!< min. backfill frame size of queued uplinks (0: unknown)
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sQueueState queueState = {0}; //!< queue state
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sQueueState queueState __attribute__((section(".uninitialized_data"))); //!< queue state
+#endif
+
+bool PayloadQueue::pending(void)
+{
+    if ((queueState.magic != PAYLOAD_QUEUE_MAGIC) || (queueState.writeIdx >= PAYLOAD_QUEUE_SIZE) ||
+        (queueState.count > PAYLOAD_QUEUE_SIZE))
+    {
+        // Uninitialized after power-on/HW reset
+        recover();
+    }
+    return queueState.count > 0;
+}
+
+void PayloadQueue::push(uint8_t port, const uint8_t *payload, uint8_t size, time_t t)
+{
+    if (size > MAX_UPLINK_SIZE)
+    {
+        log_w("Uplink (%u bytes) too large for queue", size);
+        return;
+    }
+
+    pending();
+
+    File file;
+    if (!open(file))
+        return;
+
+    // Find an empty slot, starting at writeIdx (spreads writes over all slots).
+    // Slots are freed out of order by pop(), so writeIdx may point to a pending
+    // entry while other slots are empty. Only if no slot is empty, the oldest
+    // entry is overwritten.
+    sQueueEntry entry;
+    int emptyIdx = -1;
+    int oldestIdx = -1;
+    uint32_t oldestSeq = 0;
+    for (int i = 0; i < PAYLOAD_QUEUE_SIZE; i++)
+    {
+        int idx = (queueState.writeIdx + i) % PAYLOAD_QUEUE_SIZE;
+        file.seek(idx * sizeof(sQueueEntry));
+        if (file.read(reinterpret_cast<uint8_t *>(&entry), offsetof(sQueueEntry, time)) !=
+            offsetof(sQueueEntry, time))
+            break;
+
+        if (entry.state != SLOT_PENDING)
+        {
+            emptyIdx = idx;
+            break;
+        }
+        if ((oldestIdx < 0) || (entry.seq < oldestSeq))
+        {
+            oldestIdx = idx;
+            oldestSeq = entry.seq;
+        }
+    }
+
+    int writeIdx = emptyIdx;
+    if (writeIdx < 0)
+    {
+        if (oldestIdx < 0)
+        {
+            log_e("Reading uplink queue failed");
+            file.close();
+            return;
+        }
+        log_w("Uplink queue full - discarding oldest uplink");
+        writeIdx = oldestIdx;
+        if (queueState.count > 0)
+            queueState.count--;
+    }
+    size_t offset = writeIdx * sizeof(sQueueEntry);
+
+    memset(&entry, 0, sizeof(entry));
+    entry.state = SLOT_PENDING;
+    entry.seq = queueState.seq;
+    entry.time = static_cast<uint32_t>(t);
+    entry.port = port;
+    entry.size = size;
+    memcpy(entry.payload, payload, size);
+
+    file.seek(offset);
+    if (file.write(reinterpret_cast<uint8_t *>(&entry), sizeof(entry)) != sizeof(entry))
+    {
+        log_e("Writing uplink queue failed");
+        file.close();
+        return;
+    }
+    file.close();
+
+    queueState.writeIdx = (writeIdx + 1) % PAYLOAD_QUEUE_SIZE;
+    queueState.seq++;
+    queueState.count++;
+    if (queueState.minFrame)
+    {
+        queueState.minFrame = min(queueState.minFrame, static_cast<uint8_t>(PAYLOAD_QUEUE_HEADER_SIZE + size));
+    }
+    log_i("Uplink queued; port %u, size %u, %u uplinks pending", port, size, queueState.count);
+}
+
+uint8_t PayloadQueue::peek(uint8_t *buf, uint8_t maxLen)
+{
+    peekIdx = -1;
+    if (!pending())
+        return 0;
+
+    // No queued uplink fits at the current data rate (known from previous call) - skip file access
+    if (maxLen < queueState.minFrame)
+    {
+        log_d("No queued uplink fits into backfill uplink (max. %u bytes)", maxLen);
+        return 0;
+    }
+
+    File file;
+    if (!open(file))
+        return 0;
+
+    // Find oldest queued uplink which fits into the backfill uplink.
+    // Sensor data uplinks of up to MAX_UPLINK_SIZE bytes do not fit at the lowest
+    // data rates (e.g. EU868 DR0..2: 51 bytes incl. PAYLOAD_QUEUE_HEADER_SIZE) -
+    // exactly where uplinks fail. Such entries are skipped (and kept until the
+    // data rate allows to send them), so they do not block younger entries.
+    sQueueEntry entry;
+    sQueueEntry oldest;
+    bool found = false;
+    uint8_t minFrame = UINT8_MAX;
+    for (int idx = 0; idx < PAYLOAD_QUEUE_SIZE; idx++)
+    {
+        if (file.read(reinterpret_cast<uint8_t *>(&entry), sizeof(entry)) != sizeof(entry))
+            break;
+
+        if ((entry.state != SLOT_PENDING) || (entry.size > MAX_UPLINK_SIZE))
+            continue;
+
+        found = true;
+        uint8_t frameSize = PAYLOAD_QUEUE_HEADER_SIZE + entry.size;
+        minFrame = min(minFrame, frameSize);
+        if (frameSize > maxLen)
+            continue;
+
+        if ((peekIdx < 0) || (entry.seq < oldest.seq))
+        {
+            peekIdx = idx;
+            oldest = entry;
+        }
+    }
+    file.close();
+
+    if (!found)
+    {
+        log_w("Uplink queue inconsistent - resetting");
+        queueState.count = 0;
+        return 0;
+    }
+
+    queueState.minFrame = minFrame;
+    if (peekIdx < 0)
+    {
+        log_d("No queued uplink fits into backfill uplink (max. %u bytes)", maxLen);
+        return 0;
+    }
+
+    buf[0] = oldest.port;
+    buf[1] = oldest.time & 0xFF;
+    buf[2] = (oldest.time >> 8) & 0xFF;
+    buf[3] = (oldest.time >> 16) & 0xFF;
+    buf[4] = (oldest.time >> 24) & 0xFF;
+    memcpy(&buf[PAYLOAD_QUEUE_HEADER_SIZE], oldest.payload, oldest.size);
+
+    return PAYLOAD_QUEUE_HEADER_SIZE + oldest.size;
+}
+
+void PayloadQueue::pop(void)
+{
+    if (peekIdx < 0)
+        return;
+
+    File file;
+    if (!open(file))
+        return;
+
+    uint8_t state = SLOT_EMPTY;
+    file.seek(peekIdx * sizeof(sQueueEntry));
+    file.write(&state, 1);
+    file.close();
+
+    peekIdx = -1;
+    if (queueState.count > 0)
+        queueState.count--;
+    log_d("Backfill uplink sent, %u uplinks pending", queueState.count);
+}
+
+bool PayloadQueue::open(File &file)
+{
+    if (!LittleFS.begin(
+#if defined(ESP32)
+            // Format the LittleFS partition on error; parameter only available for ESP32
+            true
+#endif
+            ))
+    {
+        log_e("Could not initialize LittleFS.");
+        return false;
+    }
+
+    if (!LittleFS.exists(PAYLOAD_QUEUE_FILE))
+    {
+        // Create file with empty slots
+        file = LittleFS.open(PAYLOAD_QUEUE_FILE, "w");
+        if (!file)
+        {
+            log_e("Could not create %s", PAYLOAD_QUEUE_FILE);
+            return false;
+        }
+        sQueueEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        for (int idx = 0; idx < PAYLOAD_QUEUE_SIZE; idx++)
+        {
+            file.write(reinterpret_cast<uint8_t *>(&entry), sizeof(entry));
+        }
+        file.close();
+    }
+
+    file = LittleFS.open(PAYLOAD_QUEUE_FILE, "r+");
+    if (!file)
+    {
+        log_e("Could not open %s", PAYLOAD_QUEUE_FILE);
+        return false;
+    }
+    return true;
+}
+
+void PayloadQueue::recover(void)
+{
+    queueState.magic = PAYLOAD_QUEUE_MAGIC;
+    queueState.count = 0;
+    queueState.writeIdx = 0;
+    queueState.seq = 0;
+    queueState.minFrame = 0;
+
+    File file;
+    if (!open(file))
+        return;
+
+    // Continue after the most recently queued uplink
+    sQueueEntry entry;
+    bool found = false;
+    for (int idx = 0; idx < PAYLOAD_QUEUE_SIZE; idx++)
+    {
+        if (file.read(reinterpret_cast<uint8_t *>(&entry), sizeof(entry)) != sizeof(entry))
+            break;
+
+        if (entry.state != SLOT_PENDING)
+            continue;
+
+        queueState.count++;
+        if (!found || (entry.seq >= queueState.seq))
+        {
+            queueState.seq = entry.seq + 1;
+            queueState.writeIdx = (idx + 1) % PAYLOAD_QUEUE_SIZE;
+            found = true;
+        }
+    }
+    file.close();
+
+    log_d("Uplink queue: %u uplinks pending", queueState.count);
+}
@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadQueue.h
+//
+// Store-and-forward queue for sensor data uplinks of BresserWeatherSensorLW
+//
+// - Persists sensor data uplinks which could not be sent (uplink failed or
+//   join failed) with timestamp and port in a ring of slots in a file on
+//   LittleFS (which provides wear levelling)
+// - Provides the oldest queued uplink as backfill frame for sending on
+//   PAYLOAD_QUEUE_PORT in a later wake cycle
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          peek(): Skip queued uplinks which do not fit at the current data rate
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file PayloadQueue.h
+ *  \brief Store-and-forward queue for sensor data uplinks of BresserWeatherSensorLW
+ */
+
+#if !defined(_PAYLOAD_QUEUE_H)
+#define _PAYLOAD_QUEUE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <time.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "logging.h"
+
+/// Size of backfill frame header (port, timestamp)
+#define PAYLOAD_QUEUE_HEADER_SIZE 5
+
+/*!
+ * \brief Store-and-forward queue for sensor data uplinks
+ *
+ * Backfill frame (PAYLOAD_QUEUE_PORT):
+ *
+ * byte 0:    original port
+ * byte 1..4: timestamp (unix time, little endian)
+ * byte 5...: original payload
+ *
+ * The number of queued uplinks is kept in memory which is retained during
+ * deep sleep - the file is only accessed if uplinks are queued (or after
+ * a reset).
+ */
+class PayloadQueue
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    PayloadQueue() {};
+
+    /*!
+     * \brief Check if uplinks are queued
+     *
+     * \returns true if uplinks are queued
+     */
+    bool pending(void);
+
+    /*!
+     * \brief Add uplink to queue
+     *
+     * If the queue is full, the oldest uplink is overwritten.
+     *
+     * \param port    LoRaWAN port
+     * \param payload payload
+     * \param size    payload size in bytes
+     * \param t       timestamp
+     */
+    void push(uint8_t port, const uint8_t *payload, uint8_t size, time_t t);
+
+    /*!
+     * \brief Get oldest queued uplink which fits into maxLen as backfill frame
+     *
+     * Queued uplinks which do not fit at the current data rate are skipped,
+     * but kept in the queue.
+     *
+     * \param buf    uplink buffer
+     * \param maxLen max. payload size (node.getMaxPayloadLen())
+     *
+     * \returns frame size in bytes, 0 if no queued uplink fits
+     */
+    uint8_t peek(uint8_t *buf, uint8_t maxLen);
+
+    /*!
+     * \brief Remove uplink provided by peek() from queue
+     */
+    void pop(void);
+
+private:
+    int peekIdx = -1; //!< slot index of uplink provided by peek()
+
+    /*!
+     * \brief Open queue file, create it if required
+     *
+     * \param file file object
+     *
+     * \returns true if successful
+     */
+    bool open(File &file);
+
+    /*!
+     * \brief Restore queue state from file (after reset)
+     */
+    void recover(void);
+};
+
+#endif // _PAYLOAD_QUEUE_H
@@ -0,0 +1,351 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadSchema.h
+//
+// Uplink payload schema of Bresser sensors
+//
+// - Describes the uplink fields of each sensor type (encoding, invalid
+//   marker, configuration flag, signal name and value source) in a
+//   compile-time table
+// - Provides exact payload sizes at compile time
+// - scripts/gen_payload_schema.js generates the schema used by the
+//   uplink payload formatter from this table
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file PayloadSchema.h
+ *  \brief Uplink payload schema of Bresser sensors
+ */
+
+#if !defined(_PAYLOAD_SCHEMA_H)
+#define _PAYLOAD_SCHEMA_H
+
+#include "../BresserWeatherSensorLWCfg.h"
+#include "WeatherSensorCfg.h"
+#include <WeatherSensor.h>
+#include <time.h>
+
+#ifdef RAINDATA_EN
+#include "RainGauge.h"
+#endif
+
+/// Field encoding (lora-serialization / uplink payload formatter data types)
+enum class E_PAYLOAD_ENC : uint8_t
+{
+    E_TEMPERATURE, //!< temperature, 2 bytes, invalid: INV_TEMP
+    E_UINT8,       //!< uint8, 1 byte, invalid: INV_UINT8
+    E_UINT8FP1,    //!< uint8, 1 byte, value * 10, invalid: INV_UINT8
+    E_UINT16,      //!< uint16, 2 bytes, invalid: INV_UINT16
+    E_UINT16FP1,   //!< uint16, 2 bytes, value * 10, invalid: INV_UINT16
+    E_UINT32,      //!< uint32, 4 bytes, invalid: INV_UINT32
+    E_RAWFLOAT,    //!< rawfloat, 4 bytes, invalid: INV_FLOAT
+    E_UNIXTIME     //!< unixtime, 4 bytes, invalid: INV_UINT32
+};
+
+/// Bresser sensor data (slot of WeatherSensor::sensor)
+using BresserSensor = decltype(WeatherSensor::sensor)::value_type;
+
+/// Value sources of payload fields
+struct sPayloadCtx
+{
+    const BresserSensor *sensor; //!< sensor data, nullptr if not received
+#ifdef RAINDATA_EN
+    RainGauge *rainGauge;        //!< rain gauge post-processing
+#endif
+#ifdef LIGHTNINGSENSOR_EN
+    bool lgtEvValid;             //!< lightning event data available
+    time_t lgtEvTs;              //!< timestamp of last lightning event
+    int lgtEvEvents;             //!< number of lightning events
+    uint8_t lgtEvDistance;       //!< distance of last lightning event
+#endif
+};
+
+/*!
+ * \brief Get value of a payload field
+ *
+ * \param ctx   value sources
+ * \param value field value (unscaled)
+ *
+ * \returns true if value is valid
+ */
+typedef bool (*payload_get_t)(const sPayloadCtx &ctx, double &value);
+
+/// Payload field
+struct sPayloadField
+{
+    uint8_t type;       //!< sensor type (SENSOR_TYPE_*)
+    uint16_t flag;      //!< configuration flag (PAYLOAD_*), 0: always included
+    E_PAYLOAD_ENC enc;  //!< encoding
+    const char *name;   //!< signal name in uplink formatter ('#': channel)
+    payload_get_t get;  //!< value getter
+};
+
+/// Value getters
+namespace PayloadGet
+{
+    inline bool wsTemp(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && c.sensor->w.temp_ok && ((v = c.sensor->w.temp_c), true);
+    }
+    inline bool wsHumidity(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && c.sensor->w.humidity_ok && ((v = c.sensor->w.humidity), true);
+    }
+    inline bool wsRain(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && c.sensor->w.rain_ok && ((v = c.sensor->w.rain_mm), true);
+    }
+    inline bool wsWindAvg(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && c.sensor->w.wind_ok && ((v = c.sensor->w.wind_avg_meter_sec_fp1 / 10.0), true);
+    }
+    inline bool wsWindGust(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && c.sensor->w.wind_ok && ((v = c.sensor->w.wind_gust_meter_sec_fp1 / 10.0), true);
+    }
+    inline bool wsWindDir(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && c.sensor->w.wind_ok && ((v = c.sensor->w.wind_direction_deg_fp1 / 10.0), true);
+    }
+    inline bool wsUv(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && c.sensor->w.uv_ok && ((v = c.sensor->w.uv), true);
+    }
+    inline bool wsLight(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && c.sensor->w.light_ok && ((v = c.sensor->w.light_lux), true);
+    }
+#ifdef RAINDATA_EN
+    inline bool wsRainStatsValid(const sPayloadCtx &c)
+    {
+        return c.sensor && c.sensor->valid && c.sensor->w.rain_ok;
+    }
+    inline bool wsRainHour(const sPayloadCtx &c, double &v)
+    {
+        bool valid = false;
+        return wsRainStatsValid(c) && ((v = c.rainGauge->pastHour(&valid)), valid);
+    }
+    inline bool wsRainDay(const sPayloadCtx &c, double &v)
+    {
+        return wsRainStatsValid(c) && ((v = c.rainGauge->currentDay()) != -1);
+    }
+    inline bool wsRainWeek(const sPayloadCtx &c, double &v)
+    {
+        return wsRainStatsValid(c) && ((v = c.rainGauge->currentWeek()) != -1);
+    }
+    inline bool wsRainMonth(const sPayloadCtx &c, double &v)
+    {
+        return wsRainStatsValid(c) && ((v = c.rainGauge->currentMonth()) != -1);
+    }
+#endif
+    inline bool wsTglobe(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && c.sensor->w.tglobe_ok && ((v = c.sensor->w.tglobe_c), true);
+    }
+    inline bool temp(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && ((v = c.sensor->w.temp_c), true);
+    }
+    inline bool humidity(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && ((v = c.sensor->w.humidity), true);
+    }
+    inline bool soilTemp(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && ((v = c.sensor->soil.temp_c), true);
+    }
+    inline bool soilMoisture(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && ((v = c.sensor->soil.moisture), true);
+    }
+    inline bool leakAlarm(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && ((v = c.sensor->leak.alarm ? 1 : 0), true);
+    }
+    inline bool pm1_0(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && !c.sensor->pm.pm_1_0_init && ((v = c.sensor->pm.pm_1_0), true);
+    }
+    inline bool pm2_5(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && !c.sensor->pm.pm_2_5_init && ((v = c.sensor->pm.pm_2_5), true);
+    }
+    inline bool pm10(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && !c.sensor->pm.pm_10_init && ((v = c.sensor->pm.pm_10), true);
+    }
+#ifdef LIGHTNINGSENSOR_EN
+    inline bool lgtDistance(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && ((v = c.sensor->lgt.distance_km), true);
+    }
+    inline bool lgtStrikes(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && ((v = c.sensor->lgt.strike_count), true);
+    }
+    inline bool lgtEvTime(const sPayloadCtx &c, double &v)
+    {
+        return c.lgtEvValid && ((v = c.lgtEvTs), true);
+    }
+    inline bool lgtEvEvents(const sPayloadCtx &c, double &v)
+    {
+        return c.lgtEvValid && ((v = c.lgtEvEvents), true);
+    }
+    inline bool lgtEvDistance(const sPayloadCtx &c, double &v)
+    {
+        return c.lgtEvValid && ((v = c.lgtEvDistance), true);
+    }
+#endif
+    inline bool co2(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && !c.sensor->co2.co2_init && ((v = c.sensor->co2.co2_ppm), true);
+    }
+    inline bool hcho(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && !c.sensor->voc.hcho_init && ((v = c.sensor->voc.hcho_ppb), true);
+    }
+    inline bool voc(const sPayloadCtx &c, double &v)
+    {
+        return c.sensor && !c.sensor->voc.voc_init && ((v = c.sensor->voc.voc_level), true);
+    }
+}
+
+/*!
+ * \brief Payload schema
+ *
+ * The fields of each sensor type are encoded in the order of this table.
+ * Weather sensor fields are selected by the PAYLOAD_WS_* flags in
+ * appPayloadCfg[1] (bits 7..0) and appPayloadCfg[13] (bits 15..8),
+ * lightning sensor fields by the PAYLOAD_LIGHTNING_* flags.
+ *
+ * Signals provided by weather sensors:
+ *
+ *                    Weather Stations                  Professional  3-in-1 Professional
+ *                 5-in-1  6-in-1  7-in-1  8-in-1        Rain Gauge       Wind Gauge
+ *
+ * Temperature       X       X       X       X              X                 X
+ * Humidity          X       X       X       X                                X
+ * Wind              X       X       X       X                                X
+ * Rain              X       X       X       X              X
+ * UV                        X       X       X
+ * Light Intensity                   X       X
+ * Globe Thermometer                         X
+ *
+ * Keep one entry per line - the table is parsed by scripts/gen_payload_schema.js!
+ */
+constexpr sPayloadField payloadSchema[] = {
+    // PAYLOAD_SCHEMA_BEGIN
+    {SENSOR_TYPE_WEATHER1, 0, E_PAYLOAD_ENC::E_TEMPERATURE, "ws_temp_c", PayloadGet::wsTemp},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_HUMIDITY, E_PAYLOAD_ENC::E_UINT8, "ws_humidity", PayloadGet::wsHumidity},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_RAINGAUGE, E_PAYLOAD_ENC::E_RAWFLOAT, "ws_rain_mm", PayloadGet::wsRain},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_WIND, E_PAYLOAD_ENC::E_UINT16FP1, "ws_wind_avg_ms", PayloadGet::wsWindAvg},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_WIND, E_PAYLOAD_ENC::E_UINT16FP1, "ws_wind_gust_ms", PayloadGet::wsWindGust},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_WIND, E_PAYLOAD_ENC::E_UINT16FP1, "ws_wind_dir_deg", PayloadGet::wsWindDir},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_UV, E_PAYLOAD_ENC::E_UINT8FP1, "ws_uv", PayloadGet::wsUv},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_LIGHT, E_PAYLOAD_ENC::E_UINT32, "ws_light_lux", PayloadGet::wsLight},
+#ifdef RAINDATA_EN
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_RAIN_H, E_PAYLOAD_ENC::E_RAWFLOAT, "ws_rain_hourly_mm", PayloadGet::wsRainHour},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_RAIN_DWM, E_PAYLOAD_ENC::E_RAWFLOAT, "ws_rain_daily_mm", PayloadGet::wsRainDay},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_RAIN_DWM, E_PAYLOAD_ENC::E_RAWFLOAT, "ws_rain_weekly_mm", PayloadGet::wsRainWeek},
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_RAIN_DWM, E_PAYLOAD_ENC::E_RAWFLOAT, "ws_rain_monthly_mm", PayloadGet::wsRainMonth},
+#endif
+    {SENSOR_TYPE_WEATHER1, PAYLOAD_WS_TGLOBE, E_PAYLOAD_ENC::E_TEMPERATURE, "ws_tglobe_c", PayloadGet::wsTglobe},
+    {SENSOR_TYPE_THERMO_HYGRO, 0, E_PAYLOAD_ENC::E_TEMPERATURE, "th#_temp_c", PayloadGet::temp},
+    {SENSOR_TYPE_THERMO_HYGRO, 0, E_PAYLOAD_ENC::E_UINT8, "th#_humidity", PayloadGet::humidity},
+    {SENSOR_TYPE_POOL_THERMO, 0, E_PAYLOAD_ENC::E_TEMPERATURE, "pt#_temp_c", PayloadGet::temp},
+    {SENSOR_TYPE_SOIL, 0, E_PAYLOAD_ENC::E_TEMPERATURE, "soil#_temp_c", PayloadGet::soilTemp},
+    {SENSOR_TYPE_SOIL, 0, E_PAYLOAD_ENC::E_UINT8, "soil#_moisture", PayloadGet::soilMoisture},
+    {SENSOR_TYPE_LEAKAGE, 0, E_PAYLOAD_ENC::E_UINT8, "leak#_alarm", PayloadGet::leakAlarm},
+    {SENSOR_TYPE_AIR_PM, 0, E_PAYLOAD_ENC::E_UINT16, "pm#_pm1_0_ug_m3", PayloadGet::pm1_0},
+    {SENSOR_TYPE_AIR_PM, 0, E_PAYLOAD_ENC::E_UINT16, "pm#_pm2_5_ug_m3", PayloadGet::pm2_5},
+    {SENSOR_TYPE_AIR_PM, 0, E_PAYLOAD_ENC::E_UINT16, "pm#_pm10_ug_m3", PayloadGet::pm10},
+#ifdef LIGHTNINGSENSOR_EN
+    {SENSOR_TYPE_LIGHTNING, PAYLOAD_LIGHTNING_RAW, E_PAYLOAD_ENC::E_UINT8, "lgt_storm_dist_km", PayloadGet::lgtDistance},
+    {SENSOR_TYPE_LIGHTNING, PAYLOAD_LIGHTNING_RAW, E_PAYLOAD_ENC::E_UINT16, "lgt_strike_count", PayloadGet::lgtStrikes},
+    {SENSOR_TYPE_LIGHTNING, PAYLOAD_LIGHTNING_PROC, E_PAYLOAD_ENC::E_UNIXTIME, "lgt_ev_time", PayloadGet::lgtEvTime},
+    {SENSOR_TYPE_LIGHTNING, PAYLOAD_LIGHTNING_PROC, E_PAYLOAD_ENC::E_UINT16, "lgt_ev_events", PayloadGet::lgtEvEvents},
+    {SENSOR_TYPE_LIGHTNING, PAYLOAD_LIGHTNING_PROC, E_PAYLOAD_ENC::E_UINT8, "lgt_ev_dist_km", PayloadGet::lgtEvDistance},
+#endif
+    {SENSOR_TYPE_CO2, 0, E_PAYLOAD_ENC::E_UINT16, "co2#_co2_ppm", PayloadGet::co2},
+    {SENSOR_TYPE_HCHO_VOC, 0, E_PAYLOAD_ENC::E_UINT16, "aq#_hcho_ppb", PayloadGet::hcho},
+    {SENSOR_TYPE_HCHO_VOC, 0, E_PAYLOAD_ENC::E_UINT8, "aq#_voc", PayloadGet::voc},
+    // PAYLOAD_SCHEMA_END
+};
+
+/*!
+ * \brief Size of an encoded field
+ *
+ * \param enc field encoding
+ *
+ * \returns size in bytes
+ */
+constexpr uint8_t payloadFieldBytes(E_PAYLOAD_ENC enc)
+{
+    return (enc == E_PAYLOAD_ENC::E_UINT8 || enc == E_PAYLOAD_ENC::E_UINT8FP1)                                 ? 1
+           : (enc == E_PAYLOAD_ENC::E_TEMPERATURE || enc == E_PAYLOAD_ENC::E_UINT16 || enc == E_PAYLOAD_ENC::E_UINT16FP1) ? 2
+                                                                                                                  : 4;
+}
+
+/*!
+ * \brief Payload size of a sensor
+ *
+ * \param type  sensor type
+ * \param flags configuration flags (PAYLOAD_WS_* / PAYLOAD_LIGHTNING_*)
+ *
+ * \returns size in bytes
+ */
+constexpr uint8_t payloadBytes(uint8_t type, uint16_t flags)
+{
+    uint8_t size = 0;
+    for (const auto &field : payloadSchema)
+    {
+        if ((field.type == type) && ((field.flag == 0) || (flags & field.flag)))
+            size += payloadFieldBytes(field.enc);
+    }
+    return size;
+}
+
+static_assert(payloadBytes(SENSOR_TYPE_THERMO_HYGRO, 0) == 3, "Payload size of SENSOR_TYPE_THERMO_HYGRO");
+static_assert(payloadBytes(SENSOR_TYPE_POOL_THERMO, 0) == 2, "Payload size of SENSOR_TYPE_POOL_THERMO");
+static_assert(payloadBytes(SENSOR_TYPE_SOIL, 0) == 3, "Payload size of SENSOR_TYPE_SOIL");
+static_assert(payloadBytes(SENSOR_TYPE_LEAKAGE, 0) == 1, "Payload size of SENSOR_TYPE_LEAKAGE");
+static_assert(payloadBytes(SENSOR_TYPE_AIR_PM, 0) == 6, "Payload size of SENSOR_TYPE_AIR_PM");
+static_assert(payloadBytes(SENSOR_TYPE_CO2, 0) == 2, "Payload size of SENSOR_TYPE_CO2");
+static_assert(payloadBytes(SENSOR_TYPE_HCHO_VOC, 0) == 3, "Payload size of SENSOR_TYPE_HCHO_VOC");
+#ifdef LIGHTNINGSENSOR_EN
+static_assert(payloadBytes(SENSOR_TYPE_LIGHTNING, PAYLOAD_LIGHTNING_RAW | PAYLOAD_LIGHTNING_PROC) == 10, "Payload size of SENSOR_TYPE_LIGHTNING");
+#endif
+
+#endif // _PAYLOAD_SCHEMA_H
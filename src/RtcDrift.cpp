@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+// RtcDrift.cpp
+//
+// RTC drift estimation for BresserWeatherSensorLW
+//
+// - Estimates the drift rate of the MCU's sleep clock from the offsets
+//   observed at consecutive clock synchronizations (GPS or LoRaWAN network time)
+// - Corrects the system clock by the estimated drift once per wake cycle
+// - Converts sleep durations to the (drifting) sleep clock
+// - Predicts the clock error since the last synchronization
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file RtcDrift.cpp
+ *  \brief RTC drift estimation for BresserWeatherSensorLW
+ */
+
+#include "RtcDrift.h"
+
+/// Marker for valid retained state
+#define RTC_DRIFT_MAGIC 0x44524654UL
+
+/// Retained state
+struct sRtcDriftState
+{
+    uint32_t magic;    //!< RTC_DRIFT_MAGIC if valid
+    uint8_t samples;   //!< number of drift measurements
+    float rate;        //!< estimated drift rate (positive: clock runs fast)
+    float uncertainty; //!< estimated uncertainty of drift rate
+    int64_t lastCorr;  //!< time of last correction in us
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sRtcDriftState rtcDriftState = {0}; //!< RTC drift state
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sRtcDriftState rtcDriftState __attribute__((section(".uninitialized_data"))); //!< RTC drift state
+#endif
+
+/*!
+ * \brief Get current time in us
+ *
+ * \returns time in us
+ */
+static int64_t nowUs(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return static_cast<int64_t>(tv.tv_sec) * 1000000LL + tv.tv_usec;
+}
+
+void RtcDrift::init(void)
+{
+    if (rtcDriftState.magic == RTC_DRIFT_MAGIC)
+        return;
+
+    // Uninitialized after power-on/HW reset
+    memset(&rtcDriftState, 0, sizeof(rtcDriftState));
+    rtcDriftState.magic = RTC_DRIFT_MAGIC;
+    rtcDriftState.lastCorr = nowUs();
+}
+
+void RtcDrift::correct(void)
+{
+    init();
+    int64_t now = nowUs();
+    int64_t elapsed = now - rtcDriftState.lastCorr;
+    if ((rtcDriftState.samples == 0) || (elapsed <= 0))
+    {
+        rtcDriftState.lastCorr = now;
+        return;
+    }
+
+    // Clock running fast (rate > 0) has to be set back
+    int64_t corr = static_cast<int64_t>(static_cast<double>(elapsed) * rtcDriftState.rate / (1.0 + rtcDriftState.rate));
+    now -= corr;
+
+    struct timeval tv = {static_cast<time_t>(now / 1000000LL), static_cast<suseconds_t>(now % 1000000LL)};
+    settimeofday(&tv, nullptr);
+    rtcDriftState.lastCorr = now;
+    log_d("RTC drift correction: %ld ms", static_cast<long>(corr / 1000));
+}
+
+void RtcDrift::sync(time_t epoch, uint16_t ms, time_t lastSync, bool update)
+{
+    init();
+    int64_t ref = static_cast<int64_t>(epoch) * 1000000LL + ms * 1000LL;
+    int64_t offset = nowUs() - ref;
+    int32_t elapsed = static_cast<int32_t>(epoch - lastSync);
+
+    if (update && (elapsed >= RTC_DRIFT_MIN_INTERVAL * 60))
+    {
+        // Drift rate not yet compensated by correct()
+        float residual = static_cast<float>(static_cast<double>(offset) / 1e6 / elapsed);
+        if (rtcDriftState.samples == 0)
+        {
+            rtcDriftState.rate = residual;
+        }
+        else
+        {
+            // The residual shows the error of the estimate
+            rtcDriftState.uncertainty = (rtcDriftState.samples == 1)
+                                            ? fabsf(residual)
+                                            : (rtcDriftState.uncertainty + fabsf(residual)) / 2;
+            rtcDriftState.rate += residual / 2;
+        }
+        if (rtcDriftState.samples < 255)
+            rtcDriftState.samples++;
+
+        log_i("RTC offset: %ld ms after %ld s, drift: %.1f ppm (+/- %.1f ppm)",
+              static_cast<long>(offset / 1000), static_cast<long>(elapsed),
+              rtcDriftState.rate * 1e6, rtcDriftState.uncertainty * 1e6);
+    }
+    else
+    {
+        log_d("RTC offset: %ld ms", static_cast<long>(offset / 1000));
+    }
+    rtcDriftState.lastCorr = ref;
+}
+
+void RtcDrift::restart(void)
+{
+    init();
+    rtcDriftState.lastCorr = nowUs();
+}
+
+bool RtcDrift::valid(void)
+{
+    init();
+    return rtcDriftState.samples >= 2;
+}
+
+float RtcDrift::predictedError(uint32_t elapsed)
+{
+    init();
+    float uncertainty = max(rtcDriftState.uncertainty, static_cast<float>(RTC_DRIFT_MIN_PPM * 1e-6));
+    return elapsed * uncertainty;
+}
+
+uint32_t RtcDrift::localDuration(uint32_t seconds)
+{
+    init();
+    return static_cast<uint32_t>(seconds * (1.0 + rtcDriftState.rate) + 0.5);
+}
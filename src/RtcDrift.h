@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// RtcDrift.h
+//
+// RTC drift estimation for BresserWeatherSensorLW
+//
+// - Estimates the drift rate of the MCU's sleep clock from the offsets
+//   observed at consecutive clock synchronizations (GPS or LoRaWAN network time)
+// - Corrects the system clock by the estimated drift once per wake cycle
+// - Converts sleep durations to the (drifting) sleep clock
+// - Predicts the clock error since the last synchronization
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file RtcDrift.h
+ *  \brief RTC drift estimation for BresserWeatherSensorLW
+ */
+
+#if !defined(_RTC_DRIFT_H)
+#define _RTC_DRIFT_H
+
+#include <Arduino.h>
+#include <sys/time.h>
+#include <time.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "logging.h"
+
+/*!
+ * \brief RTC drift estimation
+ *
+ * The drift rate is the relative deviation of the sleep clock from the
+ * reference time (positive: clock runs fast). After the first estimate,
+ * the system clock is corrected by the estimated drift and the remaining
+ * offset observed at the next synchronization is used to refine the
+ * estimate and to determine its uncertainty.
+ *
+ * All instances share the same state, which is retained during deep sleep.
+ */
+class RtcDrift
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    RtcDrift() {};
+
+    /*!
+     * \brief Correct system clock by estimated drift since last correction
+     *
+     * Has to be called once per wake cycle, after the system clock has been restored.
+     */
+    void correct(void);
+
+    /*!
+     * \brief Update drift estimate from reference time
+     *
+     * Has to be called before the system clock is set to the reference time.
+     *
+     * \param epoch    reference time (seconds)
+     * \param ms       reference time (milliseconds)
+     * \param lastSync time of previous synchronization
+     * \param update   true: update estimate, false: only restart correction from reference time
+     */
+    void sync(time_t epoch, uint16_t ms, time_t lastSync, bool update);
+
+    /*!
+     * \brief Restart correction from current time
+     *
+     * Has to be called if the system clock was set without a call of sync().
+     */
+    void restart(void);
+
+    /*!
+     * \brief Check if drift estimate and uncertainty are available
+     *
+     * \returns true if valid
+     */
+    bool valid(void);
+
+    /*!
+     * \brief Predict clock error
+     *
+     * \param elapsed time since last synchronization in seconds
+     *
+     * \returns predicted max. clock error in seconds
+     */
+    float predictedError(uint32_t elapsed);
+
+    /*!
+     * \brief Convert duration to sleep clock
+     *
+     * \param seconds duration in seconds (reference time)
+     *
+     * \returns duration in seconds (sleep clock)
+     */
+    uint32_t localDuration(uint32_t seconds);
+
+private:
+    /*!
+     * \brief Initialize retained state after power-on/reset
+     */
+    void init(void);
+};
+
+#endif // _RTC_DRIFT_H
@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////////
+// SampleBatch.cpp
+//
+// Batched multi-sample uplinks for BresserWeatherSensorLW
+//
+// - Stores the sensor data of each wake-up as timestamped record in a ring
+//   buffer which is retained during deep sleep
+// - Decides if the LoRaWAN radio has to be activated (batch uplink due)
+// - Encodes the stored records as one uplink; records after the first one
+//   are encoded as difference to the previous record
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Split encode() and commit() - records are only removed after successful uplink
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file SampleBatch.cpp
+ *  \brief Batched multi-sample uplinks for BresserWeatherSensorLW
+ */
+
+#include "SampleBatch.h"
+
+/// Marker for valid retained ring buffer
+#define SAMPLE_BATCH_MAGIC 0x42415443UL
+
+/// Size of batch uplink header incl. record size
+#define SAMPLE_BATCH_HEADER_SIZE 6
+
+/// Sensor data record
+struct sSampleRecord
+{
+    uint32_t time;                    //!< timestamp (unix time)
+    uint8_t size;                     //!< payload size in bytes
+    uint8_t payload[MAX_UPLINK_SIZE]; //!< sensor data payload
+};
+
+/// Ring buffer of sensor data records
+struct sSampleRing
+{
+    uint32_t magic;                          //!< SAMPLE_BATCH_MAGIC if valid
+    uint8_t head;                            //!< index of oldest record
+    uint8_t count;                           //!< number of records
+    uint8_t maxLen;                          //!< max. payload size of previous uplink
+    sSampleRecord records[SAMPLE_BATCH_SIZE]; //!< records
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sSampleRing sampleRing = {0}; //!< sensor data records
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sSampleRing sampleRing __attribute__((section(".uninitialized_data"))); //!< sensor data records
+#endif
+
+bool SampleBatch::add(const uint8_t *payload, uint8_t size, time_t t)
+{
+    if ((sampleRing.magic != SAMPLE_BATCH_MAGIC) || (sampleRing.head >= SAMPLE_BATCH_SIZE) ||
+        (sampleRing.count > SAMPLE_BATCH_SIZE))
+    {
+        // Uninitialized after power-on/HW reset
+        sampleRing.magic = SAMPLE_BATCH_MAGIC;
+        sampleRing.head = 0;
+        sampleRing.count = 0;
+        sampleRing.maxLen = MAX_UPLINK_SIZE;
+    }
+
+    if (sampleRing.count == SAMPLE_BATCH_SIZE)
+    {
+        log_w("Sample buffer full - discarding oldest record");
+        sampleRing.head = (sampleRing.head + 1) % SAMPLE_BATCH_SIZE;
+        sampleRing.count--;
+    }
+
+    sSampleRecord &record = sampleRing.records[(sampleRing.head + sampleRing.count) % SAMPLE_BATCH_SIZE];
+    record.time = static_cast<uint32_t>(t);
+    record.size = min(size, MAX_UPLINK_SIZE);
+    memcpy(record.payload, payload, record.size);
+    sampleRing.count++;
+
+    if (sampleRing.count >= SAMPLE_BATCH_SIZE)
+    {
+        log_d("Sample batch complete");
+        return true;
+    }
+
+    // Batch uplink is due if not all records fit or if there is no space left for another one
+    uint8_t num;
+    uint8_t len = encodeRecords(nullptr, sampleRing.maxLen, num);
+    uint8_t minRecordSize = 2 + (record.size + 7) / 8;
+    log_d("Sample batch: %u records, %u bytes (max. %u)", sampleRing.count, len, sampleRing.maxLen);
+
+    return (num < sampleRing.count) || (len + minRecordSize > sampleRing.maxLen);
+}
+
+uint8_t SampleBatch::encode(uint8_t *buf, uint8_t maxLen, uint8_t &port)
+{
+    maxLen = min(maxLen, static_cast<uint8_t>(SAMPLE_BATCH_MAX_UPLINK_SIZE));
+    sampleRing.maxLen = maxLen;
+    encodedNum = 0;
+
+    if ((sampleRing.magic != SAMPLE_BATCH_MAGIC) || (sampleRing.count == 0))
+        return 0;
+
+    uint8_t num;
+    uint8_t len = encodeRecords(buf, maxLen, num);
+    if (num == 0)
+    {
+        // First record does not fit into batch uplink - send as regular sensor data uplink
+        const sSampleRecord &record = sampleRing.records[sampleRing.head];
+        log_w("Sample record (%u bytes) does not fit into batch uplink", record.size);
+        memcpy(buf, record.payload, record.size);
+        len = record.size;
+        num = 1;
+    }
+    else
+    {
+        port = SAMPLE_BATCH_PORT;
+        log_i("Sample batch uplink: %u of %u records, %u bytes", num, sampleRing.count, len);
+    }
+
+    encodedNum = num;
+
+    return len;
+}
+
+void SampleBatch::commit(void)
+{
+    if ((encodedNum == 0) || (sampleRing.magic != SAMPLE_BATCH_MAGIC))
+        return;
+
+    uint8_t num = min(encodedNum, sampleRing.count);
+    sampleRing.head = (sampleRing.head + num) % SAMPLE_BATCH_SIZE;
+    sampleRing.count -= num;
+    encodedNum = 0;
+    log_d("Sample batch sent, %u records remaining", sampleRing.count);
+}
+
+uint8_t SampleBatch::encodeRecords(uint8_t *buf, uint8_t maxLen, uint8_t &num)
+{
+    num = 0;
+    if (sampleRing.count == 0)
+        return 0;
+
+    const sSampleRecord &first = sampleRing.records[sampleRing.head];
+    if (SAMPLE_BATCH_HEADER_SIZE + first.size > maxLen)
+        return 0;
+
+    if (buf)
+    {
+        buf[1] = first.time & 0xFF;
+        buf[2] = (first.time >> 8) & 0xFF;
+        buf[3] = (first.time >> 16) & 0xFF;
+        buf[4] = (first.time >> 24) & 0xFF;
+        buf[5] = first.size;
+        memcpy(&buf[SAMPLE_BATCH_HEADER_SIZE], first.payload, first.size);
+    }
+    uint8_t len = SAMPLE_BATCH_HEADER_SIZE + first.size;
+    num = 1;
+
+    const sSampleRecord *prev = &first;
+    for (uint8_t i = 1; i < sampleRing.count; i++)
+    {
+        const sSampleRecord &record = sampleRing.records[(sampleRing.head + i) % SAMPLE_BATCH_SIZE];
+
+        // Payload layout changed
+        if (record.size != first.size)
+            break;
+
+        // Time since previous record (RTC may have been set in between)
+        uint32_t dt = (record.time > prev->time) ? record.time - prev->time : 0;
+        dt = min(dt, static_cast<uint32_t>(0xFFFF));
+
+        uint8_t rec[2 + MAX_UPLINK_SIZE + (MAX_UPLINK_SIZE + 7) / 8];
+        rec[0] = dt & 0xFF;
+        rec[1] = dt >> 8;
+        uint8_t recLen = 2 + PayloadDelta::diff(prev->payload, record.payload, record.size, &rec[2]);
+        if (len + recLen > maxLen)
+            break;
+
+        if (buf)
+            memcpy(&buf[len], rec, recLen);
+        len += recLen;
+        num++;
+        prev = &record;
+    }
+
+    if (buf)
+        buf[0] = num;
+
+    return len;
+}
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// SampleBatch.h
+//
+// Batched multi-sample uplinks for BresserWeatherSensorLW
+//
+// - Stores the sensor data of each wake-up as timestamped record in a ring
+//   buffer which is retained during deep sleep
+// - Decides if the LoRaWAN radio has to be activated (batch uplink due)
+// - Encodes the stored records as one uplink; records after the first one
+//   are encoded as difference to the previous record
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Split encode() and commit() - records are only removed after successful uplink
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file SampleBatch.h
+ *  \brief Batched multi-sample uplinks for BresserWeatherSensorLW
+ */
+
+#if !defined(_SAMPLE_BATCH_H)
+#define _SAMPLE_BATCH_H
+
+#include <Arduino.h>
+#include <time.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "PayloadDelta.h"
+#include "logging.h"
+
+/*!
+ * \brief Batched multi-sample uplinks
+ *
+ * Batch uplink (SAMPLE_BATCH_PORT):
+ *
+ * byte 0:        number of records
+ * byte 1..4:     timestamp of first record (unix time, little endian)
+ * byte 5:        record size s
+ * byte 6..s+5:   first record (sensor data as on port 1)
+ * further records:
+ *   2 bytes:     time since previous record in seconds (little endian)
+ *   (s+7)/8 bytes: bitmap of bytes changed w.r.t. previous record
+ *   n bytes:     changed bytes
+ *
+ * Only records of the same size are combined. If the first record does
+ * not fit into a batch uplink, it is sent as regular sensor data uplink.
+ */
+class SampleBatch
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    SampleBatch() {};
+
+    /*!
+     * \brief Add sensor data record
+     *
+     * If the ring buffer is full, the oldest record is overwritten.
+     *
+     * \param payload sensor data payload
+     * \param size    payload size in bytes
+     * \param t       timestamp
+     *
+     * \returns true if a batch uplink is due
+     */
+    bool add(const uint8_t *payload, uint8_t size, time_t t);
+
+    /*!
+     * \brief Encode batch uplink
+     *
+     * The records contained in the uplink are kept in the ring buffer until
+     * commit() is called; remaining records are sent with the next uplink.
+     *
+     * \param buf    uplink buffer (at least SAMPLE_BATCH_MAX_UPLINK_SIZE bytes)
+     * \param maxLen max. payload size (node.getMaxPayloadLen())
+     * \param port   LoRaWAN port; set to SAMPLE_BATCH_PORT for a batch uplink
+     *
+     * \returns uplink size in bytes
+     */
+    uint8_t encode(uint8_t *buf, uint8_t maxLen, uint8_t &port);
+
+    /*!
+     * \brief Remove records contained in the last encoded uplink from the ring buffer
+     *
+     * Must only be called after the uplink has been sent successfully -
+     * otherwise, the records are sent again with the next batch uplink.
+     */
+    void commit(void);
+
+private:
+    uint8_t encodedNum = 0; //!< number of records contained in the last encoded uplink
+
+    /*!
+     * \brief Encode records
+     *
+     * \param buf    uplink buffer, nullptr: get size only
+     * \param maxLen max. payload size
+     * \param num    number of records encoded
+     *
+     * \returns uplink size in bytes
+     */
+    uint8_t encodeRecords(uint8_t *buf, uint8_t maxLen, uint8_t &num);
+};
+
+#endif // _SAMPLE_BATCH_H
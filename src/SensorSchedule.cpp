@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////////////////////////
+// SensorSchedule.cpp
+//
+// Bresser sensor transmit-phase scheduling for BresserWeatherSensorLW
+//
+// - Records the reception time of each required sensor in memory which
+//   is retained during deep sleep
+// - Learns each sensor's transmit period and phase
+// - Provides the receive window required for the next expected
+//   transmissions and aligns the wake-up time to the transmissions
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Validate retained schedule in all accessors (begin() may be skipped)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file SensorSchedule.cpp
+ *  \brief Bresser sensor transmit-phase scheduling for BresserWeatherSensorLW
+ */
+
+#include "SensorSchedule.h"
+
+/// Marker for valid retained schedule
+#define SENSOR_SCHEDULE_MAGIC 0x53434844UL
+
+/// Schedule of a sensor
+struct sSensorScheduleRec
+{
+    uint8_t type;       //!< sensor type
+    uint8_t ch;         //!< channel
+    uint32_t period_ms; //!< transmit period in ms, 0 if unknown
+    int64_t last_ms;    //!< time of last reception in ms since epoch
+};
+
+/// Schedule of all required sensors
+struct sSensorSchedule
+{
+    uint32_t magic;                                //!< SENSOR_SCHEDULE_MAGIC if valid
+    uint8_t count;                                 //!< number of valid records
+    sSensorScheduleRec rec[SENSOR_SCHEDULE_SLOTS]; //!< sensor records
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sSensorSchedule sensorSchedule = {0}; //!< sensor transmit schedule
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sSensorSchedule sensorSchedule __attribute__((section(".uninitialized_data"))); //!< sensor transmit schedule
+#endif
+
+/*!
+ * \brief Check if retained schedule is valid
+ *
+ * The schedule is uninitialized after power-on/HW reset until begin() has been
+ * called - which is skipped in some wake cycles (e.g. no Bresser sensor required,
+ * sensor scan mode, resumed uplink).
+ *
+ * \returns true if valid
+ */
+static bool scheduleValid(void)
+{
+    return (sensorSchedule.magic == SENSOR_SCHEDULE_MAGIC) && (sensorSchedule.count <= SENSOR_SCHEDULE_SLOTS);
+}
+
+void SensorSchedule::begin(const uint8_t *required)
+{
+    // Uninitialized after power-on/HW reset
+    if (!scheduleValid())
+    {
+        log_d("Sensor schedule reset");
+        memset(&sensorSchedule, 0, sizeof(sensorSchedule));
+        sensorSchedule.magic = SENSOR_SCHEDULE_MAGIC;
+    }
+
+    // Keep records of required sensors, add new ones
+    sSensorSchedule prev = sensorSchedule;
+    sensorSchedule.count = 0;
+    for (uint8_t type = 0; type < 16; type++)
+    {
+        for (uint8_t ch = 0; ch <= 7; ch++)
+        {
+            if (!((required[type] >> ch) & 1))
+                continue;
+
+            if (sensorSchedule.count == SENSOR_SCHEDULE_SLOTS)
+            {
+                log_w("Sensor schedule full");
+                return;
+            }
+
+            sSensorScheduleRec rec = {type, ch, 0, 0};
+            for (uint8_t i = 0; i < prev.count; i++)
+            {
+                if ((prev.rec[i].type == type) && (prev.rec[i].ch == ch))
+                {
+                    rec = prev.rec[i];
+                    break;
+                }
+            }
+            sensorSchedule.rec[sensorSchedule.count++] = rec;
+        }
+    }
+}
+
+int SensorSchedule::find(uint8_t type, uint8_t ch)
+{
+    if (!scheduleValid())
+        return -1;
+
+    for (uint8_t i = 0; i < sensorSchedule.count; i++)
+    {
+        if ((sensorSchedule.rec[i].type == type) && (sensorSchedule.rec[i].ch == ch))
+            return i;
+    }
+    return -1;
+}
+
+uint32_t SensorSchedule::rxWindow(void)
+{
+    if (!scheduleValid())
+        return 0;
+
+    int64_t now = nowMs();
+    int64_t window = 0;
+
+    for (uint8_t i = 0; i < sensorSchedule.count; i++)
+    {
+        const sSensorScheduleRec &rec = sensorSchedule.rec[i];
+        if (rec.period_ms == 0)
+            return 0;
+
+        // Next expected transmission
+        int64_t periods = (now - rec.last_ms + rec.period_ms - 1) / rec.period_ms;
+        int64_t next = rec.last_ms + max(periods, static_cast<int64_t>(0)) * rec.period_ms;
+        window = max(window, next - now + SENSOR_SCHEDULE_GUARD_MS);
+    }
+    log_d("Expected receive window: %lu ms", static_cast<unsigned long>(window));
+    return static_cast<uint32_t>(window);
+}
+
+void SensorSchedule::update(uint8_t type, uint8_t ch)
+{
+    int idx = find(type, ch);
+    if (idx < 0)
+        return;
+
+    sSensorScheduleRec &rec = sensorSchedule.rec[idx];
+    int64_t now = nowMs();
+
+    if (rec.period_ms == 0)
+    {
+        // Learning - measure period from two receptions in the same wake cycle
+        if (learning[idx])
+        {
+            int64_t period = now - rec.last_ms;
+            if ((period >= SENSOR_SCHEDULE_PERIOD_MIN_MS) && (period <= SENSOR_SCHEDULE_PERIOD_MAX_MS))
+            {
+                rec.period_ms = period;
+                learning[idx] = false;
+                log_i("Sensor type %u ch %u: period %lu ms", type, ch, static_cast<unsigned long>(rec.period_ms));
+            }
+        }
+        else
+        {
+            learning[idx] = true;
+        }
+        rec.last_ms = now;
+        return;
+    }
+
+    // Tracking - refine period by residual
+    int64_t elapsed = now - rec.last_ms;
+    int64_t periods = (elapsed + rec.period_ms / 2) / rec.period_ms;
+    int64_t residual = elapsed - periods * rec.period_ms;
+
+    if ((periods < 1) || (residual > SENSOR_SCHEDULE_GUARD_MS) || (residual < -SENSOR_SCHEDULE_GUARD_MS))
+    {
+        log_i("Sensor type %u ch %u: out of schedule (residual %ld ms), learning again", type, ch, static_cast<long>(residual));
+        rec.period_ms = 0;
+        learning[idx] = true;
+    }
+    else
+    {
+        rec.period_ms += residual / periods / 2;
+        log_d("Sensor type %u ch %u: residual %ld ms, period %lu ms", type, ch, static_cast<long>(residual),
+              static_cast<unsigned long>(rec.period_ms));
+    }
+    rec.last_ms = now;
+}
+
+void SensorSchedule::miss(uint8_t type, uint8_t ch)
+{
+    int idx = find(type, ch);
+    if (idx < 0)
+        return;
+
+    log_i("Sensor type %u ch %u: missed prediction", type, ch);
+    sensorSchedule.rec[idx].period_ms = 0;
+    learning[idx] = false;
+}
+
+bool SensorSchedule::isLearned(uint8_t type, uint8_t ch)
+{
+    int idx = find(type, ch);
+    return (idx >= 0) && (sensorSchedule.rec[idx].period_ms != 0);
+}
+
+uint32_t SensorSchedule::alignWakeup(uint32_t sleepSeconds)
+{
+    // The sensor with the longest period determines the wake-up time;
+    // all other sensors will transmit within their (shorter) periods.
+    if (!scheduleValid())
+        return sleepSeconds;
+
+    const sSensorScheduleRec *anchor = nullptr;
+    for (uint8_t i = 0; i < sensorSchedule.count; i++)
+    {
+        if (sensorSchedule.rec[i].period_ms == 0)
+            return sleepSeconds;
+
+        if (!anchor || (sensorSchedule.rec[i].period_ms > anchor->period_ms))
+            anchor = &sensorSchedule.rec[i];
+    }
+    if (!anchor)
+        return sleepSeconds;
+
+    const int64_t lead = SENSOR_SCHEDULE_GUARD_MS + SENSOR_SCHEDULE_STARTUP_MS;
+    int64_t now = nowMs();
+    int64_t wakeup = now + static_cast<int64_t>(sleepSeconds) * 1000;
+
+    // Last expected transmission which can be received if waking up at the planned time
+    int64_t periods = (wakeup + lead - anchor->last_ms) / anchor->period_ms;
+    int64_t tx = anchor->last_ms + periods * anchor->period_ms;
+    int64_t aligned = (tx - lead - now) / 1000;
+
+    if (aligned < SLEEP_INTERVAL_MIN)
+        return sleepSeconds;
+
+    log_d("Wake-up aligned to sensor type %u ch %u: %lu s -> %lu s", anchor->type, anchor->ch,
+          static_cast<unsigned long>(sleepSeconds), static_cast<unsigned long>(aligned));
+    return static_cast<uint32_t>(aligned);
+}
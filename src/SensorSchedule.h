@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+// SensorSchedule.h
+//
+// Bresser sensor transmit-phase scheduling for BresserWeatherSensorLW
+//
+// - Records the reception time of each required sensor in memory which
+//   is retained during deep sleep
+// - Learns each sensor's transmit period and phase
+// - Provides the receive window required for the next expected
+//   transmissions and aligns the wake-up time to the transmissions
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file SensorSchedule.h
+ *  \brief Bresser sensor transmit-phase scheduling for BresserWeatherSensorLW
+ */
+
+#if !defined(_SENSOR_SCHEDULE_H)
+#define _SENSOR_SCHEDULE_H
+
+#include <Arduino.h>
+#include <sys/time.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "logging.h"
+
+/*!
+ * \brief Bresser sensor transmit-phase scheduling
+ *
+ * Bresser sensors transmit with a fixed period. Each sensor is identified
+ * by its (sensor type, channel) key as used in the payload configuration.
+ *
+ * Learning: If a sensor's period is not known, it is measured from two
+ * consecutive receptions within the same receive window.
+ *
+ * Tracking: On each reception, the number of periods elapsed since the
+ * last reception is determined and the period is refined by the residual.
+ * If the residual exceeds SENSOR_SCHEDULE_GUARD_MS, the sensor is learned
+ * again.
+ *
+ * The time base is the system time, which continues during deep sleep.
+ */
+class SensorSchedule
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    SensorSchedule() {};
+
+    /*!
+     * \brief Initialize schedule
+     *
+     * Validates the retained records and synchronizes them with the
+     * required sensors; records of sensors which are not required anymore
+     * are removed.
+     *
+     * \param required bitmap of channels per sensor type (16 entries)
+     */
+    void begin(const uint8_t *required);
+
+    /*!
+     * \brief Get receive window for the next expected transmissions
+     *
+     * \returns window in ms, 0 if any required sensor's period is unknown
+     */
+    uint32_t rxWindow(void);
+
+    /*!
+     * \brief Update schedule after reception of a sensor's data
+     *
+     * \param type sensor type
+     * \param ch   channel
+     */
+    void update(uint8_t type, uint8_t ch);
+
+    /*!
+     * \brief Invalidate schedule of a sensor after a missed prediction
+     *
+     * \param type sensor type
+     * \param ch   channel
+     */
+    void miss(uint8_t type, uint8_t ch);
+
+    /*!
+     * \brief Check if a sensor's period is known
+     *
+     * \param type sensor type
+     * \param ch   channel
+     *
+     * \returns true if the period is known
+     */
+    bool isLearned(uint8_t type, uint8_t ch);
+
+    /*!
+     * \brief Align wake-up time to the next expected transmissions
+     *
+     * The sleep duration is reduced (by max. one period of the sensor
+     * with the longest period) to wake up just before its transmission.
+     *
+     * \param sleepSeconds planned sleep duration in seconds
+     *
+     * \returns aligned sleep duration in seconds
+     */
+    uint32_t alignWakeup(uint32_t sleepSeconds);
+
+private:
+    /// First sample for learning has been taken in the current wake cycle (not retained)
+    bool learning[SENSOR_SCHEDULE_SLOTS] = {};
+
+    /*!
+     * \brief Find record of a sensor
+     *
+     * \param type sensor type
+     * \param ch   channel
+     *
+     * \returns index or -1 if not found
+     */
+    int find(uint8_t type, uint8_t ch);
+
+    /*!
+     * \brief Get system time
+     *
+     * \returns time in ms since epoch
+     */
+    int64_t nowMs(void)
+    {
+        struct timeval tv;
+        gettimeofday(&tv, nullptr);
+        return static_cast<int64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+    };
+};
+
+#endif // _SENSOR_SCHEDULE_H
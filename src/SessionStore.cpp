@@ -0,0 +1,374 @@
+///////////////////////////////////////////////////////////////////////////////
+// SessionStore.cpp
+//
+// Flash-wear-aware persistence of LoRaWAN nonces and session for
+// BresserWeatherSensorLW
+//
+// - Nonces and session are cached in memory which is retained during deep sleep;
+//   flash is only read after power-on/reset
+// - Nonces are written to flash only if they have changed - immediately after a
+//   successful join, otherwise after LW_NONCES_WRITE_INTERVAL failed join attempts
+// - A copy of the session with checksum is written to flash after a join and whenever
+//   the uplink frame counter has advanced by LW_SESSION_WRITE_INTERVAL; it is used
+//   if the session in retained memory was lost (power-on/reset), which avoids a rejoin
+// - On restore, the uplink frame counter is advanced beyond all values which may
+//   have been used since the copy was written (no frame counter reuse)
+// - The number of flash writes is counted for monitoring flash wear
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Session flash copy is written based on uplink frame counter,
+//          frame counter is advanced when restoring from flash
+//          Frame counter and DevNonce reserves are kept in separate records,
+//          restored session is verified via getFCntUp()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file SessionStore.cpp
+ *  \brief Flash-wear-aware persistence of LoRaWAN nonces and session
+ */
+
+#include "SessionStore.h"
+
+/// Marker for valid retained state
+#define SESSION_STORE_MAGIC 0x4C57534EUL
+
+/// Preferences namespace
+#define SESSION_STORE_NS "radiolib"
+
+/// Retained state
+struct sSessionStoreState
+{
+    uint32_t magic;                                   //!< SESSION_STORE_MAGIC if valid
+    bool noncesValid;                                 //!< nonces available
+    uint8_t nonces[RADIOLIB_LORAWAN_NONCES_BUF_SIZE]; //!< nonces (as in flash, unless noncesDirty)
+    bool noncesDirty;                                 //!< nonces not written to flash yet
+    uint8_t failedJoins;                              //!< failed join attempts since last nonces write
+    bool noncesRestored;                              //!< nonces restored from flash after power-on/reset
+    bool sessionNew;                                  //!< new session (joined), not written to flash yet
+    bool flashFCntValid;                              //!< flashFCnt is valid
+    uint32_t flashFCnt;                               //!< uplink frame counter of session in flash
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sSessionStoreState sessionStoreState = {0}; //!< nonces/session state
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sSessionStoreState sessionStoreState __attribute__((section(".uninitialized_data"))); //!< nonces/session state
+#endif
+
+/*!
+ * \brief Calculate CRC-16/CCITT-FALSE
+ *
+ * \param buf  data buffer
+ * \param size data size in bytes
+ *
+ * \returns CRC-16
+ */
+static uint16_t crc16(const uint8_t *buf, size_t size)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= static_cast<uint16_t>(buf[i]) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+// RadioLib provides no setters for the uplink frame counter and the DevNonce;
+// they are modified in the nonces/session buffers. The layout and the checksum
+// below are those of RadioLib's buffer version 1 - check on RadioLib update.
+static_assert(RADIOLIB_LORAWAN_NONCES_BUF_SIZE == 0x0E, "RadioLib nonces buffer layout changed");
+static_assert(RADIOLIB_LORAWAN_NONCES_DEV_NONCE == 0x07, "RadioLib nonces buffer layout changed");
+static_assert(RADIOLIB_LORAWAN_NONCES_SIGNATURE == RADIOLIB_LORAWAN_NONCES_BUF_SIZE - 2,
+              "RadioLib nonces buffer layout changed");
+static_assert(RADIOLIB_LORAWAN_SESSION_BUF_SIZE == 0x0170, "RadioLib session buffer layout changed");
+static_assert(RADIOLIB_LORAWAN_SESSION_FCNT_UP == 0x04, "RadioLib session buffer layout changed");
+static_assert(RADIOLIB_LORAWAN_SESSION_SIGNATURE == RADIOLIB_LORAWAN_SESSION_BUF_SIZE - 2,
+              "RadioLib session buffer layout changed");
+
+/*!
+ * \brief Calculate signature of RadioLib nonces/session buffer
+ *
+ * Same algorithm as LoRaWANNode::checkSum16() (not accessible):
+ * XOR of 16-bit words (big endian).
+ *
+ * \param buf  data buffer
+ * \param size data size in bytes
+ *
+ * \returns checksum
+ */
+static uint16_t bufferChecksum(const uint8_t *buf, size_t size)
+{
+    uint16_t checksum = 0;
+    for (size_t i = 0; i < size; i += 2)
+    {
+        uint16_t word = buf[i] << 8;
+        if (i + 1 < size)
+        {
+            word |= buf[i + 1];
+        }
+        checksum ^= word;
+    }
+    return checksum;
+}
+
+void SessionStore::init(void)
+{
+    if (sessionStoreState.magic == SESSION_STORE_MAGIC)
+        return;
+
+    // Uninitialized after power-on/HW reset
+    memset(&sessionStoreState, 0, sizeof(sessionStoreState));
+    sessionStoreState.magic = SESSION_STORE_MAGIC;
+
+    Preferences prefs;
+    if (!prefs.begin(SESSION_STORE_NS, true))
+        return;
+
+    if (prefs.getBytesLength("nonces") == RADIOLIB_LORAWAN_NONCES_BUF_SIZE)
+    {
+        prefs.getBytes("nonces", sessionStoreState.nonces, RADIOLIB_LORAWAN_NONCES_BUF_SIZE);
+        sessionStoreState.noncesValid = true;
+        sessionStoreState.noncesRestored = true;
+    }
+    log_d("Flash writes: nonces %u, session %u", prefs.getUInt("nonces_wr", 0), prefs.getUInt("session_wr", 0));
+    prefs.end();
+}
+
+bool SessionStore::loadNonces(uint8_t *nonces)
+{
+    init();
+    if (!sessionStoreState.noncesValid)
+        return false;
+
+    memcpy(nonces, sessionStoreState.nonces, RADIOLIB_LORAWAN_NONCES_BUF_SIZE);
+    return true;
+}
+
+void SessionStore::saveNonces(const uint8_t *nonces, bool joined)
+{
+    init();
+    if (joined)
+    {
+        // Write session to flash at next saveSession()
+        sessionStoreState.sessionNew = true;
+    }
+
+    if (!sessionStoreState.noncesValid ||
+        (memcmp(sessionStoreState.nonces, nonces, RADIOLIB_LORAWAN_NONCES_BUF_SIZE) != 0))
+    {
+        memcpy(sessionStoreState.nonces, nonces, RADIOLIB_LORAWAN_NONCES_BUF_SIZE);
+        sessionStoreState.noncesValid = true;
+        sessionStoreState.noncesDirty = true;
+    }
+
+    if (!sessionStoreState.noncesDirty)
+        return;
+
+    if (!joined && (++sessionStoreState.failedJoins < LW_NONCES_WRITE_INTERVAL))
+    {
+        log_d("Deferring nonces write (%u failed joins)", sessionStoreState.failedJoins);
+        return;
+    }
+
+    log_d("Saving nonces to flash");
+    Preferences prefs;
+    prefs.begin(SESSION_STORE_NS, false);
+    prefs.putBytes("nonces", sessionStoreState.nonces, RADIOLIB_LORAWAN_NONCES_BUF_SIZE);
+    countWrite(prefs, "nonces_wr");
+    prefs.end();
+    sessionStoreState.noncesDirty = false;
+    sessionStoreState.failedJoins = 0;
+}
+
+void SessionStore::restoreNonces(LoRaWANNode &node)
+{
+    init();
+    if (!sessionStoreState.noncesRestored)
+        return;
+
+    // Skip all DevNonce values which may have been used since the nonces
+    // were written to flash (little endian)
+    uint8_t buf[RADIOLIB_LORAWAN_NONCES_BUF_SIZE];
+    memcpy(buf, node.getBufferNonces(), RADIOLIB_LORAWAN_NONCES_BUF_SIZE);
+    uint8_t *devNonceBuf = &buf[RADIOLIB_LORAWAN_NONCES_DEV_NONCE];
+    uint32_t devNonce = devNonceBuf[0] | (devNonceBuf[1] << 8);
+
+    Preferences prefs;
+    prefs.begin(SESSION_STORE_NS, false);
+    devNonce = max(devNonce + LW_NONCES_DEVNONCE_RESERVE, static_cast<uint32_t>(prefs.getUShort("devnonce_rsv", 0)));
+    if (devNonce + LW_NONCES_DEVNONCE_RESERVE > UINT16_MAX)
+    {
+        log_e("DevNonce exhausted");
+        prefs.end();
+        return;
+    }
+    devNonceBuf[0] = devNonce & 0xFF;
+    devNonceBuf[1] = devNonce >> 8;
+
+    // Update RadioLib's signature of the nonces buffer (little endian)
+    uint16_t signature = bufferChecksum(buf, RADIOLIB_LORAWAN_NONCES_SIGNATURE);
+    buf[RADIOLIB_LORAWAN_NONCES_SIGNATURE] = signature & 0xFF;
+    buf[RADIOLIB_LORAWAN_NONCES_SIGNATURE + 1] = signature >> 8;
+
+    int16_t state = node.setBufferNonces(buf);
+    if (state != RADIOLIB_ERR_NONE)
+    {
+        log_e("Advancing DevNonce failed: %d", state);
+        prefs.end();
+        return;
+    }
+
+    // The DevNonces up to the next nonces write must not be used again after
+    // another power loss
+    prefs.putUShort("devnonce_rsv", devNonce + LW_NONCES_DEVNONCE_RESERVE);
+    countWrite(prefs, "nonces_wr");
+    prefs.end();
+    sessionStoreState.noncesRestored = false;
+    log_d("Nonces restored from flash, DevNonce advanced to %lu", static_cast<unsigned long>(devNonce));
+}
+
+int16_t SessionStore::restoreSession(LoRaWANNode &node)
+{
+    init();
+
+    uint8_t buf[RADIOLIB_LORAWAN_SESSION_BUF_SIZE + 2];
+    Preferences prefs;
+    if (!prefs.begin(SESSION_STORE_NS, false))
+        return RADIOLIB_ERR_SESSION_DISCARDED;
+
+    if (prefs.getBytesLength("session") != sizeof(buf))
+    {
+        prefs.end();
+        return RADIOLIB_ERR_SESSION_DISCARDED;
+    }
+    prefs.getBytes("session", buf, sizeof(buf));
+
+    uint16_t crc = buf[RADIOLIB_LORAWAN_SESSION_BUF_SIZE] | (buf[RADIOLIB_LORAWAN_SESSION_BUF_SIZE + 1] << 8);
+    if (crc != crc16(buf, RADIOLIB_LORAWAN_SESSION_BUF_SIZE))
+    {
+        log_w("Session in flash corrupted");
+        prefs.end();
+        return RADIOLIB_ERR_SESSION_DISCARDED;
+    }
+
+    // Skip all uplink frame counter values which may have been used
+    // since the session was written to flash (little endian)
+    uint8_t *fCntBuf = &buf[RADIOLIB_LORAWAN_SESSION_FCNT_UP];
+    uint32_t fCntUp = fCntBuf[0] | (fCntBuf[1] << 8) | (fCntBuf[2] << 16) | (static_cast<uint32_t>(fCntBuf[3]) << 24);
+    fCntUp = max(fCntUp + LW_SESSION_FCNT_RESERVE, prefs.getUInt("fcnt_rsv", 0));
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        fCntBuf[i] = (fCntUp >> (8 * i)) & 0xFF;
+    }
+
+    // Update RadioLib's signature of the session buffer (little endian)
+    uint16_t signature = bufferChecksum(buf, RADIOLIB_LORAWAN_SESSION_SIGNATURE);
+    buf[RADIOLIB_LORAWAN_SESSION_SIGNATURE] = signature & 0xFF;
+    buf[RADIOLIB_LORAWAN_SESSION_SIGNATURE + 1] = signature >> 8;
+
+    int16_t state = node.setBufferSession(buf);
+    if ((state == RADIOLIB_ERR_NONE) && (node.getFCntUp() + 1 != fCntUp))
+    {
+        // getFCntUp(): frame counter of last uplink
+        log_e("Restored session has unexpected FCntUp %lu", static_cast<unsigned long>(node.getFCntUp()));
+        node.clearSession();
+        state = RADIOLIB_ERR_SESSION_DISCARDED;
+    }
+    if (state != RADIOLIB_ERR_NONE)
+    {
+        prefs.end();
+        return state;
+    }
+
+    // The frame counters up to the next session write must not be used again
+    // after another power loss
+    prefs.putUInt("fcnt_rsv", fCntUp + LW_SESSION_FCNT_RESERVE);
+    countWrite(prefs, "session_wr");
+    prefs.end();
+    log_d("Session restored from flash, FCntUp advanced to %lu", static_cast<unsigned long>(fCntUp));
+
+    sessionStoreState.sessionNew = false;
+    sessionStoreState.flashFCntValid = true;
+    sessionStoreState.flashFCnt = fCntUp;
+    return RADIOLIB_ERR_NONE;
+}
+
+void SessionStore::saveSession(const uint8_t *session, uint32_t fCntUp)
+{
+    init();
+    if (!sessionStoreState.sessionNew && sessionStoreState.flashFCntValid &&
+        (fCntUp >= sessionStoreState.flashFCnt) &&
+        (fCntUp - sessionStoreState.flashFCnt < LW_SESSION_WRITE_INTERVAL))
+        return;
+
+    writeSession(session, sessionStoreState.sessionNew);
+    sessionStoreState.sessionNew = false;
+    sessionStoreState.flashFCntValid = true;
+    sessionStoreState.flashFCnt = fCntUp;
+}
+
+void SessionStore::writeSession(const uint8_t *session, bool sessionNew)
+{
+    uint8_t buf[RADIOLIB_LORAWAN_SESSION_BUF_SIZE + 2];
+    memcpy(buf, session, RADIOLIB_LORAWAN_SESSION_BUF_SIZE);
+    uint16_t crc = crc16(buf, RADIOLIB_LORAWAN_SESSION_BUF_SIZE);
+    buf[RADIOLIB_LORAWAN_SESSION_BUF_SIZE] = crc & 0xFF;
+    buf[RADIOLIB_LORAWAN_SESSION_BUF_SIZE + 1] = crc >> 8;
+
+    log_d("Saving session to flash");
+    Preferences prefs;
+    prefs.begin(SESSION_STORE_NS, false);
+    prefs.putBytes("session", buf, sizeof(buf));
+    if (sessionNew)
+    {
+        // Frame counter reserve refers to the previous session
+        prefs.remove("fcnt_rsv");
+    }
+    countWrite(prefs, "session_wr");
+    prefs.end();
+}
+
+void SessionStore::countWrite(Preferences &prefs, const char *key)
+{
+    uint32_t count = prefs.getUInt(key, 0) + 1;
+    prefs.putUInt(key, count);
+    log_d("%s: %u", key, count);
+}
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+// SessionStore.h
+//
+// Flash-wear-aware persistence of LoRaWAN nonces and session for
+// BresserWeatherSensorLW
+//
+// - Nonces and session are cached in memory which is retained during deep sleep;
+//   flash is only read after power-on/reset
+// - Nonces are written to flash only if they have changed - immediately after a
+//   successful join, otherwise after LW_NONCES_WRITE_INTERVAL failed join attempts
+// - A copy of the session with checksum is written to flash after a join and whenever
+//   the uplink frame counter has advanced by LW_SESSION_WRITE_INTERVAL; it is used
+//   if the session in retained memory was lost (power-on/reset), which avoids a rejoin
+// - On restore, the uplink frame counter is advanced beyond all values which may
+//   have been used since the copy was written (no frame counter reuse)
+// - The number of flash writes is counted for monitoring flash wear
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Session flash copy is written based on uplink frame counter,
+//          frame counter is advanced when restoring from flash
+//          Replaced loadSession() by restoreSession(), added restoreNonces()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file SessionStore.h
+ *  \brief Flash-wear-aware persistence of LoRaWAN nonces and session
+ */
+
+#if !defined(_SESSION_STORE_H)
+#define _SESSION_STORE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <RadioLib.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "logging.h"
+
+/*!
+ * \brief Flash-wear-aware persistence of LoRaWAN nonces and session
+ *
+ * Preferences namespace "radiolib":
+ *
+ * "nonces":       nonces buffer (as before)
+ * "session":      session buffer + CRC-16 (little endian)
+ * "devnonce_rsv": min. DevNonce after power loss (DevNonce reserve)
+ * "fcnt_rsv":     min. uplink frame counter of session after power loss (FCnt reserve)
+ * "nonces_wr":    number of nonces writes
+ * "session_wr":   number of session writes
+ */
+class SessionStore
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    SessionStore() {};
+
+    /*!
+     * \brief Get nonces
+     *
+     * \param nonces nonces buffer (RADIOLIB_LORAWAN_NONCES_BUF_SIZE bytes)
+     *
+     * \returns true if nonces are available
+     */
+    bool loadNonces(uint8_t *nonces);
+
+    /*!
+     * \brief Save nonces
+     *
+     * The nonces are written to flash only if they have changed; after a failed
+     * join attempt, writing is deferred until LW_NONCES_WRITE_INTERVAL attempts
+     * have failed.
+     *
+     * \param nonces nonces buffer (RADIOLIB_LORAWAN_NONCES_BUF_SIZE bytes)
+     * \param joined true if join was successful
+     */
+    void saveNonces(const uint8_t *nonces, bool joined);
+
+    /*!
+     * \brief Advance DevNonce of nonces restored from flash before joining
+     *
+     * After a failed join attempt, the nonces in flash may be outdated by up to
+     * LW_NONCES_WRITE_INTERVAL - 1 DevNonces. To prevent reuse of DevNonces (join
+     * requests would be rejected by the network server), the DevNonce is advanced
+     * by LW_NONCES_DEVNONCE_RESERVE (at least to the reserve record) and the end
+     * of the new reserve is written to flash before it is used.
+     *
+     * Only has an effect once after power-on/reset, if the nonces were restored
+     * from flash.
+     *
+     * \param node LoRaWAN node (nonces set with setBufferNonces())
+     */
+    void restoreNonces(LoRaWANNode &node);
+
+    /*!
+     * \brief Restore session from flash
+     *
+     * The session in flash may be outdated by up to LW_SESSION_WRITE_INTERVAL
+     * uplinks. To prevent reuse of frame counters (which would be rejected by
+     * the network server and would reuse the AES-CTR keystream), the uplink
+     * frame counter is advanced by LW_SESSION_FCNT_RESERVE (at least to the
+     * reserve record). The session is passed to the node with setBufferSession()
+     * and the frame counter is checked with getFCntUp(); then the end of the new
+     * reserve is written to flash.
+     *
+     * \param node LoRaWAN node (nonces set with setBufferNonces())
+     *
+     * \returns RADIOLIB_ERR_NONE if the session was restored
+     */
+    int16_t restoreSession(LoRaWANNode &node);
+
+    /*!
+     * \brief Save session
+     *
+     * The session is written to flash after a join and whenever the uplink
+     * frame counter has advanced by LW_SESSION_WRITE_INTERVAL since the last
+     * write. Should be called after each uplink.
+     *
+     * \param session session buffer (RADIOLIB_LORAWAN_SESSION_BUF_SIZE bytes)
+     * \param fCntUp  uplink frame counter (node.getFCntUp())
+     */
+    void saveSession(const uint8_t *session, uint32_t fCntUp);
+
+private:
+    /*!
+     * \brief Initialize retained state after power-on/reset
+     */
+    void init(void);
+
+    /*!
+     * \brief Write session with CRC-16 to flash
+     *
+     * \param session    session buffer (RADIOLIB_LORAWAN_SESSION_BUF_SIZE bytes)
+     * \param sessionNew true if new session (removes frame counter reserve)
+     */
+    void writeSession(const uint8_t *session, bool sessionNew);
+
+    /*!
+     * \brief Increment flash write counter
+     *
+     * \param prefs Preferences object (opened)
+     * \param key   counter key
+     */
+    void countWrite(Preferences &prefs, const char *key);
+};
+
+#endif // _SESSION_STORE_H
@@ -51,6 +51,14 @@
 // 20251031 Added M5Stack configuration for power saving
 //          Added M5Stack RTC integration
 // 20260304 Added gpsPower() and getGPSData() for GPS time sync
+// 20261016 Replaced Preferences by RAM-cached configuration image (cfgImage)
+//          sleepAfterFailedJoin(): Sleep duration provided by JoinBackoff
+//          Added RTC drift estimation (RTC_DRIFT_ESTIMATION)
+//          getGPSData(): Replaced busy polling by waiting for UART receive events,
+//          light sleep between NMEA bursts (GPS_LIGHT_SLEEP)
+//          Added GPS time-to-first-fix statistics and GPS backup power (hot start)
+//          getGPSData(): Added lightSleepAllowed callback
+//          getGPSData(): Light sleep wake-up is based on the start of the NMEA burst
 //
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -66,7 +74,6 @@
 #include "SystemContext.h"
 #include <Arduino.h>
 #include <time.h>
-#include <Preferences.h>
 #include "../BresserWeatherSensorLWCfg.h"
 #include "LoadNodeCfg.h"
 #include "adc/adc.h"
@@ -92,10 +99,24 @@ using namespace PowerFeather;
 #if defined(GPS_EN)
 #include <TinyGPSPlus.h>
 TinyGPSPlus gps;
+
+/// Marker for valid GPS statistics
+#define GPS_STATS_MAGIC 0x47505353UL
+
+#if defined(ESP32)
+#include <driver/gpio.h>
+
+/// NMEA burst received (UART receive timeout)
+static SemaphoreHandle_t gpsRxSem = nullptr;
+
+/// UART receive callback - called from UART event task at end of NMEA burst
+static void gpsOnReceive(void)
+{
+  xSemaphoreGive(gpsRxSem);
+}
+#endif
 #endif
 
-/// Preferences (stored in flash memory)
-Preferences preferences;
 
 #if defined(EXT_RTC)
 // Create an instance of the external RTC class
@@ -129,6 +150,14 @@ E_TIME_SOURCE rtcTimeSource __attribute__((section(".uninitialized_data"))); //<
 bool longSleepModeActive __attribute__((section(".uninitialized_data"))); //<! Long sleep mode active flag
 #endif
 
+#if defined(GPS_EN)
+#if defined(ESP32)
+RTC_DATA_ATTR struct sGpsStats gpsStats = {0}; //!< GPS time-to-first-fix statistics
+#else
+struct sGpsStats gpsStats __attribute__((section(".uninitialized_data"))); //!< GPS time-to-first-fix statistics
+#endif
+#endif
+
 void SystemContext::begin(void)
 {
 #if defined(ARDUINO_ARCH_RP2040)
@@ -167,17 +196,20 @@ void SystemContext::begin(void)
   }
   bootCount++;
 
+#if defined(RTC_DRIFT_ESTIMATION)
+  // Correct the RTC by the estimated drift since the last wake cycle
+  rtcDrift.correct();
+#endif
+
 #if defined(EXT_RTC) || defined(ARDUINO_M5STACK_CORE2)
   if (rtcNeedsSync())
   {
     getTimeFromExtRTC();
   }
 #endif
-  preferences.begin("BWS-LW", false);
-  sleep_interval = preferences.getUShort("sleep_int", SLEEP_INTERVAL);
-  sleep_interval_long = preferences.getUShort("sleep_int_long", SLEEP_INTERVAL_LONG);
-  lw_stat_interval = preferences.getUChar("lw_stat_int", LW_STATUS_INTERVAL);
-  preferences.end();
+  sleep_interval = cfgImage.getUShort(E_CFG_ITEM::E_SLEEP_INT);
+  sleep_interval_long = cfgImage.getUShort(E_CFG_ITEM::E_SLEEP_INT_LONG);
+  lw_stat_interval = cfgImage.getUChar(E_CFG_ITEM::E_LW_STAT_INT);
 }
 
 bool SystemContext::isFirstBoot(void)
@@ -190,13 +222,11 @@ void SystemContext::resetFailedJoinCount(void)
   bootCountSinceUnsuccessfulJoin = 0;
 }
 
-void SystemContext::sleepAfterFailedJoin(void)
+void SystemContext::sleepAfterFailedJoin(uint32_t sleepForSeconds)
 {
-  // how long to wait before join attempts. This is an interim solution pending
-  // implementation of TS001 LoRaWAN Specification section #7 - this doc applies to v1.0.4 & v1.1
-  // it sleeps for longer & longer durations to give time for any gateway issues to resolve
-  // or whatever is interfering with the device <-> gateway airwaves.
-  uint32_t sleepForSeconds = min((bootCountSinceUnsuccessfulJoin++ + 1UL) * 60UL, 3UL * 60UL);
+  // the sleep duration is provided by JoinBackoff (jittered exponential backoff,
+  // join airtime limited according to TS001 LoRaWAN Specification section #7)
+  bootCountSinceUnsuccessfulJoin++;
   log_i("Boots since unsuccessful join: %u", bootCountSinceUnsuccessfulJoin);
   log_i("Retrying join in %u seconds", sleepForSeconds);
 
@@ -204,26 +234,31 @@ void SystemContext::sleepAfterFailedJoin(void)
 }
 
 // Set RTC from epoch and store source & sync timestamp
-void SystemContext::setTime(time_t epoch, E_TIME_SOURCE source)
+void SystemContext::setTime(time_t epoch, E_TIME_SOURCE source, uint16_t ms)
 {
-  timeval epoch_tv = {epoch, 0};
+#if defined(RTC_DRIFT_ESTIMATION)
+  // Only GPS and LoRaWAN network time are accurate enough for drift estimation
+  bool accurate = ((rtcTimeSource == E_TIME_SOURCE::E_GPS) || (rtcTimeSource == E_TIME_SOURCE::E_LORA)) &&
+                  ((source == E_TIME_SOURCE::E_GPS) || (source == E_TIME_SOURCE::E_LORA));
+  rtcDrift.sync(epoch, ms, rtcLastClockSync, accurate);
+#endif
+
+  timeval epoch_tv = {epoch, static_cast<suseconds_t>(ms * 1000)};
   const timeval *tv = &epoch_tv;
-  timezone utc = {0, 0};
-  const timezone *tz = &utc;
+  struct timezone utc = {0, 0};
+  const struct timezone *tz = &utc;
   settimeofday(tv, tz);
 
   rtcTimeSource = source;
   rtcLastClockSync = epoch;
 }
 
-// Save preferences to flash memory
+// Save preferences to configuration image (written to flash memory before sleep)
 void SystemContext::savePreferences(void)
 {
-  preferences.begin("BWS-LW", false);
-  preferences.putUShort("sleep_int", sleep_interval);
-  preferences.putUShort("sleep_int_long", sleep_interval_long);
-  preferences.putUChar("lw_stat_int", lw_stat_interval);
-  preferences.end();
+  cfgImage.putUShort(E_CFG_ITEM::E_SLEEP_INT, sleep_interval);
+  cfgImage.putUShort(E_CFG_ITEM::E_SLEEP_INT_LONG, sleep_interval_long);
+  cfgImage.putUChar(E_CFG_ITEM::E_LW_STAT_INT, lw_stat_interval);
 }
 
 #if defined(ARDUINO_ESP32S3_POWERFEATHER)
@@ -332,6 +367,9 @@ void SystemContext::getTimeFromExtRTC(void)
     syncRTCWithExtRTC();
     rtcLastClockSync = time(nullptr);
     rtcTimeSource = E_TIME_SOURCE::E_RTC;
+#if defined(RTC_DRIFT_ESTIMATION)
+    rtcDrift.restart();
+#endif
     log_i("Set time and date from external RTC");
   }
 }
@@ -376,6 +414,9 @@ void SystemContext::getTimeFromExtRTC(void)
     syncRTCWithExtRTC();
     rtcLastClockSync = time(nullptr);
     rtcTimeSource = E_TIME_SOURCE::E_RTC;
+#if defined(RTC_DRIFT_ESTIMATION)
+    rtcDrift.restart();
+#endif
     log_i("Set time and date from RTC IC");
   }
 }
@@ -397,20 +438,99 @@ E_TIME_SOURCE SystemContext::getRtcTimeSource(void)
 bool SystemContext::rtcNeedsSync(void)
 {
   // Check if the RTC is not synchronized to a time source
-  // or the last clock sync is older than CLOCK_SYNC_INTERVAL
-  return (rtcTimeSource == E_TIME_SOURCE::E_UNSYNCHED) ||
-         ((time(nullptr) - rtcLastClockSync) > (CLOCK_SYNC_INTERVAL * 60));
+  if (rtcTimeSource == E_TIME_SOURCE::E_UNSYNCHED)
+    return true;
+
+  time_t elapsed = time(nullptr) - rtcLastClockSync;
+#if defined(RTC_DRIFT_ESTIMATION)
+  // Check if the predicted clock error exceeds RTC_SYNC_MAX_ERROR
+  // or the last clock sync is older than CLOCK_SYNC_INTERVAL_MAX
+  if (rtcDrift.valid())
+  {
+    return (elapsed > (CLOCK_SYNC_INTERVAL_MAX * 60)) ||
+           (rtcDrift.predictedError(elapsed) > RTC_SYNC_MAX_ERROR);
+  }
+#endif
+  // Check if the last clock sync is older than CLOCK_SYNC_INTERVAL
+  return elapsed > (CLOCK_SYNC_INTERVAL * 60);
 }
 
 #if defined(GPS_EN)
-bool SystemContext::getGPSData(time_t &gpsTime)
+// Control the GPS power (and GPS backup power)
+void SystemContext::gpsPower(bool on)
+{
+  if (on)
+  {
+    gpsPowerOnMs = millis();
+  }
+
+#if defined(ESP32)
+  if (GPS_BACKUP_PIN >= 0)
+  {
+    // Backup power stays on - also during deep sleep
+    gpio_hold_dis(static_cast<gpio_num_t>(GPS_BACKUP_PIN));
+    pinMode(GPS_BACKUP_PIN, OUTPUT);
+    digitalWrite(GPS_BACKUP_PIN, GPS_BACKUP_ACTIVE ? HIGH : LOW);
+    if (!on)
+    {
+      gpio_hold_en(static_cast<gpio_num_t>(GPS_BACKUP_PIN));
+      gpio_deep_sleep_hold_en();
+    }
+  }
+#endif
+
+  if (GPS_PWR_EN_PIN < 0)
+  {
+    return; // GPS power control not available
+  }
+  if (GPS_PWR_EN_ACTIVE)
+  {
+    pinMode(GPS_PWR_EN_PIN, OUTPUT);
+    digitalWrite(GPS_PWR_EN_PIN, on ? HIGH : LOW);
+  }
+  else
+  {
+    pinMode(GPS_PWR_EN_PIN, OUTPUT);
+    digitalWrite(GPS_PWR_EN_PIN, on ? LOW : HIGH);
+  }
+}
+
+// Get GPS time-to-first-fix statistics
+const struct sGpsStats &SystemContext::getGpsStats(void)
+{
+  if (gpsStats.magic != GPS_STATS_MAGIC)
+  {
+    // Uninitialized after power-on/HW reset
+    memset(&gpsStats, 0, sizeof(gpsStats));
+    gpsStats.magic = GPS_STATS_MAGIC;
+  }
+  return gpsStats;
+}
+
+bool SystemContext::getGPSData(time_t &gpsTime, bool (*lightSleepAllowed)(void))
 {
   gpsTime = 0;
+  getGpsStats();
+  gpsStats.attempts++;
 
   log_d("Getting GPS data for RTC sync...");
+#if defined(ESP32)
+  // Buffer for a complete NMEA burst; a callback signals the end of each burst
+  // (UART receive timeout), so the CPU can idle instead of busy polling
+  if (!gpsRxSem)
+  {
+    gpsRxSem = xSemaphoreCreateBinary();
+  }
+  xSemaphoreTake(gpsRxSem, 0);
+  Serial2.setRxBufferSize(GPS_RX_BUFFER_SIZE);
+  Serial2.onReceive(gpsOnReceive, true);
+#endif
   Serial2.begin(GPS_BAUDRATE, SERIAL_8N1, GPS_RX_PIN /* RX */, -1 /* TX */);
 
   unsigned long start = millis();
+#if defined(ESP32) && defined(GPS_LIGHT_SLEEP)
+  unsigned long lastBurst = 0; // start of last NMEA burst
+#endif
   bool timeout = false;
   
   // CAUTION:
@@ -421,26 +541,77 @@ bool SystemContext::getGPSData(time_t &gpsTime)
   // see https://github.com/mikalhart/TinyGPSPlus/issues/107
   while (!(gps.time.isValid() && gps.date.isValid() && gps.date.day() != 0 && gps.date.month() != 0))
   {
+#if defined(ESP32)
+    // Wait for end of NMEA burst
+    bool burst = xSemaphoreTake(gpsRxSem, pdMS_TO_TICKS(GPS_NMEA_PERIOD_MS)) == pdTRUE;
+    (void)burst;
+#if defined(GPS_LIGHT_SLEEP)
+    // Start of NMEA burst: end of burst minus its transfer time (8N1: 10 bits per byte)
+    unsigned long burstStart = millis() - (Serial2.available() * 10000UL) / GPS_BAUDRATE;
+#endif
+#else
+    delay(10);
+#endif
     while (Serial2.available() > 0)
       gps.encode(Serial2.read());
+    if (gps.time.isValid() && gps.date.isValid() && gps.date.day() != 0 && gps.date.month() != 0)
+      break;
+
     if (millis() - start > GPS_TIMEOUT_SEC * 1000UL)
     {
       log_w("Timeout waiting for GPS data");
       timeout = true;
       break;
     }
+
+#if defined(ESP32) && defined(GPS_LIGHT_SLEEP)
+    if (burst && (!lightSleepAllowed || lightSleepAllowed()))
+    {
+      // Light sleep until GPS_WAKE_MARGIN_MS before the start of the next NMEA burst
+      // (UART data received during light sleep would be lost); the sleep time is
+      // counted from the start of the current burst, not from its end - otherwise
+      // the MCU would wake up after the next burst has started if the burst's
+      // transfer time exceeds GPS_WAKE_MARGIN_MS
+      unsigned long period = burstStart - lastBurst;
+      unsigned long elapsed = millis() - burstStart;
+      if ((lastBurst != 0) && (period <= 2 * GPS_NMEA_PERIOD_MS) && (period > elapsed + GPS_WAKE_MARGIN_MS))
+      {
+        Serial.flush();
+        esp_sleep_enable_timer_wakeup((period - elapsed - GPS_WAKE_MARGIN_MS) * 1000ULL);
+        esp_light_sleep_start();
+      }
+      lastBurst = burstStart;
+    }
+#endif
   }
 
+#if defined(ESP32)
+  Serial2.onReceive(NULL);
+#endif
 #if defined(SERIAL2_LOG_ENABLE)
   Serial2.begin(115200, SERIAL_8N1, SERIAL2_LOG_TX_PIN, SERIAL2_LOG_RX_PIN);
   Serial2.setDebugOutput(true);
+#else
+  Serial2.end();
 #endif // SERIAL2_LOG_ENABLE
 
   if (timeout)
   {
+    log_i("GPS: %u of %u attempts successful", gpsStats.fixes, gpsStats.attempts);
     return false;
   }
 
+  // Time-to-first-fix (since GPS power-on)
+  uint32_t ttff = millis() - gpsPowerOnMs;
+  gpsStats.lastHotStart = gpsStats.backupValid;
+  gpsStats.backupValid = (GPS_BACKUP_PIN >= 0);
+  gpsStats.lastTtffMs = ttff;
+  gpsStats.minTtffMs = (gpsStats.fixes == 0) ? ttff : min(gpsStats.minTtffMs, ttff);
+  gpsStats.maxTtffMs = max(gpsStats.maxTtffMs, ttff);
+  gpsStats.fixes++;
+  log_i("GPS: TTFF %u ms (%s start), %u of %u attempts successful", ttff,
+        gpsStats.lastHotStart ? "hot" : "cold", gpsStats.fixes, gpsStats.attempts);
+
   struct tm timeinfo;
   log_i("GPS time: %04u-%02u-%02u %02u:%02u:%02u",
         gps.date.year(), gps.date.month(), gps.date.day(),
@@ -466,7 +637,7 @@ bool SystemContext::getGPSData(time_t &gpsTime)
 void SystemContext::gotoSleepESP32(uint32_t seconds)
 {
   esp_sleep_enable_timer_wakeup(seconds * 1000UL * 1000UL); // function uses uS
-  log_i("Sleeping for %lu s", seconds);
+  log_i("Sleeping for %lu s", static_cast<unsigned long>(seconds));
   Serial.flush();
 
   esp_deep_sleep_start();
@@ -47,6 +47,14 @@
 // 20251031 Added M5Stack configuration for power saving
 //          Added M5Stack RTC integration
 // 20260304 Added gpsPower() and getGPSData() for GPS time sync
+// 20261016 sleepDuration(): Added alignment to sensor transmit schedule
+//          Replaced Preferences by RAM-cached configuration image (cfgImage)
+//          sleepAfterFailedJoin(): Added parameter sleepForSeconds
+//          Added RTC drift estimation (RTC_DRIFT_ESTIMATION)
+//          gpsPower(): Added GPS backup power (hot start), moved to SystemContext.cpp
+//          Added getGpsStats()
+//          gotoSleep(): Commit wake cycle trace and energy account (setAccounting())
+//          getGPSData(): Added lightSleepAllowed callback
 //
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -62,9 +70,13 @@
 
 #include <Arduino.h>
 #include <time.h>
-#include <Preferences.h>
+#include "ConfigImage.h"
+#include "EnergyAccount.h"
+#include "RtcDrift.h"
 #include "../BresserWeatherSensorLWCfg.h"
 #include "LoadNodeCfg.h"
+#include "SensorSchedule.h"
+#include "WakeTrace.h"
 #include "adc/adc.h"
 #include "logging.h"
 #if defined(ARDUINO_ESP32S3_POWERFEATHER)
@@ -84,6 +96,21 @@ using namespace PowerFeather;
 #include <RTClib.h>
 #endif
 
+#if defined(GPS_EN)
+/// GPS time-to-first-fix statistics (retained during deep sleep)
+struct sGpsStats
+{
+    uint32_t magic;       //!< GPS_STATS_MAGIC if valid
+    uint16_t attempts;    //!< number of GPS data acquisitions
+    uint16_t fixes;       //!< number of successful GPS data acquisitions
+    uint32_t lastTtffMs;  //!< time-to-first-fix of last successful acquisition in ms
+    uint32_t minTtffMs;   //!< min. time-to-first-fix in ms
+    uint32_t maxTtffMs;   //!< max. time-to-first-fix in ms
+    bool lastHotStart;    //!< last successful acquisition with backup power retained
+    bool backupValid;     //!< GPS backup power retained since last fix
+};
+#endif
+
 /*!
  * \brief System context for BresserWeatherSensorLW
  *
@@ -107,12 +134,27 @@ public:
      * Initialize the system context
      * - MCU / board specific initialization
      * - Load node configuration from JSON file
-     * - Load preferences from flash memory
+     * - Load preferences from configuration image
      * - Initialize RTC and time zone
      *
      */
     void begin(void);
 
+    /**
+     * \brief Set wake cycle trace and energy accounting
+     *
+     * Both are committed by gotoSleep(), i.e. on every path into sleep mode -
+     * including aborted cycles (failed join, low battery).
+     *
+     * \param trace   wake cycle timing trace
+     * \param account energy accounting
+     */
+    void setAccounting(WakeTrace *trace, EnergyAccount *account)
+    {
+        wakeTrace = trace;
+        energyAccount = account;
+    };
+
     /**
      * \brief Check if this is the first boot of the system after power-on/HW reset
      *
@@ -131,20 +173,25 @@ public:
     /**
      * \brief Sleep after a failed join attempt.
      *
-     * The sleep duration after a failed join is determined by the
-     * failed join count.
+     * The sleep duration after a failed join is determined by JoinBackoff.
+     *
+     * \param sleepForSeconds sleep duration in seconds
      */
-    void sleepAfterFailedJoin(void);
+    void sleepAfterFailedJoin(uint32_t sleepForSeconds);
 
     /**
      * \brief Set RTC to epoch
      *
      * Set RTC to epoch and store source and RTC sync timestamp
      *
+     * With RTC_DRIFT_ESTIMATION, the RTC drift estimate is updated
+     * if both the previous and the current time source are GPS or LoRaWAN.
+     *
      * \param epoch     time in seconds since epoch
      * \param source    time source
+     * \param ms        milliseconds (fraction of epoch)
      */
-    void setTime(time_t epoch, E_TIME_SOURCE source);
+    void setTime(time_t epoch, E_TIME_SOURCE source, uint16_t ms = 0);
 
     /**
      * Print date and time (i.e. local time)
@@ -161,7 +208,9 @@ public:
     };
 
     /**
-     * \brief Save preferences to flash memory
+     * \brief Save preferences to configuration image
+     *
+     * The configuration image is written to flash memory before entering sleep mode.
      */
     void savePreferences(void);
 
@@ -329,25 +378,21 @@ public:
     /**
      * @brief Control the GPS power
      * 
+     * If GPS_BACKUP_PIN is available, the GPS backup power is kept on
+     * after the GPS has been turned off (also during deep sleep).
+     * 
      * @param on true to turn on the GPS, false to turn off the GPS
      */
-    void gpsPower(bool on)
-    {
-        if (GPS_PWR_EN_PIN < 0)
-        {
-            return; // GPS power control not available
-        }
-        if (GPS_PWR_EN_ACTIVE)
-        {
-            pinMode(GPS_PWR_EN_PIN, OUTPUT);
-            digitalWrite(GPS_PWR_EN_PIN, on ? HIGH : LOW);
-        }
-        else
-        {
-            pinMode(GPS_PWR_EN_PIN, OUTPUT);
-            digitalWrite(GPS_PWR_EN_PIN, on ? LOW : HIGH);
-        }
-    };
+    void gpsPower(bool on);
+
+    /**
+     * @brief Get GPS time-to-first-fix statistics
+     * 
+     * The statistics are retained during deep sleep.
+     * 
+     * @return GPS statistics
+     */
+    const struct sGpsStats &getGpsStats(void);
 #endif // GPS_EN
 
 #if defined(ARDUINO_ESP32S3_POWERFEATHER)
@@ -469,6 +514,10 @@ public:
      * If the RTC is not synchronized or if the last clock sync is older than
      * CLOCK_SYNC_INTERVAL, it returns true.
      *
+     * With RTC_DRIFT_ESTIMATION and a valid drift estimate, it returns true
+     * if the predicted clock error exceeds RTC_SYNC_MAX_ERROR or if the last
+     * clock sync is older than CLOCK_SYNC_INTERVAL_MAX instead.
+     *
      * \return true     if the RTC needs to be synchronized
      * \return false    if the RTC is synchronized and the last clock sync is within CLOCK_SYNC_INTERVAL
      */
@@ -478,10 +527,16 @@ public:
     /**
      * \brief Get GPS data
      *
+     * With GPS_LIGHT_SLEEP, the MCU enters light sleep between NMEA bursts
+     * only while lightSleepAllowed() returns true (or if it is nullptr).
+     * Light sleep would stall tasks running concurrently on the other core,
+     * e.g. the BLE scan task.
+     *
      * \param gpsTime Reference to store the GPS time
+     * \param lightSleepAllowed Callback to check if light sleep is permitted (optional)
      * \return true if GPS data is valid, false otherwise
      */
-    bool getGPSData(time_t &gpsTime);
+    bool getGPSData(time_t &gpsTime, bool (*lightSleepAllowed)(void) = nullptr);
 #endif
 
     /**
@@ -497,9 +552,17 @@ public:
      * default value to achieve a wake-up time aligned to
      * an integer multiple of the interval after a full hour.
      *
+     * If a sensor schedule is provided, the wake-up time is
+     * moved to just before the next expected sensor transmission.
+     *
+     * With RTC_DRIFT_ESTIMATION, the sleep duration is corrected
+     * by the estimated drift of the sleep clock.
+     *
+     * \param schedule sensor transmit schedule (optional)
+     *
      * \return sleep duration in seconds
      */
-    uint32_t sleepDuration(void)
+    uint32_t sleepDuration(SensorSchedule *schedule = nullptr)
     {
         uint32_t sleep_interval = sleepInterval();
 
@@ -514,6 +577,15 @@ public:
             sleep_interval = sleep_interval - ((timeinfo.tm_min * 60) % sleep_interval + timeinfo.tm_sec);
         }
 
+        if (schedule)
+        {
+            sleep_interval = schedule->alignWakeup(sleep_interval);
+        }
+
+#if defined(RTC_DRIFT_ESTIMATION)
+        sleep_interval = rtcDrift.localDuration(sleep_interval);
+#endif
+
         sleep_interval = max(sleep_interval, static_cast<uint32_t>(SLEEP_INTERVAL_MIN));
         return sleep_interval;
     };
@@ -549,6 +621,20 @@ public:
      */
     void gotoSleep(uint32_t seconds)
     {
+        // Record wake cycle and account for its charge
+        // (a suspended cycle is continued after wake-up)
+        if (wakeTrace && !wakeTrace->isSuspended())
+        {
+            wakeTrace->commit();
+            if (energyAccount)
+            {
+                energyAccount->commit(*wakeTrace, seconds);
+            }
+        }
+
+        // Write modified settings to flash memory
+        cfgImage.commit();
+
 #if defined(ARDUINO_ARCH_RP2040)
         gotoSleepRP2040(seconds);
 #elif defined(ESP32)
@@ -561,6 +647,25 @@ public:
 #endif
 
 private:
+    /// Configuration image (cached Preferences)
+    ConfigImage cfgImage;
+
+    /// Wake cycle timing trace (committed before sleep)
+    WakeTrace *wakeTrace = nullptr;
+
+    /// Energy accounting (committed before sleep)
+    EnergyAccount *energyAccount = nullptr;
+
+#if defined(RTC_DRIFT_ESTIMATION)
+    /// RTC drift estimation
+    RtcDrift rtcDrift;
+#endif
+
+#if defined(GPS_EN)
+    /// Time of last GPS power-on (millis())
+    uint32_t gpsPowerOnMs = 0;
+#endif
+
 #if defined(EXT_RTC)
     /**
      * \brief Get the Time from external RTC
@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+// WakeTrace.cpp
+//
+// Wake cycle timing trace for BresserWeatherSensorLW
+//
+// - Measures the duration of each stage of the wake cycle in setup()
+// - Keeps the durations of the last WAKE_TRACE_CYCLES cycles in memory
+//   which is retained during deep sleep
+// - Provides min/avg/max statistics per stage for a LoRaWAN uplink
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added suspend() and resume() (deep sleep between uplinks of a wake cycle)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file WakeTrace.cpp
+ *  \brief Wake cycle timing trace for BresserWeatherSensorLW
+ */
+
+#include "WakeTrace.h"
+
+/// Marker for valid retained ring buffer
+#define WAKE_TRACE_MAGIC 0x57414B45UL
+
+/// Ring buffer of recorded wake cycles
+struct sWakeTraceRing
+{
+    uint32_t magic;                                        //!< WAKE_TRACE_MAGIC if valid
+    uint8_t head;                                          //!< index of next record to be written
+    uint8_t count;                                         //!< number of valid records
+    WakeTrace::sWakeTraceRec rec[WAKE_TRACE_CYCLES];       //!< wake cycle records
+    bool suspendedValid;                                   //!< suspended wake cycle available
+    WakeTrace::sWakeTraceRec suspended;                    //!< suspended wake cycle
+};
+
+// Variables which must retain their values after deep sleep
+#if defined(ESP32)
+// Stored in RTC RAM
+RTC_DATA_ATTR struct sWakeTraceRing wakeTraceRing = {0}; //!< wake cycle trace ring buffer
+#else
+/// RP2040 RAM is preserved during sleep; we just have to ensure that it is not initialized at startup (after reset)
+struct sWakeTraceRing wakeTraceRing __attribute__((section(".uninitialized_data"))); //!< wake cycle trace ring buffer
+#endif
+
+void WakeTrace::begin(void)
+{
+    // Uninitialized or corrupted after power-on/HW reset
+    if ((wakeTraceRing.magic != WAKE_TRACE_MAGIC) ||
+        (wakeTraceRing.head >= WAKE_TRACE_CYCLES) ||
+        (wakeTraceRing.count > WAKE_TRACE_CYCLES))
+    {
+        log_d("Wake trace reset");
+        memset(&wakeTraceRing, 0, sizeof(wakeTraceRing));
+        wakeTraceRing.magic = WAKE_TRACE_MAGIC;
+    }
+
+    current = {};
+    current.duration_ms[static_cast<uint8_t>(E_WAKE_STAGE::E_BOOT)] = millis();
+    current.stages = 1 << static_cast<uint8_t>(E_WAKE_STAGE::E_BOOT);
+}
+
+void WakeTrace::start(E_WAKE_STAGE stage)
+{
+    startMs[static_cast<uint8_t>(stage)] = millis();
+}
+
+void WakeTrace::stop(E_WAKE_STAGE stage)
+{
+    uint8_t idx = static_cast<uint8_t>(stage);
+
+    current.duration_ms[idx] += millis() - startMs[idx];
+    current.stages |= 1 << idx;
+}
+
+void WakeTrace::suspend(void)
+{
+    uint8_t idx = static_cast<uint8_t>(E_WAKE_STAGE::E_TOTAL);
+
+    current.duration_ms[idx] = totalBaseMs + millis();
+    current.stages |= 1 << idx;
+
+    wakeTraceRing.suspended = current;
+    wakeTraceRing.suspendedValid = true;
+    suspended = true;
+    log_d("Wake cycle suspended");
+}
+
+bool WakeTrace::resume(void)
+{
+    if (!wakeTraceRing.suspendedValid)
+    {
+        return false;
+    }
+
+    const sWakeTraceRec &prev = wakeTraceRing.suspended;
+    for (uint8_t i = 0; i < WAKE_TRACE_STAGES; i++)
+    {
+        if (i != static_cast<uint8_t>(E_WAKE_STAGE::E_TOTAL))
+        {
+            current.duration_ms[i] += prev.duration_ms[i];
+        }
+    }
+    current.stages |= prev.stages;
+    totalBaseMs = prev.duration_ms[static_cast<uint8_t>(E_WAKE_STAGE::E_TOTAL)];
+    wakeTraceRing.suspendedValid = false;
+    log_d("Wake cycle resumed");
+    return true;
+}
+
+void WakeTrace::commit(void)
+{
+    uint8_t idx = static_cast<uint8_t>(E_WAKE_STAGE::E_TOTAL);
+
+    current.duration_ms[idx] = totalBaseMs + millis();
+    current.stages |= 1 << idx;
+    wakeTraceRing.suspendedValid = false;
+
+    for (uint8_t i = 0; i < WAKE_TRACE_STAGES; i++)
+    {
+        if (current.stages & (1 << i))
+        {
+            log_d("Stage %2u: %6lu ms", i, static_cast<unsigned long>(current.duration_ms[i]));
+        }
+    }
+
+    wakeTraceRing.rec[wakeTraceRing.head] = current;
+    wakeTraceRing.head = (wakeTraceRing.head + 1) % WAKE_TRACE_CYCLES;
+    if (wakeTraceRing.count < WAKE_TRACE_CYCLES)
+    {
+        wakeTraceRing.count++;
+    }
+}
+
+bool WakeTrace::selectStats(uint8_t stage)
+{
+    if (stage >= WAKE_TRACE_STAGES)
+    {
+        return false;
+    }
+    firstStage = stage;
+    return true;
+}
+
+void WakeTrace::encodeStats(LoraEncoder &encoder)
+{
+    uint8_t lastStage = min(firstStage + WAKE_TRACE_STAGES_PER_UPLINK, WAKE_TRACE_STAGES);
+
+    encoder.writeUint8(wakeTraceRing.count);
+    encoder.writeUint8(firstStage);
+
+    for (uint8_t stage = firstStage; stage < lastStage; stage++)
+    {
+        uint32_t minMs = UINT32_MAX;
+        uint32_t maxMs = 0;
+        uint32_t sumMs = 0;
+        uint8_t n = 0;
+
+        // Only cycles in which the stage was executed are taken into account
+        for (uint8_t i = 0; i < wakeTraceRing.count; i++)
+        {
+            const sWakeTraceRec &rec = wakeTraceRing.rec[i];
+            if (!(rec.stages & (1 << stage)))
+            {
+                continue;
+            }
+            minMs = min(minMs, rec.duration_ms[stage]);
+            maxMs = max(maxMs, rec.duration_ms[stage]);
+            sumMs += rec.duration_ms[stage];
+            n++;
+        }
+
+        if (n == 0)
+        {
+            encoder.writeUint16(INV_UINT16);
+            encoder.writeUint16(INV_UINT16);
+            encoder.writeUint16(INV_UINT16);
+        }
+        else
+        {
+            encoder.writeUint16(toUplink(minMs));
+            encoder.writeUint16(toUplink(sumMs / n));
+            encoder.writeUint16(toUplink(maxMs));
+        }
+    }
+}
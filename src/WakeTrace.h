@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////
+// WakeTrace.h
+//
+// Wake cycle timing trace for BresserWeatherSensorLW
+//
+// - Measures the duration of each stage of the wake cycle in setup()
+// - Keeps the durations of the last WAKE_TRACE_CYCLES cycles in memory
+//   which is retained during deep sleep
+// - Provides min/avg/max statistics per stage for a LoRaWAN uplink
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Aborted cycles are recorded as well
+//          Added suspend() and resume() (deep sleep between uplinks of a wake cycle)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*! \file WakeTrace.h
+ *  \brief Wake cycle timing trace for BresserWeatherSensorLW
+ */
+
+#if !defined(_WAKE_TRACE_H)
+#define _WAKE_TRACE_H
+
+#include <Arduino.h>
+#include <LoraEncoder.h>
+#include "../BresserWeatherSensorLWCfg.h"
+#include "logging.h"
+
+/// Wake cycle stages
+enum class E_WAKE_STAGE : uint8_t
+{
+    E_BOOT = 0,         //!< Reset until start of setup()
+    E_SYSCTX = 1,       //!< sysCtx.begin()
+    E_SECRETS = 2,      //!< loadSecrets()
+    E_APPLAYER = 3,     //!< appLayer.begin() (868 MHz sensor reception)
+    E_GPS = 4,          //!< GPS time synchronization
+    E_PAYLOAD = 5,      //!< appLayer.getPayloadStage1() (1-Wire/analog/digital/BLE)
+    E_RADIO = 6,        //!< radio.begin() and radio configuration
+    E_ACTIVATE = 7,     //!< lwActivate()
+    E_UPLINK = 8,       //!< node.sendReceive() (sum of all uplinks)
+    E_UPLINK_DELAY = 9, //!< sysCtx.uplinkDelay() (sum of all delays)
+    E_TOTAL = 10        //!< Reset until sleep
+};
+
+/// Number of wake cycle stages
+#define WAKE_TRACE_STAGES 11
+
+/// Max. number of stages per response uplink
+#define WAKE_TRACE_STAGES_PER_UPLINK 8
+
+/// Timing resolution of response uplink in ms
+#define WAKE_TRACE_RESOLUTION_MS 10
+
+/*!
+ * \brief Wake cycle timing trace
+ *
+ * The durations of all stages of the current wake cycle are collected in RAM
+ * and appended to a ring buffer in retained memory by commit() just before
+ * the MCU enters deep sleep (see SystemContext::gotoSleep()). Cycles which
+ * are aborted (e.g. failed join, low battery) are recorded as well.
+ */
+class WakeTrace
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    WakeTrace() {};
+
+    /*!
+     * \brief Start tracing of the current wake cycle
+     *
+     * Validates the retained ring buffer and records the boot stage.
+     * Must be called at the very beginning of setup().
+     */
+    void begin(void);
+
+    /*!
+     * \brief Start measurement of a stage
+     *
+     * \param stage wake cycle stage
+     */
+    void start(E_WAKE_STAGE stage);
+
+    /*!
+     * \brief Stop measurement of a stage
+     *
+     * The elapsed time is added to the stage's duration, so a stage may
+     * be measured several times per cycle (e.g. several uplinks).
+     *
+     * \param stage wake cycle stage
+     */
+    void stop(E_WAKE_STAGE stage);
+
+    /*!
+     * \brief Get duration of a stage in the current wake cycle
+     *
+     * \param stage wake cycle stage
+     *
+     * \returns duration in ms
+     */
+    uint32_t duration(E_WAKE_STAGE stage)
+    {
+        return current.duration_ms[static_cast<uint8_t>(stage)];
+    };
+
+    /*!
+     * \brief Append the current wake cycle to the retained ring buffer
+     *
+     * Must be called immediately before entering sleep mode.
+     */
+    void commit(void);
+
+    /*!
+     * \brief Suspend the current wake cycle
+     *
+     * The current wake cycle is saved to retained memory instead of being
+     * committed. Used if the MCU enters deep sleep between the uplinks of
+     * a wake cycle; the cycle is continued after wake-up by resume().
+     */
+    void suspend(void);
+
+    /*!
+     * \brief Continue the wake cycle suspended before deep sleep
+     *
+     * The stage durations of the suspended part are added to the current
+     * wake cycle, i.e. both parts are committed as one wake cycle.
+     *
+     * \returns true if a suspended wake cycle was available
+     */
+    bool resume(void);
+
+    /*!
+     * \brief Check if the current wake cycle has been suspended
+     *
+     * \returns true if suspended, i.e. it must not be committed
+     */
+    bool isSuspended(void)
+    {
+        return suspended;
+    };
+
+    /*!
+     * \brief Select the first stage to be reported by encodeStats()
+     *
+     * \param stage first stage (0...WAKE_TRACE_STAGES-1)
+     *
+     * \returns true if stage is valid, false otherwise
+     */
+    bool selectStats(uint8_t stage);
+
+    /*!
+     * \brief Encode min/avg/max statistics of the recorded wake cycles
+     *
+     * Up to WAKE_TRACE_STAGES_PER_UPLINK stages starting at the stage selected
+     * by selectStats() are encoded in units of WAKE_TRACE_RESOLUTION_MS.
+     *
+     * \param encoder LoRaWAN payload encoder object
+     */
+    void encodeStats(LoraEncoder &encoder);
+
+    /// Wake cycle record
+    struct sWakeTraceRec
+    {
+        uint32_t duration_ms[WAKE_TRACE_STAGES]; //!< duration of each stage in ms
+        uint16_t stages;                         //!< bitmap of executed stages
+    };
+
+private:
+    sWakeTraceRec current = {};                 //!< current wake cycle
+    uint32_t startMs[WAKE_TRACE_STAGES] = {};   //!< stage start timestamps
+    uint8_t firstStage = 0;                     //!< first stage to be reported
+    uint32_t totalBaseMs = 0;                   //!< awake time of suspended part of the wake cycle
+    bool suspended = false;                     //!< current wake cycle has been suspended
+
+    /*!
+     * \brief Convert duration to uplink resolution
+     *
+     * \param ms duration in ms
+     *
+     * \returns duration in units of WAKE_TRACE_RESOLUTION_MS, saturated to INV_UINT16 - 1
+     */
+    uint16_t toUplink(uint32_t ms)
+    {
+        uint32_t val = ms / WAKE_TRACE_RESOLUTION_MS;
+        return (val >= INV_UINT16) ? INV_UINT16 - 1 : val;
+    };
+};
+
+#endif // _WAKE_TRACE_H